@@ -9,3 +9,55 @@
 #else
     #error "Cannot determine endianness"
 #endif
+
+//Z80 opcode dispatch. When enabled, Z80Core::Execute() jumps through per-prefix tables
+//of label addresses (GCC/Clang "labels as values") instead of the nested switches.
+//Define RM_Z80_COMPUTED_GOTO=0 to build the plain switch, e.g. to benchmark the two.
+#ifndef RM_Z80_COMPUTED_GOTO
+    #if defined(__GNUC__) || defined(__clang__)
+        #define RM_Z80_COMPUTED_GOTO 1
+    #else
+        #define RM_Z80_COMPUTED_GOTO 0
+    #endif
+#endif
+
+//Tail dispatch, on top of RM_Z80_COMPUTED_GOTO: under RunUntil() every opcode handler
+//fetches the next opcode and jumps to its handler itself instead of going back to Step().
+//It makes the core half as big again without a consistent win in zx-bench, so it is off
+//unless RM_Z80_TAIL_DISPATCH=1.
+#if !defined(RM_Z80_TAIL_DISPATCH) || !RM_Z80_COMPUTED_GOTO
+    #undef RM_Z80_TAIL_DISPATCH
+    #define RM_Z80_TAIL_DISPATCH 0
+#endif
+
+//Lazy flag evaluation in the Z80 core: the 8-bit ALU helpers record their operands
+//and F is only computed when something reads it. Off by default.
+#ifndef RM_Z80_LAZY_FLAGS
+    #define RM_Z80_LAZY_FLAGS 0
+#endif
+
+//SIMD pixel expansion in the ULA renderer (see PixelKernel). SSE2/AVX2 on x86, NEON on ARM,
+//picked at runtime where the instruction set is optional. Define RM_PIXEL_SIMD=0 for scalar only.
+#ifndef RM_PIXEL_SIMD
+    #define RM_PIXEL_SIMD 1
+#endif
+
+//Debugger hooks (memory read/write/execute and port events) in zx_spectrum. With 0 the
+//accessors don't contain the calls at all; production builds that never attach a
+//debugger should define RM_DEBUG_HOOKS=0.
+#ifndef RM_DEBUG_HOOKS
+    #define RM_DEBUG_HOOKS 1
+#endif
+
+//Host time spent in rendering, audio and tape, plus an executed instruction count, collected
+//into zx_spectrum::subsystemTimes (see SubsystemTimer.h). Two clock reads per timed call, so
+//only the benchmark turns it on.
+#ifndef RM_SUBSYSTEM_TIMERS
+    #define RM_SUBSYSTEM_TIMERS 0
+#endif
+
+//Guest code profiler hooks in zx_spectrum (see GuestProfiler). When compiled in they cost
+//one test per opcode fetch and contended access until StartProfiler() is called.
+#ifndef RM_GUEST_PROFILER
+    #define RM_GUEST_PROFILER 1
+#endif
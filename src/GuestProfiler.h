@@ -0,0 +1,452 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rm {
+    // Profiler for the emulated program. The machine calls OnFetch() before every opcode fetch
+    // and AddStall() for every contended access; everything is kept in flat arrays indexed by
+    // the guest address, so the cost per instruction is a handful of increments.
+    //
+    // COUNT mode attributes every instruction's tstates (contention included) to its PC and to
+    // the memory bank the PC was in, counts opcodes (prefixed ones separately) and follows
+    // calls on a shadow stack for the call graph. SAMPLE mode only records the PC once every
+    // sample interval tstates.
+    class GuestProfiler
+    {
+    public:
+        enum class Mode {
+            COUNT,
+            SAMPLE
+        };
+
+        // Opcode tables in OpcodeCount(): prefix * 256 + opcode
+        enum Prefix {
+            PREFIX_NONE,
+            PREFIX_CB,
+            PREFIX_ED,
+            PREFIX_DD,
+            PREFIX_FD,
+            PREFIX_DDCB,
+            PREFIX_FDCB,
+            PREFIX_COUNT
+        };
+
+        static const int MAX_BANKS = 16;
+        static const int TOP_LEVEL = -1;        //function id of code not reached through a call
+
+        typedef char const* (*BankNameFunc)(int bank);
+
+        // Clears the counters and starts profiling
+        void Start(Mode newMode = Mode::COUNT, int newSampleInterval = 1000) {
+            mode = newMode;
+            sampleInterval = newSampleInterval > 0 ? newSampleInterval : 1;
+
+            instructionCount.assign(65536, 0);
+            pcTStates.assign(65536, 0);
+            pcStalls.assign(65536, 0);
+            addressStalls.assign(65536, 0);
+            samples.assign(65536, 0);
+            opcodeCount.assign(PREFIX_COUNT * 256, 0);
+            Clear();
+
+            running = true;
+        }
+
+        // Stops profiling. The instruction in flight is dropped.
+        void Stop() {
+            current = -1;
+            running = false;
+        }
+
+        bool IsRunning() const { return running; }
+
+        // Zeroes the counters, keeping the profiler running
+        void Clear() {
+            std::fill(instructionCount.begin(), instructionCount.end(), 0);
+            std::fill(pcTStates.begin(), pcTStates.end(), 0);
+            std::fill(pcStalls.begin(), pcStalls.end(), 0);
+            std::fill(addressStalls.begin(), addressStalls.end(), 0);
+            std::fill(samples.begin(), samples.end(), 0);
+            std::fill(opcodeCount.begin(), opcodeCount.end(), 0);
+
+            for (auto& b : bankTStates)
+                b = 0;
+
+            functions.clear();
+            edges.clear();
+            stack.clear();
+            topLevelSelf = 0;
+            totalTStates = 0;
+            pendingStall = 0;
+            nextSample = sampleInterval;
+            current = -1;
+        }
+
+        // Called before every opcode fetch (prefix bytes included) with the cpu clock. bank is
+        // the memory bank paged in at pc, pages the machine's 8k read pointers.
+        void OnFetch(ushort pc, ushort sp, int tstate, byte* const* pages, int bank) {
+            //A fetch right after a prefix byte belongs to the same instruction
+            if (prefix != PREFIX_NONE && pc == (ushort)(currentPC + prefixLength)) {
+                Continue(pc, pages);
+                return;
+            }
+
+            bool previous = current >= 0;
+            Retire(tstate);
+
+            if (mode == Mode::COUNT) {
+                if (previous && sp == (ushort)(lastSP - 2) && IsCallTarget(pc, sp, pages))
+                    EnterFunction(pc, sp);
+
+                //Anything that unwinds the stack past a frame (RET, RETI, LD SP) leaves it
+                while (!stack.empty() && sp > stack.back().sp)
+                    LeaveFunction();
+            }
+
+            byte op = Peek(pages, pc);
+
+            current = pc;
+            currentPC = pc;
+            currentBank = bank < MAX_BANKS ? bank : MAX_BANKS - 1;
+            lastSP = sp;
+            lastTState = tstate;
+            opcodeKey = op;
+            prefixLength = 1;
+
+            if (op == 0xcb)
+                prefix = PREFIX_CB;
+            else if (op == 0xed)
+                prefix = PREFIX_ED;
+            else if (op == 0xdd)
+                prefix = PREFIX_DD;
+            else if (op == 0xfd)
+                prefix = PREFIX_FD;
+            else
+                prefix = PREFIX_NONE;
+        }
+
+        // Contention delay of an access to addr, charged to the running instruction too
+        void AddStall(int addr, int stall) {
+            addressStalls[addr & 0xffff] += stall;
+            pendingStall += stall;
+        }
+
+        // The machine moved its clock back by delta tstates (end of frame)
+        void Rebase(int delta) {
+            lastTState -= delta;
+        }
+
+        uint64_t TotalTStates() const { return totalTStates; }
+        uint32_t InstructionCount(ushort pc) const { return instructionCount[pc]; }
+        uint64_t TStatesAt(ushort pc) const { return pcTStates[pc]; }
+        uint64_t StallsAt(ushort pc) const { return pcStalls[pc]; }
+        uint64_t StallsOnAddress(ushort addr) const { return addressStalls[addr]; }
+        uint32_t SamplesAt(ushort pc) const { return samples[pc]; }
+        uint64_t BankTStates(int bank) const { return bankTStates[bank]; }
+        uint64_t OpcodeCount(int prefixTable, byte op) const { return opcodeCount[prefixTable * 256 + op]; }
+
+        // tstates spent on instructions starting in [start, end]
+        uint64_t TStatesInRange(ushort start, ushort end) const {
+            uint64_t sum = 0;
+
+            for (int pc = start; pc <= end; pc++)
+                sum += (mode == Mode::SAMPLE) ? (uint64_t)samples[pc] * sampleInterval : pcTStates[pc];
+
+            return sum;
+        }
+
+        // Busiest addresses, busiest 256 byte ranges and the time per bank
+        std::string FlatReport(int top = 20, BankNameFunc bankName = nullptr) const {
+            std::string out;
+            char line[160];
+            bool sampled = mode == Mode::SAMPLE;
+            std::vector<uint64_t> weight(65536);
+
+            for (int pc = 0; pc < 65536; pc++)
+                weight[pc] = sampled ? (uint64_t)samples[pc] * sampleInterval : pcTStates[pc];
+
+            uint64_t total = 0;
+            for (uint64_t w : weight)
+                total += w;
+
+            snprintf(line, sizeof(line), "%s profile, %llu tstates\n", sampled ? "Sampled" : "Counted", (unsigned long long)total);
+            out += line;
+
+            out += "\n    addr    tstates      %     count    stalls\n";
+            for (int pc : TopIndices(weight, top)) {
+                snprintf(line, sizeof(line), "    %04x %10llu %6.2f %9u %9llu\n", pc,
+                    (unsigned long long)weight[pc], Percent(weight[pc], total),
+                    instructionCount[pc], (unsigned long long)pcStalls[pc]);
+                out += line;
+            }
+
+            std::vector<uint64_t> ranges(256, 0);
+            for (int pc = 0; pc < 65536; pc++)
+                ranges[pc >> 8] += weight[pc];
+
+            out += "\n    range        tstates      %\n";
+            for (int r : TopIndices(ranges, top)) {
+                snprintf(line, sizeof(line), "    %04x-%04x %10llu %6.2f\n", r << 8, (r << 8) | 0xff,
+                    (unsigned long long)ranges[r], Percent(ranges[r], total));
+                out += line;
+            }
+
+            if (!sampled) {
+                out += "\n    bank         tstates      %\n";
+                for (int b = 0; b < MAX_BANKS; b++) {
+                    if (!bankTStates[b])
+                        continue;
+
+                    if (bankName)
+                        snprintf(line, sizeof(line), "    %-8s %10llu %6.2f\n", bankName(b), (unsigned long long)bankTStates[b], Percent(bankTStates[b], totalTStates));
+                    else
+                        snprintf(line, sizeof(line), "    %-8d %10llu %6.2f\n", b, (unsigned long long)bankTStates[b], Percent(bankTStates[b], totalTStates));
+                    out += line;
+                }
+
+                out += "\n    stalled addr   stalls\n";
+                for (int addr : TopIndices(addressStalls, top)) {
+                    snprintf(line, sizeof(line), "    %04x      %9llu\n", addr, (unsigned long long)addressStalls[addr]);
+                    out += line;
+                }
+
+                static char const* const prefixNames[PREFIX_COUNT] = { "", "cb", "ed", "dd", "fd", "ddcb", "fdcb" };
+
+                out += "\n    opcode        count\n";
+                for (int key : TopIndices(opcodeCount, top)) {
+                    snprintf(line, sizeof(line), "    %-4s %02x %10llu\n", prefixNames[key >> 8], key & 0xff, (unsigned long long)opcodeCount[key]);
+                    out += line;
+                }
+            }
+
+            return out;
+        }
+
+        // Functions (call targets) by inclusive time, each followed by its callees
+        std::string CallGraphReport(int top = 20) const {
+            std::string out;
+            char line[160];
+
+            //Functions still on the stack count up to now
+            std::map<int, Function> totals = functions;
+            Function& topLevel = totals[(int)TOP_LEVEL];
+            topLevel.self += topLevelSelf;
+            topLevel.inclusive = totalTStates;
+
+            for (auto const& frame : stack) {
+                totals[frame.function].inclusive += totalTStates - frame.start;
+                totals[frame.function].self += frame.self;
+            }
+
+            std::vector<std::pair<uint64_t, int>> order;
+            for (auto const& f : totals)
+                order.push_back({ f.second.inclusive, f.first });
+
+            std::sort(order.begin(), order.end(), std::greater<std::pair<uint64_t, int>>());
+
+            out += "    function  calls   inclusive       self\n";
+
+            for (size_t i = 0; i < order.size() && (int)i < top; i++) {
+                int id = order[i].second;
+                Function const& f = totals.at(id);
+
+                snprintf(line, sizeof(line), "    %-8s %6llu %11llu %10llu\n", FunctionName(id).c_str(),
+                    (unsigned long long)f.calls, (unsigned long long)f.inclusive, (unsigned long long)f.self);
+                out += line;
+
+                for (auto const& e : edges) {
+                    if (e.first.first != id)
+                        continue;
+
+                    snprintf(line, sizeof(line), "      -> %-6s %6llu %11llu\n", FunctionName(e.first.second).c_str(),
+                        (unsigned long long)e.second.calls, (unsigned long long)e.second.tstates);
+                    out += line;
+                }
+            }
+
+            return out;
+        }
+
+    private:
+        struct Frame {
+            ushort sp;              //SP right after the return address was pushed
+            int function;
+            uint64_t start;         //totalTStates on entry
+            uint64_t self;          //tstates spent in the function itself so far
+        };
+
+        struct Function {
+            uint64_t calls = 0;
+            uint64_t inclusive = 0;
+            uint64_t self = 0;
+        };
+
+        struct Edge {
+            uint64_t calls = 0;
+            uint64_t tstates = 0;
+        };
+
+        static byte Peek(byte* const* pages, ushort addr) {
+            return pages[addr >> 13][addr & 0x1fff];
+        }
+
+        static double Percent(uint64_t part, uint64_t total) {
+            return total ? 100.0 * part / total : 0.0;
+        }
+
+        template<class T>
+        static std::vector<int> TopIndices(std::vector<T> const& values, int top) {
+            std::vector<int> indices;
+
+            for (int i = 0; i < (int)values.size(); i++) {
+                if (values[i])
+                    indices.push_back(i);
+            }
+
+            int n = std::min(top, (int)indices.size());
+            std::partial_sort(indices.begin(), indices.begin() + n, indices.end(),
+                [&](int a, int b) { return values[a] > values[b]; });
+            indices.resize(n);
+            return indices;
+        }
+
+        static std::string FunctionName(int id) {
+            if (id == TOP_LEVEL)
+                return "(top)";
+
+            char name[8];
+            snprintf(name, sizeof(name), "%04x", id);
+            return name;
+        }
+
+        //Charges the running instruction with the tstates up to now
+        void Retire(int tstate) {
+            if (current < 0)
+                return;
+
+            int elapsed = tstate - lastTState;
+            if (elapsed < 0)
+                elapsed = 0;
+
+            totalTStates += elapsed;
+
+            if (mode == Mode::SAMPLE) {
+                while (totalTStates >= nextSample) {
+                    samples[current]++;
+                    nextSample += sampleInterval;
+                }
+            } else {
+                instructionCount[current]++;
+                pcTStates[current] += elapsed;
+                pcStalls[current] += pendingStall;
+                bankTStates[currentBank] += elapsed;
+                opcodeCount[opcodeKey]++;
+
+                if (stack.empty())
+                    topLevelSelf += elapsed;
+                else
+                    stack.back().self += elapsed;
+            }
+
+            pendingStall = 0;
+            prefix = PREFIX_NONE;
+            current = -1;
+        }
+
+        void Continue(ushort pc, byte* const* pages) {
+            byte op = Peek(pages, pc);
+
+            if (prefix == PREFIX_CB || prefix == PREFIX_ED) {
+                opcodeKey = prefix * 256 + op;
+                prefix = PREFIX_NONE;
+            } else if (op == 0xcb) {
+                //DD CB d op: the opcode comes after the displacement and isn't an M1 fetch
+                opcodeKey = (prefix == PREFIX_DD ? PREFIX_DDCB : PREFIX_FDCB) * 256 + Peek(pages, (ushort)(pc + 2));
+                prefix = PREFIX_NONE;
+            } else if (op == 0xdd || op == 0xfd || op == 0xed) {
+                //Chained prefix: the last one decides
+                prefix = op == 0xdd ? PREFIX_DD : (op == 0xfd ? PREFIX_FD : PREFIX_ED);
+                opcodeKey = op;
+                prefixLength++;
+            } else {
+                opcodeKey = prefix * 256 + op;
+                prefix = PREFIX_NONE;
+            }
+        }
+
+        //A push of exactly one word that jumped somewhere other than the pushed address and
+        //the next byte or two (PUSH rr, PUSH IX) is a CALL, RST or interrupt.
+        bool IsCallTarget(ushort pc, ushort sp, byte* const* pages) const {
+            ushort pushed = (ushort)(Peek(pages, sp) | (Peek(pages, (ushort)(sp + 1)) << 8));
+
+            return pushed != pc && pc != (ushort)(currentPC + 1) && pc != (ushort)(currentPC + 2);
+        }
+
+        void EnterFunction(ushort pc, ushort sp) {
+            int caller = stack.empty() ? TOP_LEVEL : stack.back().function;
+
+            functions[pc].calls++;
+            edges[{ caller, pc }].calls++;
+            stack.push_back({ sp, pc, totalTStates, 0 });
+
+            //Runaway code that never returns mustn't grow the stack without limit
+            if (stack.size() > MAX_DEPTH) {
+                functions[stack.front().function].self += stack.front().self;
+                stack.erase(stack.begin());
+            }
+        }
+
+        void LeaveFunction() {
+            Frame frame = stack.back();
+            stack.pop_back();
+
+            int caller = stack.empty() ? TOP_LEVEL : stack.back().function;
+            uint64_t spent = totalTStates - frame.start;
+
+            functions[frame.function].inclusive += spent;
+            functions[frame.function].self += frame.self;
+            edges[{ caller, frame.function }].tstates += spent;
+        }
+
+        static const size_t MAX_DEPTH = 256;
+
+        bool running = false;
+        Mode mode = Mode::COUNT;
+        int sampleInterval = 1000;
+        uint64_t nextSample = 1000;
+
+        //The instruction being executed
+        int current = -1;
+        ushort currentPC = 0;
+        int currentBank = 0;
+        int opcodeKey = 0;
+        Prefix prefix = PREFIX_NONE;
+        int prefixLength = 1;
+        ushort lastSP = 0;
+        int lastTState = 0;
+        int pendingStall = 0;
+
+        uint64_t totalTStates = 0;
+        std::vector<uint32_t> instructionCount;
+        std::vector<uint64_t> pcTStates;
+        std::vector<uint64_t> pcStalls;
+        std::vector<uint64_t> addressStalls;
+        std::vector<uint32_t> samples;
+        std::vector<uint64_t> opcodeCount;
+        uint64_t bankTStates[MAX_BANKS] = { 0 };
+
+        std::vector<Frame> stack;
+        uint64_t topLevelSelf = 0;
+        std::map<int, Function> functions;
+        std::map<std::pair<int, int>, Edge> edges;
+    };
+}
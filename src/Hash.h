@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace rm {
+    // 64 bit FNV-1a. Not cryptographic, only meant for telling machine states and frames apart.
+    class Hash
+    {
+    public:
+        static const uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+        static const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        // Hashes size bytes at data, continuing from a previous result if given
+        static uint64_t Fnv1a(void const* data, size_t size, uint64_t hash = FNV_OFFSET) {
+            byte const* p = (byte const*)data;
+
+            for (size_t i = 0; i < size; i++) {
+                hash ^= p[i];
+                hash *= FNV_PRIME;
+            }
+
+            return hash;
+        }
+
+        // Like Fnv1a() but folds in 8 bytes per step, for hashing whole memory pages every
+        // frame. size must be a multiple of 8.
+        static uint64_t Words(void const* data, size_t size, uint64_t hash = FNV_OFFSET) {
+            byte const* p = (byte const*)data;
+
+            for (size_t i = 0; i < size; i += 8) {
+                uint64_t word;
+                memcpy(&word, p + i, 8);
+                hash ^= word;
+                hash *= FNV_PRIME;
+                hash ^= hash >> 32;
+            }
+
+            return hash;
+        }
+    };
+}
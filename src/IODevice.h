@@ -9,5 +9,5 @@ namespace rm {
         virtual bool Responded() = 0;
         virtual byte In(ushort port) = 0;
         virtual void Out(ushort port, byte val) = 0;
-    }
+    };
 }
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Hash.h"
+#include "Random.h"
+#include "SNAFile.h"
+#include "Types.h"
+#include "zx_spectrum.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rm {
+    //A key change applied at the start of a frame of a RunJob
+    struct InputEvent {
+        int frame;
+        zx_spectrum::keyCode key;
+        bool pressed;
+    };
+
+    //What a RunJob collects (any combination)
+    enum RunOutput {
+        OUTPUT_FRAME_HASHES = 1,        //a hash of ScreenBuffer after every frame
+        OUTPUT_SNAPSHOT = 2,            //the machine state after the last frame
+        OUTPUT_SCREENSHOT = 4,          //ScreenBuffer after the last frame
+        OUTPUT_STATE_HASHES = 8         //zx_spectrum::StateHash() after every frame
+    };
+
+    //One machine to run. The machine is owned by the caller and must not be shared with
+    //another job or touched by the caller until MachineRunner::Run() returns. Turbo and
+    //deterministic mode are put back as they were once the job ends, even if it throws.
+    //Everything else the job changes stays.
+    struct RunJob {
+        zx_spectrum* machine = nullptr;
+        std::shared_ptr<SNA_SNAPSHOT const> snapshot;       //loaded with UseSNA() first, if set
+        std::function<bool(zx_spectrum&)> setup;            //any other preparation, false to fail the job
+        bool reset = true;                                  //hard reset before the snapshot and setup
+        std::vector<InputEvent> script;
+        int frames = 0;
+        int outputs = OUTPUT_FRAME_HASHES;
+        bool deterministic = true;                          //run with SetDeterministic(true, seed)
+        uint64_t seed = Random::DEFAULT_SEED;
+    };
+
+    struct RunResult {
+        bool ok = false;
+        std::string error;
+        int frames = 0;                                     //frames actually run
+        std::vector<uint64_t> frameHashes;
+        std::vector<uint64_t> stateHashes;
+        std::shared_ptr<SNA_SNAPSHOT> snapshot;
+        std::vector<int> screenshot;
+    };
+
+    // Runs many independent machines across a pool of worker threads. Jobs are dealt out to
+    // per-worker queues up front; a worker takes from the back of its own queue and, once that
+    // is empty, steals from the front of the others, so long and short jobs even out without
+    // a shared queue everyone contends on.
+    //
+    // Each machine is only ever touched by one worker, and machines share no mutable state
+    // (see zx_spectrum), so the workers never lock anything but the job queues.
+    class MachineRunner
+    {
+    public:
+        // threads <= 0 uses one worker per hardware thread
+        explicit MachineRunner(int threads = 0) {
+            workerCount = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+            if (workerCount <= 0)
+                workerCount = 1;
+        }
+
+        int WorkerCount() const { return workerCount; }
+
+        // Runs every job and returns their results in the same order
+        std::vector<RunResult> Run(std::vector<RunJob> const& jobs) {
+            std::vector<RunResult> results(jobs.size());
+            int workers = std::min(workerCount, std::max((int)jobs.size(), 1));
+
+            queues.clear();
+            for (int w = 0; w < workers; w++)
+                queues.emplace_back(new WorkQueue());
+
+            for (size_t j = 0; j < jobs.size(); j++)
+                queues[j % workers]->jobs.push_back(j);
+
+            std::vector<std::thread> threads;
+            for (int w = 1; w < workers; w++)
+                threads.emplace_back([&, w]() { Work(w, jobs, results); });
+
+            //The calling thread is worker 0
+            Work(0, jobs, results);
+
+            for (auto& t : threads)
+                t.join();
+
+            queues.clear();
+            return results;
+        }
+
+        // Runs a single job on the calling thread
+        static void RunOne(RunJob const& job, RunResult& result) {
+            zx_spectrum& machine = *job.machine;
+            ModeGuard modes(machine);
+            machine.SetDeterministic(job.deterministic, job.seed);
+
+            //After SetDeterministic(), so the reset draws from the job's seed
+            if (job.reset)
+                machine.Reset(true);
+
+            if (job.snapshot)
+                machine.UseSNA(job.snapshot.get());
+
+            if (job.setup && !job.setup(machine)) {
+                result.error = "setup failed";
+                return;
+            }
+
+            std::vector<InputEvent> script = job.script;
+            std::stable_sort(script.begin(), script.end(),
+                [](InputEvent const& a, InputEvent const& b) { return a.frame < b.frame; });
+
+            machine.SetTurbo(true);
+
+            size_t next = 0;
+
+            for (int frame = 0; frame < job.frames; frame++) {
+                for (; next < script.size() && script[next].frame <= frame; next++)
+                    machine.keyBuffer[(int)script[next].key] = script[next].pressed;
+
+                if (!machine.RunFrame())
+                    break;
+
+                result.frames++;
+
+                if (job.outputs & OUTPUT_FRAME_HASHES)
+                    result.frameHashes.push_back(HashScreen(machine));
+
+                if (job.outputs & OUTPUT_STATE_HASHES)
+                    result.stateHashes.push_back(job.deterministic ? machine.frameStateHash : machine.StateHash());
+            }
+
+            if (job.outputs & OUTPUT_SCREENSHOT)
+                result.screenshot = machine.ScreenBuffer;
+
+            if (job.outputs & OUTPUT_SNAPSHOT) {
+                result.snapshot.reset(new SNA_SNAPSHOT());
+                machine.SaveSNA(result.snapshot.get());
+            }
+
+            result.ok = result.frames == job.frames;
+            if (!result.ok)
+                result.error = "stopped early";
+        }
+
+        static uint64_t HashScreen(zx_spectrum const& machine) {
+            return Hash::Fnv1a(machine.ScreenBuffer.data(), machine.ScreenBuffer.size() * sizeof(int));
+        }
+
+    private:
+        //Puts back the modes RunOne() changes on a caller owned machine, however the job ends.
+        //Deterministic mode is restored as is, without restarting the random numbers.
+        struct ModeGuard {
+            zx_spectrum& machine;
+            bool turbo;
+            bool deterministic;
+            uint64_t seed;
+
+            explicit ModeGuard(zx_spectrum& m)
+                : machine(m), turbo(m.turbo), deterministic(m.deterministic), seed(m.deterministicSeed) {
+            }
+
+            ~ModeGuard() {
+                machine.SetTurbo(turbo);
+                machine.deterministic = deterministic;
+                machine.deterministicSeed = seed;
+            }
+
+            ModeGuard(ModeGuard const&) = delete;
+            ModeGuard& operator=(ModeGuard const&) = delete;
+        };
+
+        struct WorkQueue {
+            std::mutex lock;
+            std::deque<size_t> jobs;
+        };
+
+        void Work(int worker, std::vector<RunJob> const& jobs, std::vector<RunResult>& results) {
+            size_t job;
+
+            while (Pop(worker, job) || Steal(worker, job)) {
+                try {
+                    RunOne(jobs[job], results[job]);
+                }
+                catch (std::exception const& e) {
+                    results[job].ok = false;
+                    results[job].error = e.what();
+                }
+            }
+        }
+
+        bool Pop(int worker, size_t& job) {
+            WorkQueue& q = *queues[worker];
+            std::lock_guard<std::mutex> guard(q.lock);
+
+            if (q.jobs.empty())
+                return false;
+
+            job = q.jobs.back();
+            q.jobs.pop_back();
+            return true;
+        }
+
+        //No jobs are added once Run() has started, so a worker that finds every queue
+        //empty is done.
+        bool Steal(int worker, size_t& job) {
+            int count = (int)queues.size();
+
+            for (int i = 1; i < count; i++) {
+                WorkQueue& q = *queues[(worker + i) % count];
+                std::lock_guard<std::mutex> guard(q.lock);
+
+                if (!q.jobs.empty()) {
+                    job = q.jobs.front();
+                    q.jobs.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        int workerCount;
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+    };
+}
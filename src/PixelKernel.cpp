@@ -0,0 +1,246 @@
+#include "PixelKernel.h"
+
+#include <string.h>
+
+#if RM_PIXEL_SIMD && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)) && (defined(__SSE2__) || defined(_M_X64))
+    #define RM_PIXEL_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if RM_PIXEL_SIMD && RM_PIXEL_SSE2 && (defined(__GNUC__) || defined(__clang__))
+    #define RM_PIXEL_AVX2 1
+    #include <immintrin.h>
+#endif
+
+#if RM_PIXEL_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define RM_PIXEL_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace {
+    //Scalar
+
+    void ExpandScalar(int* out, byte pixels, int ink, int paper) {
+        int blend = ink ^ paper;
+
+        for (int a = 0; a < 8; ++a)
+            out[a] = paper ^ (blend & -((pixels >> (7 - a)) & 1));
+    }
+
+    void FillScalar(int* out, int count, int colour) {
+        for (int f = 0; f < count; f++)
+            out[f] = colour;
+    }
+
+#if RM_PIXEL_SSE2
+    //SSE2, baseline on x86-64
+
+    void ExpandSSE2(int* out, byte pixels, int ink, int paper) {
+        __m128i const bitsHi = _mm_set_epi32(0x10, 0x20, 0x40, 0x80);
+        __m128i const bitsLo = _mm_set_epi32(0x01, 0x02, 0x04, 0x08);
+
+        __m128i p = _mm_set1_epi32(pixels);
+        __m128i vpaper = _mm_set1_epi32(paper);
+        __m128i blend = _mm_xor_si128(_mm_set1_epi32(ink), vpaper);
+
+        __m128i maskHi = _mm_cmpeq_epi32(_mm_and_si128(p, bitsHi), bitsHi);
+        __m128i maskLo = _mm_cmpeq_epi32(_mm_and_si128(p, bitsLo), bitsLo);
+
+        _mm_storeu_si128((__m128i*)out, _mm_xor_si128(vpaper, _mm_and_si128(blend, maskHi)));
+        _mm_storeu_si128((__m128i*)(out + 4), _mm_xor_si128(vpaper, _mm_and_si128(blend, maskLo)));
+    }
+
+    void FillSSE2(int* out, int count, int colour) {
+        __m128i c = _mm_set1_epi32(colour);
+        int f = 0;
+
+        for (; f + 4 <= count; f += 4)
+            _mm_storeu_si128((__m128i*)(out + f), c);
+
+        for (; f < count; f++)
+            out[f] = colour;
+    }
+#endif
+
+#if RM_PIXEL_AVX2
+    //AVX2, selected at runtime
+
+    __attribute__((target("avx2")))
+    void ExpandAVX2(int* out, byte pixels, int ink, int paper) {
+        __m256i const bits = _mm256_set_epi32(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+
+        __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(pixels), bits), bits);
+        __m256i result = _mm256_blendv_epi8(_mm256_set1_epi32(paper), _mm256_set1_epi32(ink), mask);
+
+        _mm256_storeu_si256((__m256i*)out, result);
+    }
+
+    __attribute__((target("avx2")))
+    void FillAVX2(int* out, int count, int colour) {
+        __m256i c = _mm256_set1_epi32(colour);
+        int f = 0;
+
+        for (; f + 8 <= count; f += 8)
+            _mm256_storeu_si256((__m256i*)(out + f), c);
+
+        for (; f < count; f++)
+            out[f] = colour;
+    }
+#endif
+
+#if RM_PIXEL_NEON
+    //NEON
+
+    void ExpandNEON(int* out, byte pixels, int ink, int paper) {
+        static uint32_t const hi[4] = { 0x80, 0x40, 0x20, 0x10 };
+        static uint32_t const lo[4] = { 0x08, 0x04, 0x02, 0x01 };
+
+        uint32x4_t p = vdupq_n_u32(pixels);
+        uint32x4_t vink = vdupq_n_u32((uint32_t)ink);
+        uint32x4_t vpaper = vdupq_n_u32((uint32_t)paper);
+
+        vst1q_u32((uint32_t*)out, vbslq_u32(vtstq_u32(p, vld1q_u32(hi)), vink, vpaper));
+        vst1q_u32((uint32_t*)(out + 4), vbslq_u32(vtstq_u32(p, vld1q_u32(lo)), vink, vpaper));
+    }
+
+    void FillNEON(int* out, int count, int colour) {
+        uint32x4_t c = vdupq_n_u32((uint32_t)colour);
+        int f = 0;
+
+        for (; f + 4 <= count; f += 4)
+            vst1q_u32((uint32_t*)(out + f), c);
+
+        for (; f < count; f++)
+            out[f] = colour;
+    }
+#endif
+
+    //The renderer before the kernels: decode the attribute and test one bit at a time.
+    void ReferenceByte(int* out, int pixelData, int attrData, int const* palette) {
+        int bright = (attrData & 0x40) >> 3;
+        int ink = (attrData & 0x07);
+        int paper = ((attrData >> 3) & 0x7);
+        int paletteInk = palette[ink + bright];
+        int palettePaper = palette[paper + bright];
+
+        for (int a = 0; a < 8; ++a) {
+            if ((pixelData & 0x80) != 0)
+                out[a] = paletteInk;
+            else
+                out[a] = palettePaper;
+
+            pixelData <<= 1;
+        }
+    }
+
+    bool TestKernels(rm::PixelKernel::ExpandFunc expand, rm::PixelKernel::FillFunc fill) {
+        //Distinct colours with the alpha byte set, so sign bits get exercised too
+        int palette[16];
+        for (int f = 0; f < 16; f++)
+            palette[f] = (int)(0xff000000u | (uint)(f * 0x0b1d37 + 0x102030));
+
+        int expected[8];
+        int actual[8 + 1];
+
+        for (int attrData = 0; attrData < 256; attrData++) {
+            int bright = (attrData & 0x40) >> 3;
+            int ink = palette[(attrData & 0x07) + bright];
+            int paper = palette[((attrData >> 3) & 0x7) + bright];
+
+            for (int pixelData = 0; pixelData < 256; pixelData++) {
+                ReferenceByte(expected, pixelData, attrData, palette);
+
+                actual[8] = 0x5a5a5a5a;
+                expand(actual, (byte)pixelData, ink, paper);
+
+                if (memcmp(expected, actual, sizeof(expected)) != 0 || actual[8] != 0x5a5a5a5a)
+                    return false;
+            }
+        }
+
+        //Every run length a scanline can produce, written at an odd offset
+        int buffer[2 + 352 + 1];
+        for (int count = 0; count <= 352; count++) {
+            for (int f = 0; f < 2 + 352 + 1; f++)
+                buffer[f] = 0x5a5a5a5a;
+
+            fill(buffer + 1, count, palette[7]);
+
+            if (buffer[0] != 0x5a5a5a5a || buffer[1 + count] != 0x5a5a5a5a)
+                return false;
+
+            for (int f = 0; f < count; f++) {
+                if (buffer[1 + f] != palette[7])
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+rm::PixelKernel::ExpandFunc rm::PixelKernel::Expand = ExpandScalar;
+rm::PixelKernel::FillFunc rm::PixelKernel::Fill = FillScalar;
+char const* rm::PixelKernel::name = "scalar";
+
+void rm::PixelKernel::Init() {
+    //Machines may be constructed on several threads; the selection is only made once
+    static bool const selected = Select();
+    (void)selected;
+}
+
+bool rm::PixelKernel::Select() {
+    Expand = ExpandScalar;
+    Fill = FillScalar;
+    name = "scalar";
+
+#if RM_PIXEL_SSE2
+    Expand = ExpandSSE2;
+    Fill = FillSSE2;
+    name = "sse2";
+#endif
+
+#if RM_PIXEL_AVX2
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        Expand = ExpandAVX2;
+        Fill = FillAVX2;
+        name = "avx2";
+    }
+#endif
+
+#if RM_PIXEL_NEON
+    Expand = ExpandNEON;
+    Fill = FillNEON;
+    name = "neon";
+#endif
+
+    return true;
+}
+
+char const* rm::PixelKernel::Name() {
+    return name;
+}
+
+bool rm::PixelKernel::SelfTest() {
+    if (!TestKernels(ExpandScalar, FillScalar))
+        return false;
+
+#if RM_PIXEL_SSE2
+    if (!TestKernels(ExpandSSE2, FillSSE2))
+        return false;
+#endif
+
+#if RM_PIXEL_AVX2
+    if (__builtin_cpu_supports("avx2") && !TestKernels(ExpandAVX2, FillAVX2))
+        return false;
+#endif
+
+#if RM_PIXEL_NEON
+    if (!TestKernels(ExpandNEON, FillNEON))
+        return false;
+#endif
+
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Types.h"
+
+namespace rm {
+    // Pixel expansion kernels used by the ULA renderer. Expand() turns a bitmap byte into
+    // 8 pixels (ink where a bit is set, paper otherwise, msb first) and Fill() writes a run
+    // of a single colour. Both are function pointers picked once at startup by Init(), so
+    // the renderer gets the widest implementation the host cpu supports.
+    class PixelKernel
+    {
+    public:
+        typedef void (*ExpandFunc)(int* out, byte pixels, int ink, int paper);
+        typedef void (*FillFunc)(int* out, int count, int colour);
+
+        static ExpandFunc Expand;
+        static FillFunc Fill;
+
+        // Selects the kernels for the host cpu. Safe to call more than once, from any thread.
+        static void Init();
+
+        // Name of the selected kernel set ("scalar", "sse2", "avx2" or "neon").
+        static char const* Name();
+
+        // Checks every available kernel set against the per-pixel reference renderer over all
+        // 256x256 bitmap/attribute combinations, and Fill() over a range of run lengths.
+        // Returns false on the first mismatch.
+        static bool SelfTest();
+
+    private:
+        static bool Select();
+
+        static char const* name;
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stdint.h>
+
+namespace rm {
+    // Small per-instance PRNG (xorshift64*). Each machine owns one, so machines never share
+    // random state and a run is reproducible from its seed.
+    class Random
+    {
+    public:
+        static const uint64_t DEFAULT_SEED = 0x2545f4914f6cdd1dull;
+
+        explicit Random(uint64_t seed = DEFAULT_SEED) {
+            Seed(seed);
+        }
+
+        void Seed(uint64_t seed) {
+            //xorshift gets stuck on 0
+            state = seed ? seed : DEFAULT_SEED;
+        }
+
+        // The generator state, for savestates. Seed(State()) picks up where it left off.
+        uint64_t State() const { return state; }
+
+        uint32_t NextUInt() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return (uint32_t)((state * 0x2545f4914f6cdd1dull) >> 32);
+        }
+
+        // Uniform in [0, max). max must be > 0.
+        int Next(int max) {
+            //Reject the top of the range that doesn't divide evenly, so there's no bias
+            uint32_t range = (uint32_t)max;
+            uint32_t limit = UINT32_MAX - (UINT32_MAX % range);
+            uint32_t r;
+
+            do {
+                r = NextUInt();
+            } while (r >= limit);
+
+            return (int)(r % range);
+        }
+
+        // Uniform in [min, max). max must be > min.
+        int Next(int min, int max) {
+            return min + Next(max - min);
+        }
+
+    private:
+        uint64_t state;
+    };
+}
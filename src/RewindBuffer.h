@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+namespace rm {
+    // Ring buffer of in-memory savestates for rewind. Each entry holds a State (the machine's
+    // registers and other small state) and one reference per 8k RAM page into a shared pool.
+    // Pages that weren't written since the previous Push() share that entry's copy, so a frame
+    // that only touched a couple of pages costs a couple of 8k copies instead of the whole of RAM.
+    //
+    // Memory is bounded by the pool: when Push() runs out of pool pages it drops the oldest
+    // entries until the new one fits. Nothing is allocated outside Resize().
+    template<class State>
+    class RewindBuffer
+    {
+    public:
+        static const int PAGES = 16;
+        static const int PAGE_SIZE = 8192;
+
+        RewindBuffer() {}
+
+        RewindBuffer(int capacity, int poolPages) {
+            Resize(capacity, poolPages);
+        }
+
+        // Drops every entry and makes room for capacity entries sharing poolPages 8k copies
+        // (at least PAGES). A capacity of 0 frees everything and turns Push() into a no-op.
+        void Resize(int capacity, int poolPages) {
+            head = 0;
+            count = 0;
+
+            if (capacity <= 0) {
+                std::vector<Entry>().swap(entries);
+                std::vector<byte>().swap(pool);
+                std::vector<int>().swap(refs);
+                std::vector<int>().swap(freePages);
+                return;
+            }
+
+            if (poolPages < PAGES)
+                poolPages = PAGES;
+
+            entries.assign(capacity, Entry());
+            pool.assign((size_t)poolPages * PAGE_SIZE, 0);
+            refs.assign(poolPages, 0);
+            freePages.clear();
+
+            for (int p = poolPages - 1; p >= 0; p--)
+                freePages.push_back(p);
+        }
+
+        void Clear() {
+            while (count > 0)
+                DropOldest();
+        }
+
+        int Count() const { return count; }
+        int Capacity() const { return (int)entries.size(); }
+
+        // Pool pages in use, i.e. distinct page copies held across all entries
+        int PagesUsed() const { return (int)refs.size() - (int)freePages.size(); }
+
+        // Stores a new entry. dirty has a bit per RAM page written since the last Push() or
+        // Rewind(); pages without it are shared with the newest entry. The caller clears its
+        // dirty bits afterwards.
+        void Push(State const& state, byte const (*ram)[PAGE_SIZE], uint16_t dirty) {
+            if (entries.empty())
+                return;
+
+            if (count == 0)
+                dirty = 0xffff;
+
+            if (count == (int)entries.size())
+                DropOldest();
+
+            //Make room before taking any references, dropping the oldest entries. If the
+            //newest one has to go too, every page needs a fresh copy.
+            while (count > 0 && (int)freePages.size() < Popcount(dirty))
+                DropOldest();
+
+            if (count == 0)
+                dirty = 0xffff;
+
+            Entry const* previous = count > 0 ? &Newest() : nullptr;
+            Entry& entry = entries[(head + count) % entries.size()];
+
+            for (int p = 0; p < PAGES; p++) {
+                if (dirty & (1 << p)) {
+                    int page = freePages.back();
+                    freePages.pop_back();
+                    memcpy(&pool[(size_t)page * PAGE_SIZE], ram[p], PAGE_SIZE);
+                    entry.pages[p] = page;
+                    refs[page] = 1;
+                }
+                else {
+                    entry.pages[p] = previous->pages[p];
+                    refs[entry.pages[p]]++;
+                }
+            }
+
+            entry.state = state;
+            count++;
+        }
+
+        // Restores the entry back steps before the newest (0 = the newest) and drops every
+        // entry after it, so it becomes the newest. Only pages that differ from the live RAM
+        // are copied: those written since the last Push() (dirty) and those whose copy in the
+        // restored entry isn't shared with the newest one. Returns false if there is no such entry.
+        bool Rewind(int back, State& state, byte (*ram)[PAGE_SIZE], uint16_t dirty) {
+            if (back < 0 || back >= count)
+                return false;
+
+            Entry const& target = entries[(head + count - 1 - back) % entries.size()];
+            Entry const& newest = Newest();
+
+            for (int p = 0; p < PAGES; p++) {
+                if ((dirty & (1 << p)) || target.pages[p] != newest.pages[p])
+                    memcpy(ram[p], &pool[(size_t)target.pages[p] * PAGE_SIZE], PAGE_SIZE);
+            }
+
+            state = target.state;
+
+            for (int b = 0; b < back; b++)
+                DropNewest();
+
+            return true;
+        }
+
+    private:
+        struct Entry {
+            State state;
+            int pages[PAGES];
+        };
+
+        Entry& Newest() { return entries[(head + count - 1) % entries.size()]; }
+
+        void Release(Entry const& entry) {
+            for (int p = 0; p < PAGES; p++) {
+                if (--refs[entry.pages[p]] == 0)
+                    freePages.push_back(entry.pages[p]);
+            }
+        }
+
+        void DropOldest() {
+            Release(entries[head]);
+            head = (head + 1) % (int)entries.size();
+            count--;
+        }
+
+        void DropNewest() {
+            Release(Newest());
+            count--;
+        }
+
+        static int Popcount(uint16_t bits) {
+            int n = 0;
+
+            for (; bits; bits &= bits - 1)
+                n++;
+
+            return n;
+        }
+
+        std::vector<Entry> entries;         //ring of Capacity() entries, oldest at head
+        std::vector<byte> pool;             //the 8k page copies
+        std::vector<int> refs;              //entries referencing each pool page
+        std::vector<int> freePages;
+        int head = 0;
+        int count = 0;
+    };
+}
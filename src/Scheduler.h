@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Types.h"
+
+#include <limits.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace rm {
+    // Min-heap of timed events keyed on absolute tstates. Each event kind is registered once
+    // and gets a slot id; scheduling a slot again replaces its previous deadline. The machine
+    // loop only has to compare the current tstate against NextDeadline() and call RunDue()
+    // when it has been reached.
+    class Scheduler
+    {
+    public:
+        typedef std::function<void(int)> Handler;
+
+        // Registers a handler and returns its slot id. The handler receives the tstate the
+        // event was dispatched at and may schedule itself (or any other slot) again.
+        int Register(Handler handler) {
+            slots.push_back({ handler, 0, false, 0 });
+            return (int)slots.size() - 1;
+        }
+
+        // Sets the deadline of a slot, replacing any pending one. Deadlines in the past fire
+        // on the next RunDue().
+        void Schedule(int slot, int tstate) {
+            Slot& s = slots[slot];
+            s.generation++;
+            s.pending = true;
+            s.deadline = tstate;
+            heap.push_back({ tstate, slot, s.generation });
+            std::push_heap(heap.begin(), heap.end(), Later);
+            DropStale();
+        }
+
+        void Cancel(int slot) {
+            slots[slot].generation++;
+            slots[slot].pending = false;
+            DropStale();
+        }
+
+        void Clear() {
+            heap.clear();
+            for (auto& s : slots) {
+                s.generation++;
+                s.pending = false;
+            }
+            nextDeadline = INT_MAX;
+        }
+
+        bool IsPending(int slot) const { return slots[slot].pending; }
+
+        // The earliest pending deadline, or INT_MAX when nothing is scheduled.
+        int NextDeadline() const { return nextDeadline; }
+
+        // The earliest pending deadline of any slot but ignore, or INT_MAX. Walks the slots,
+        // which are few, so it's meant for once per batch rather than once per instruction.
+        int NextDeadlineIgnoring(int ignore) const {
+            int deadline = INT_MAX;
+
+            for (size_t i = 0; i < slots.size(); i++) {
+                if ((int)i != ignore && slots[i].pending)
+                    deadline = std::min(deadline, slots[i].deadline);
+            }
+
+            return deadline;
+        }
+
+        // Fires every event whose deadline is <= tstate, earliest first (ties go to the slot
+        // registered first). Events scheduled by the handlers themselves wait for the next call,
+        // even if their deadline has already passed.
+        void RunDue(int tstate) {
+            due.clear();
+            while (!heap.empty() && heap.front().tstate <= tstate) {
+                std::pop_heap(heap.begin(), heap.end(), Later);
+                Entry e = heap.back();
+                heap.pop_back();
+                if (e.generation != slots[e.slot].generation)
+                    continue;
+
+                slots[e.slot].pending = false;
+                due.push_back(e);
+            }
+            DropStale();
+
+            for (size_t i = 0; i < due.size(); i++) {
+                //An earlier handler may have rescheduled or cancelled this one.
+                if (slots[due[i].slot].pending || due[i].generation != slots[due[i].slot].generation)
+                    continue;
+
+                slots[due[i].slot].handler(tstate);
+            }
+        }
+
+        // Moves every pending deadline back by delta tstates. Used at the end of a frame,
+        // when the machine rewinds cpu.t_states.
+        void Rebase(int delta) {
+            for (auto& e : heap)
+                e.tstate -= delta;
+
+            for (auto& s : slots)
+                s.deadline -= delta;
+
+            if (!heap.empty())
+                nextDeadline = heap.front().tstate;
+        }
+
+    private:
+        struct Slot {
+            Handler handler;
+            uint generation;
+            bool pending;
+            int deadline;       //valid while pending
+        };
+
+        struct Entry {
+            int tstate;
+            int slot;
+            uint generation;
+        };
+
+        // Heap comparator: the entry that fires later sorts lower.
+        static bool Later(Entry const& a, Entry const& b) {
+            if (a.tstate != b.tstate)
+                return a.tstate > b.tstate;
+
+            return a.slot > b.slot;
+        }
+
+        // Pops cancelled or replaced entries off the top so nextDeadline stays exact.
+        void DropStale() {
+            while (!heap.empty() && heap.front().generation != slots[heap.front().slot].generation) {
+                std::pop_heap(heap.begin(), heap.end(), Later);
+                heap.pop_back();
+            }
+
+            nextDeadline = heap.empty() ? INT_MAX : heap.front().tstate;
+        }
+
+        std::vector<Slot> slots;
+        std::vector<Entry> heap;
+        std::vector<Entry> due;
+        int nextDeadline = INT_MAX;
+    };
+}
@@ -14,5 +14,6 @@ namespace rm {
         void Stop() {}
         void Shutdown() {}
         bool FinishedPlaying() { return true; }
+        void SubmitBuffer(short const*, int) {}
     };
 }
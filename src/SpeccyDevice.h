@@ -13,5 +13,5 @@ namespace rm {
         virtual void UnregisterDevice(zx_spectrum* speccyModel) = 0;
         virtual void Reset() = 0;
         virtual SPECCY_DEVICE DeviceID() = 0;
-    }
+    };
 }
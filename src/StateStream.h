@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace rm {
+    // Fixed layout, little endian streams for zx_spectrum::Serialize/Unserialize. Both have the
+    // same Sync() overloads, so one SyncState() function describes the layout for saving and
+    // loading alike. Each C++ type always takes the same number of bytes regardless of the
+    // host. Running past the end of the buffer sets a flag instead of touching memory, and a
+    // writer without a buffer only counts bytes, which is how the state size is worked out.
+    class StateWriter
+    {
+    public:
+        static const bool LOADING = false;
+
+        StateWriter(void* data, size_t size) : out((byte*)data), size(size) {}
+
+        void Sync(byte& v)      { Put(v, 1); }
+        void Sync(bool& v)      { Put(v ? 1 : 0, 1); }
+        void Sync(ushort& v)    { Put(v, 2); }
+        void Sync(short& v)     { Put((ushort)v, 2); }
+        void Sync(int& v)       { Put((uint)v, 4); }
+        void Sync(uint& v)      { Put(v, 4); }
+        void Sync(uint64_t& v)  { Put(v, 8); }
+
+        void SyncBytes(void* data, size_t count) {
+            if (Reserve(count))
+                memcpy(out + used - count, data, count);
+        }
+
+        bool Ok() const { return !overflow; }
+        size_t Used() const { return used; }
+
+    private:
+        void Put(uint64_t v, int bytes) {
+            if (!Reserve(bytes))
+                return;
+
+            for (int b = 0; b < bytes; b++)
+                out[used - bytes + b] = (byte)(v >> (b * 8));
+        }
+
+        //Advances past count bytes, false if there is nowhere to put them
+        bool Reserve(size_t count) {
+            used += count;
+
+            if (!out)
+                return false;
+
+            if (used > size)
+                overflow = true;
+
+            return !overflow;
+        }
+
+        byte* out;
+        size_t size;
+        size_t used = 0;
+        bool overflow = false;
+    };
+
+    class StateReader
+    {
+    public:
+        static const bool LOADING = true;
+
+        StateReader(void const* data, size_t size) : in((byte const*)data), size(size) {}
+
+        void Sync(byte& v)      { v = (byte)Get(1); }
+        void Sync(bool& v)      { v = Get(1) != 0; }
+        void Sync(ushort& v)    { v = (ushort)Get(2); }
+        void Sync(short& v)     { v = (short)Get(2); }
+        void Sync(int& v)       { v = (int)Get(4); }
+        void Sync(uint& v)      { v = (uint)Get(4); }
+        void Sync(uint64_t& v)  { v = Get(8); }
+
+        void SyncBytes(void* data, size_t count) {
+            if (Take(count))
+                memcpy(data, in + used - count, count);
+        }
+
+        bool Ok() const { return !overflow; }
+        size_t Used() const { return used; }
+
+    private:
+        uint64_t Get(int bytes) {
+            uint64_t v = 0;
+
+            if (Take(bytes)) {
+                for (int b = 0; b < bytes; b++)
+                    v |= (uint64_t)in[used - bytes + b] << (b * 8);
+            }
+
+            return v;
+        }
+
+        bool Take(size_t count) {
+            if (overflow || used + count > size) {
+                overflow = true;
+                return false;
+            }
+
+            used += count;
+            return true;
+        }
+
+        byte const* in;
+        size_t size;
+        size_t used = 0;
+        bool overflow = false;
+    };
+}
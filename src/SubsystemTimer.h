@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stdint.h>
+#include <chrono>
+
+namespace rm {
+    // Totals collected by zx_spectrum when built with RM_SUBSYSTEM_TIMERS. Whatever isn't
+    // rendering, audio or tape is cpu (and the glue around it).
+    struct SubsystemTimes {
+        int64_t renderNs = 0;
+        int64_t audioNs = 0;
+        int64_t tapeNs = 0;
+        int64_t instructions = 0;
+
+        void Clear() { *this = SubsystemTimes(); }
+    };
+
+    // Adds the host time between construction and destruction to a total
+    class SubsystemTimer
+    {
+    public:
+        explicit SubsystemTimer(int64_t& total) : total(total), start(std::chrono::steady_clock::now()) {}
+
+        ~SubsystemTimer() {
+            total += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+    private:
+        int64_t& total;
+        std::chrono::steady_clock::time_point start;
+    };
+}
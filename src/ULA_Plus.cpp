@@ -8,10 +8,12 @@ void rm::ULA_Plus::RegisterDevice(zx_spectrum* speccyModel) {
         speccyModel->UpdateScreenBuffer();
     };
     Enabled = true;
+    Version++;
 }
 
 void rm::ULA_Plus::UnregisterDevice(zx_spectrum* speccyModel) {
     ULAOutEvent = []() -> void {};
     speccyModel->io_devices.erase(this);
     Enabled = false;
+    Version++;
 }
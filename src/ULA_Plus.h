@@ -32,6 +32,7 @@ namespace rm {
         int GroupMode = 0; //0 = palette group, 1 = mode group
         int PaletteGroup = 0;
         bool PaletteEnabled = false;
+        int Version = 0;          //bumped on every palette or mode change so renderers can cache colours
         
         virtual SPECCY_DEVICE DeviceID() override { return SPECCY_DEVICE::ULA_PLUS; }
         byte lastULAPlusOut = 0;
@@ -73,6 +74,8 @@ namespace rm {
 
                     lastULAPlusOut = val;
 
+                    Version++;
+
                     if (GroupMode == 1) {
                         PaletteEnabled = (val & 0x01) != 0;
                     }
@@ -102,6 +105,7 @@ namespace rm {
             GroupMode = 0;
             PaletteGroup = 0;
             PaletteEnabled = false;
+            Version++;
         }
 
         virtual void UnregisterDevice(zx_spectrum* speccyModel) override;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Types.h"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace rm {
+    // Memory watchpoints for the debugger. Each kind keeps a 64K bit map of watched cpu addresses,
+    // and every 8k cpu page gets a byte with the kinds that have at least one watch in it. The
+    // machine keeps a copy of those page bytes next to its page pointers, so an access to a page
+    // without watches costs a single test.
+    class Watchpoints
+    {
+    public:
+        static const byte WATCH_READ = 0x01;
+        static const byte WATCH_WRITE = 0x02;
+        static const byte WATCH_EXECUTE = 0x04;
+
+        Watchpoints() {
+            Clear();
+        }
+
+        // Adds a watch of the given kinds (any combination of WATCH_*) on a cpu address
+        void Add(ushort addr, byte kinds) {
+            for (int k = 0; k < KINDS; k++) {
+                if (kinds & (1 << k))
+                    bits[k][addr >> 6] |= (uint64_t)1 << (addr & 63);
+            }
+
+            UpdatePage(addr >> 13);
+        }
+
+        void Remove(ushort addr, byte kinds) {
+            for (int k = 0; k < KINDS; k++) {
+                if (kinds & (1 << k))
+                    bits[k][addr >> 6] &= ~((uint64_t)1 << (addr & 63));
+            }
+
+            UpdatePage(addr >> 13);
+        }
+
+        void Clear() {
+            memset(bits, 0, sizeof(bits));
+            memset(pageKinds, 0, sizeof(pageKinds));
+        }
+
+        // True if addr has a watch of the given kind
+        bool IsWatched(ushort addr, byte kind) const {
+            for (int k = 0; k < KINDS; k++) {
+                if ((kind & (1 << k)) && (bits[k][addr >> 6] & ((uint64_t)1 << (addr & 63))))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // The WATCH_* kinds with at least one watch in the given 8k cpu page
+        byte PageKinds(int page) const { return pageKinds[page]; }
+
+        bool Any() const {
+            for (int p = 0; p < 8; p++) {
+                if (pageKinds[p])
+                    return true;
+            }
+
+            return false;
+        }
+
+    private:
+        static const int KINDS = 3;
+
+        void UpdatePage(int page) {
+            byte kinds = 0;
+
+            //8k addresses = 128 words per kind
+            for (int k = 0; k < KINDS; k++) {
+                for (int w = page * 128; w < (page + 1) * 128; w++) {
+                    if (bits[k][w]) {
+                        kinds |= (byte)(1 << k);
+                        break;
+                    }
+                }
+            }
+
+            pageKinds[page] = kinds;
+        }
+
+        uint64_t bits[KINDS][65536 / 64];
+        byte pageKinds[8];
+    };
+}
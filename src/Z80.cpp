@@ -1,6 +1,6 @@
 #include "Z80.h"
 
-byte const rm::Z80::parity[256] = {
+byte const rm::Z80Tables::parity[256] = {
     0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04,
     0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
     0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
@@ -19,7 +19,7 @@ byte const rm::Z80::parity[256] = {
     0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04
 };
 
-byte const rm::Z80::sz53[256] =  {
+byte const rm::Z80Tables::sz53[256] =  {
     0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
     0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
@@ -38,7 +38,7 @@ byte const rm::Z80::sz53[256] =  {
     0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8
 };
 
-byte const rm::Z80::sz53p[256] =  {
+byte const rm::Z80Tables::sz53p[256] =  {
     0x44, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x08, 0x0c, 0x0c, 0x08, 0x0c, 0x08, 0x08, 0x0c,
     0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x0c, 0x08, 0x08, 0x0c, 0x08, 0x0c, 0x0c, 0x08,
     0x20, 0x24, 0x24, 0x20, 0x24, 0x20, 0x20, 0x24, 0x2c, 0x28, 0x28, 0x2c, 0x28, 0x2c, 0x2c, 0x28,
@@ -57,7 +57,26 @@ byte const rm::Z80::sz53p[256] =  {
     0xa4, 0xa0, 0xa0, 0xa4, 0xa0, 0xa4, 0xa4, 0xa0, 0xa8, 0xac, 0xac, 0xa8, 0xac, 0xa8, 0xa8, 0xac
 };
 
-byte const rm::Z80::halfcarry_add[8] = { 0, BIT_F_HALF, BIT_F_HALF, BIT_F_HALF, 0, 0, 0, BIT_F_HALF };
-byte const rm::Z80::halfcarry_sub[8] = { 0, 0, BIT_F_HALF, 0, BIT_F_HALF, 0, BIT_F_HALF, BIT_F_HALF };
-byte const rm::Z80::overflow_add[8] =  { 0, 0, 0, BIT_F_PARITY, BIT_F_PARITY, 0, 0, 0 };
-byte const rm::Z80::overflow_sub[8] =  { 0, BIT_F_PARITY, 0, 0, 0, 0, BIT_F_PARITY, 0 };
+byte const rm::Z80Tables::halfcarry_add[8] = { 0, BIT_F_HALF, BIT_F_HALF, BIT_F_HALF, 0, 0, 0, BIT_F_HALF };
+byte const rm::Z80Tables::halfcarry_sub[8] = { 0, 0, BIT_F_HALF, 0, BIT_F_HALF, 0, BIT_F_HALF, BIT_F_HALF };
+byte const rm::Z80Tables::overflow_add[8] =  { 0, 0, 0, BIT_F_PARITY, BIT_F_PARITY, 0, 0, 0 };
+byte const rm::Z80Tables::overflow_sub[8] =  { 0, BIT_F_PARITY, 0, 0, 0, 0, BIT_F_PARITY, 0 };
+
+byte const rm::Z80Tables::lazy_flags_safe[256] = {
+    1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
+    1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0,
+    0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
+    0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 0, 1,
+    0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 1, 1,
+    0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 0, 1, 0, 0, 1, 1
+};
@@ -3,8 +3,26 @@
 #include "Types.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <functional>
 
+//RM_Z80_NEXT ends an opcode handler. With RM_Z80_TAIL_DISPATCH every handler fetches the
+//next opcode and jumps to it itself (see ContinueRun()), so each one gets its own indirect
+//branch instead of all of them sharing the one in Step().
+#if RM_Z80_COMPUTED_GOTO
+    #define RM_Z80_OP(label) label:
+    #define RM_Z80_DISPATCH(table, opcode) goto *table##_table[opcode]
+#else
+    #define RM_Z80_OP(label)
+    #define RM_Z80_DISPATCH(table, opcode) do {} while (0)
+#endif
+
+#if RM_Z80_TAIL_DISPATCH
+    #define RM_Z80_NEXT do { if (ContinueRun(opcode, tstate, count)) goto *main_table[opcode]; return count; } while (0)
+#else
+    #define RM_Z80_NEXT break
+#endif
+
 #if RM_LITTLE_ENDIAN
     #define RM_REG16(i, h, l) union { ushort i; struct { byte l; byte h; }; }
 #else
@@ -12,11 +30,102 @@
 #endif
 
 namespace rm {
+    //Constants and lookup tables shared by every Z80Core instantiation.
+    class Z80Tables
+    {
+    public:
+        // -----------------------------------------------------
+        // Bit |  7  |  6  |  5  |  4  |  3  |  2  |  1  |  0  |
+        // -----------------------------------------------------
+        // Flag|  S  |  Z  | F5  |  H  | F3  | P/V |  N  |  C  |
+        // -----------------------------------------------------
+        static const byte BIT_F_CARRY = 0x01;
+        static const byte BIT_F_NEG = 0x02;
+        static const byte BIT_F_PARITY = 0x04;
+        static const byte BIT_F_3 = 0x08;
+        static const byte BIT_F_HALF = 0x10;
+        static const byte BIT_F_5 = 0x20;
+        static const byte BIT_F_ZERO = 0x40;
+        static const byte BIT_F_SIGN = 0x80;
+
+        static const int BIT_11 = 0x800;
+        static const int BIT_13 = 0x2000;
+
+
+        //Tables for parity and flags. Pretty much taken from Fuse.
+        static byte const parity[256];
+        static byte const sz53[256];
+        static byte const sz53p[256];
+        static byte const halfcarry_add[8];
+        static byte const halfcarry_sub[8];
+        static byte const overflow_add[8];
+        static byte const overflow_sub[8];
+
+        //Main opcodes that neither read F nor only partially update it. With lazy flags,
+        //these can run without materialising a pending F first.
+        static byte const lazy_flags_safe[256];
+    };
+
+    //Bus adapter that forwards every access through a std::function.
+    //Slow, but anything (debuggers, tests, tools) can hook into it at runtime.
+    class FunctionBus
+    {
+    public:
+        std::function<byte(ushort addr)> PeekByte;
+        std::function<ushort(ushort addr)> PeekWord;
+        std::function<void(ushort addr, byte val)> PokeByte;
+        std::function<void(ushort addr, ushort val)> PokeWord;
+        std::function<void(int reg, int times, int count)> Contend;
+        std::function<byte(ushort addr)> In;
+        std::function<void(ushort addr, byte val)> Out;
+        std::function<void()> InstructionFetchSignal;
+        std::function<void()> TapeEdgeDetection;
+        std::function<void()> TapeEdgeDecA;
+        std::function<void()> TapeEdgeCpA;
+
+        FunctionBus() {
+            PeekByte = [](ushort) -> byte { return 0; };
+            PeekWord = [](ushort) -> ushort { return 0; };
+            PokeByte = [](ushort, byte) -> void {};
+            PokeWord = [](ushort, ushort) -> void {};
+            Contend = [](int, int, int) -> void {};
+            In = [](ushort addr) -> byte { return 0; };
+            Out = [](ushort, byte) -> void {};
+            InstructionFetchSignal = []() -> void {};
+            TapeEdgeDetection = []() -> void {};
+            TapeEdgeDecA = []() -> void {};
+            TapeEdgeCpA = []() -> void {};
+        }
+    };
+
     //Z80Core.cs
     //(c) Arjun Nair 2009
-    class Z80
+    //
+    //The Bus policy supplies memory, port, contention and trap callbacks:
+    //    byte PeekByte(ushort addr), ushort PeekWord(ushort addr),
+    //    void PokeByte(ushort addr, byte val), void PokeWord(ushort addr, ushort val),
+    //    void Contend(int reg, int times, int count),
+    //    byte In(ushort port), void Out(ushort port, byte val),
+    //    void InstructionFetchSignal(), void TapeEdgeDetection(),
+    //    void TapeEdgeDecA(), void TapeEdgeCpA()
+    //A machine-specific policy with inline members lets the compiler inline the
+    //bus straight into Execute(). FunctionBus keeps the old std::function hooks.
+    template<class Bus>
+    class Z80Core : public Z80Tables, public Bus
     {
     public:
+        using Bus::PeekByte;
+        using Bus::PeekWord;
+        using Bus::PokeByte;
+        using Bus::PokeWord;
+        using Bus::Contend;
+        using Bus::In;
+        using Bus::Out;
+        using Bus::InstructionFetchSignal;
+        using Bus::TapeEdgeDetection;
+        using Bus::TapeEdgeDecA;
+        using Bus::TapeEdgeCpA;
+
         //Clock state
         int t_states = 0;                 //opcode t-states
 
@@ -34,6 +143,10 @@ namespace rm {
 
         bool and_32_Or_64 = false;   //tape trap acceleration
 
+        //Batch execution (see RunUntil)
+        int breakPC = -1;            //RunUntil stops before executing the instruction at this address
+        bool yieldRequested = false; //set by the bus to make RunUntil return after the current instruction
+
         struct {
             ushort SP, PC;
             RM_REG16(IX, IXH, IXL);
@@ -55,35 +168,130 @@ namespace rm {
         }
         regs;
 
-        // -----------------------------------------------------
-        // Bit |  7  |  6  |  5  |  4  |  3  |  2  |  1  |  0  |
-        // -----------------------------------------------------
-        // Flag|  S  |  Z  | F5  |  H  | F3  | P/V |  N  |  C  |
-        // -----------------------------------------------------
-        static const byte BIT_F_CARRY = 0x01;
-        static const byte BIT_F_NEG = 0x02;
-        static const byte BIT_F_PARITY = 0x04;
-        static const byte BIT_F_3 = 0x08;
-        static const byte BIT_F_HALF = 0x10;
-        static const byte BIT_F_5 = 0x20;
-        static const byte BIT_F_ZERO = 0x40;
-        static const byte BIT_F_SIGN = 0x80;
+        //Temp placeholders for flag operations.
+        int carry, neg, pv, f3, half, f5, zero, sign;
 
-        static const int BIT_11 = 0x800;
-        static const int BIT_13 = 0x2000;
+#if RM_Z80_LAZY_FLAGS
+        //Lazy flags. The 8-bit ALU helpers record the operation and its operands here
+        //instead of computing F. SyncFlags() materialises F when something reads it.
+        static const byte LAZY_NONE = 0;
+        static const byte LAZY_ADD = 1;
+        static const byte LAZY_SUB = 2;
+        static const byte LAZY_CP = 3;
+        static const byte LAZY_AND = 4;
+        static const byte LAZY_XOR = 5;
+        static const byte LAZY_OR = 6;
+        static const byte LAZY_INC = 7;
+        static const byte LAZY_DEC = 8;
 
+        struct {
+            byte op = LAZY_NONE;    //LAZY_NONE when regs.F is up to date
+            byte a, b;              //accumulator (or register) and operand before the operation
+            byte carry;             //carry in, for INC and DEC
+        }
+        lazyF;
 
-        //Tables for parity and flags. Pretty much taken from Fuse.
-        static byte const parity[256];
-        static byte const sz53[256];
-        static byte const sz53p[256];
-        static byte const halfcarry_add[8];
-        static byte const halfcarry_sub[8];
-        static byte const overflow_add[8];
-        static byte const overflow_sub[8];
+        //True when Q is F3/F5 of the current F, i.e. the last instruction left F alone
+        bool qFromF = false;
 
-        //Temp placeholders for flag operations.
-        int carry, neg, pv, f3, half, f5, zero, sign;
+        void SetLazyFlags(byte op, byte a, byte b) {
+            lazyF.op = op;
+            lazyF.a = a;
+            lazyF.b = b;
+            regs.modified_F = true;
+        }
+
+        //Carry of the pending operation, without materialising the rest of F
+        byte LazyCarry() const {
+            switch (lazyF.op) {
+                case LAZY_NONE: return regs.F & BIT_F_CARRY;
+                case LAZY_ADD: return (byte)(((lazyF.a + lazyF.b) >> 8) & BIT_F_CARRY);
+                case LAZY_SUB:
+                case LAZY_CP: return lazyF.a < lazyF.b ? BIT_F_CARRY : 0;
+                case LAZY_INC:
+                case LAZY_DEC: return lazyF.carry;
+                default: return 0;
+            }
+        }
+
+        //F for the pending operation. Each case mirrors the eager helper of the same name.
+        byte LazyFlags() const {
+            byte a = lazyF.a;
+            byte reg = lazyF.b;
+
+            switch (lazyF.op) {
+                case LAZY_ADD: {
+                    int addtemp = a + reg;
+                    byte lookup = (byte)(((a & 0x88 ) >> 3 ) | (((reg) & 0x88 ) >> 2 ) | ( ( addtemp & 0x88 ) >> 1 ));
+                    return (byte)(((addtemp & 0x100) > 0 ? BIT_F_CARRY : 0 ) | halfcarry_add[lookup & 0x07] |
+                        overflow_add[lookup >> 4] | sz53[addtemp & 0xff]);
+                }
+                case LAZY_SUB: {
+                    int subtemp = a - (reg);
+                    byte lookup = (byte)(((a & 0x88 ) >> 3 ) | ( (reg & 0x88 ) >> 2 ) | ((subtemp & 0x88 ) >> 1 ));
+                    return (byte)(((subtemp & 0x100) > 0 ? BIT_F_CARRY : 0 ) | BIT_F_NEG | halfcarry_sub[lookup & 0x07] |
+                        overflow_sub[lookup >> 4] | sz53[subtemp & 0xff]);
+                }
+                case LAZY_CP: {
+                    int cptemp = a - reg;
+                    byte lookup = (byte)(((a & 0x88 ) >> 3 ) | ( ( (reg) & 0x88 ) >> 2 ) | ( (cptemp & 0x88 ) >> 1 ));
+                    return (byte)(((cptemp & 0x100) > 0 ? BIT_F_CARRY : ( cptemp > 0 ? 0 : BIT_F_ZERO ) ) | BIT_F_NEG |
+                        halfcarry_sub[lookup & 0x07] | overflow_sub[lookup >> 4] |( reg & ( BIT_F_3 | BIT_F_5 ) ) | ( cptemp & BIT_F_SIGN ));
+                }
+                case LAZY_AND:
+                    return (byte)(BIT_F_HALF | sz53p[a & reg]);
+                case LAZY_XOR:
+                    return sz53p[a ^ reg];
+                case LAZY_OR:
+                    return sz53p[a | reg];
+                case LAZY_INC: {
+                    reg++;
+                    return (byte)(lazyF.carry | ( (reg == 0x80) ? BIT_F_PARITY : 0 ) |
+                        ((reg & 0x0f) > 0 ? 0 : BIT_F_HALF ) | sz53[reg]);
+                }
+                case LAZY_DEC: {
+                    byte f = (byte)(lazyF.carry | ( (reg & 0x0f) > 0 ? 0 : BIT_F_HALF ) | BIT_F_NEG);
+                    reg--;
+                    return (byte)(f | ((reg) == 0x7f ? BIT_F_PARITY : 0) | sz53[reg]);
+                }
+                default:
+                    return regs.F;
+            }
+        }
+#endif
+
+        //Brings regs.F up to date
+        void MaterializeFlags() {
+#if RM_Z80_LAZY_FLAGS
+            if (lazyF.op != LAZY_NONE) {
+                regs.F = LazyFlags();
+                lazyF.op = LAZY_NONE;
+            }
+#endif
+        }
+
+        //Brings regs.F and regs.Q up to date. With lazy flags, anything outside the core
+        //that reads or writes F, AF or Q must call this first, between instructions.
+        void SyncFlags() {
+#if RM_Z80_LAZY_FLAGS
+            MaterializeFlags();
+            if (qFromF) {
+                regs.Q = (byte)(regs.F & (BIT_F_3 | BIT_F_5));
+                qFromF = false;
+            }
+#endif
+        }
+
+        //Returns Q, the F3/F5 bits latched by the previous instruction (see Step())
+        byte GetQ() {
+#if RM_Z80_LAZY_FLAGS
+            if (qFromF) {
+                MaterializeFlags();
+                return (byte)(regs.F & (BIT_F_3 | BIT_F_5));
+            }
+#endif
+            return regs.Q;
+        }
 
         //Parity/Overflow flag needs to be rest if there is an interrupt, right after
         //LD A, R or LD A, I
@@ -91,6 +299,7 @@ namespace rm {
         bool parityBitNeedsReset = false;
 
         void SetCarry(bool val) {
+            MaterializeFlags();
             if (val) {
                 regs.F |= BIT_F_CARRY;
             } else {
@@ -100,6 +309,7 @@ namespace rm {
         }
 
         void SetNeg(bool val) {
+            MaterializeFlags();
             if (val) {
                 regs.F |=  BIT_F_NEG;
             } else {
@@ -109,6 +319,7 @@ namespace rm {
         }
 
         void SetParity(byte val) {
+            MaterializeFlags();
             if (val > 0) {
                 regs.F |= BIT_F_PARITY;
             } else {
@@ -118,6 +329,7 @@ namespace rm {
         }
 
         void SetParity(bool val) {
+            MaterializeFlags();
             if (val) {
                 regs.F |= BIT_F_PARITY;
             } else {
@@ -127,6 +339,7 @@ namespace rm {
         }
 
         void SetHalf(bool val) {
+            MaterializeFlags();
             if (val) {
                 regs.F |= BIT_F_HALF;
             } else {
@@ -136,6 +349,7 @@ namespace rm {
         }
 
         void SetZero(bool val) {
+            MaterializeFlags();
             if(val) {
                 regs.F |= BIT_F_ZERO;
             }
@@ -146,6 +360,7 @@ namespace rm {
         }
 
         void SetSign(bool val) {
+            MaterializeFlags();
             if(val) {
                 regs.F |= BIT_F_SIGN;
             }
@@ -156,6 +371,7 @@ namespace rm {
         }
 
         void SetF3(bool val) {
+            MaterializeFlags();
             if(val) {
                 regs.F |= BIT_F_3;
             }
@@ -166,6 +382,7 @@ namespace rm {
         }
 
         void SetF5(bool val) {
+            MaterializeFlags();
             if(val) {
                 regs.F |= BIT_F_5;
             }
@@ -175,19 +392,7 @@ namespace rm {
             regs.modified_F = true;
         }
 
-        std::function<byte(ushort addr)> PeekByte;
-        std::function<ushort(ushort addr)> PeekWord;
-        std::function<void(ushort addr, byte val)> PokeByte;
-        std::function<void(ushort addr, ushort val)> PokeWord;
-        std::function<void(int reg, int times, int count)> Contend;
-        std::function<byte(ushort addr)> In;
-        std::function<void(ushort addr, byte val)> Out;
-        std::function<void()> InstructionFetchSignal;
-        std::function<void()> TapeEdgeDetection;
-        std::function<void()> TapeEdgeDecA;
-        std::function<void()> TapeEdgeCpA;
-
-        Z80() {
+        Z80Core() {
             //All registers are set to 0xffff during a cold boot
             //http://worldofspectrum.org/forums/showthread.php?t=34574&page=3
             regs.SP = 0xffff;
@@ -215,21 +420,12 @@ namespace rm {
             regs.MemPtr = 0;
             iff_1 = false;
             iff_2 = false;
-
-            PeekByte = [](ushort) -> byte { return 0; };
-            PeekWord = [](ushort) -> ushort { return 0; };
-            PokeByte = [](ushort, byte) -> void {};
-            PokeWord = [](ushort, ushort) -> void {};
-            Contend = [](int, int, int) -> void {};
-            In = [](ushort addr) -> byte { return 0; };
-            Out = [](ushort, byte) -> void {};
-            InstructionFetchSignal = []() -> void {};
-            TapeEdgeDetection = []() -> void {};
-            TapeEdgeDecA = []() -> void {};
-            TapeEdgeCpA = []() -> void {};
         }
 
         void HardReset() {
+#if RM_Z80_LAZY_FLAGS
+            lazyF.op = LAZY_NONE;
+#endif
             //RESET behaviour
             //http://worldofspectrum.org/forums/showthread.php?t=34574&page=3
             regs.SP = 0xffff;
@@ -250,6 +446,9 @@ namespace rm {
             regs.HL = 0xffff;
             regs.modified_F = false;
             regs.Q = 0;
+#if RM_Z80_LAZY_FLAGS
+            qFromF = false;
+#endif
 
             regs.PC = 0;
             interrupt_mode = 0;
@@ -275,12 +474,18 @@ namespace rm {
             iff_2 = false;
             regs.modified_F = false;
             regs.Q = 0;
+#if RM_Z80_LAZY_FLAGS
+            qFromF = false;
+#endif
         }
 
         void Interrupt() {
             regs.R++;
             regs.modified_F = false;
             regs.Q = 0;
+#if RM_Z80_LAZY_FLAGS
+            qFromF = false;
+#endif
 
             //Disable interrupts
             iff_1 = false;
@@ -316,6 +521,7 @@ namespace rm {
         }
 
         void ex_af_af() {
+            MaterializeFlags();
             ushort temp = regs.AF_;
             regs.AF_ = regs.AF;
             regs.AF = temp;
@@ -366,6 +572,11 @@ namespace rm {
         }
 
         byte Inc(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            lazyF.carry = LazyCarry();
+            SetLazyFlags(LAZY_INC, reg, reg);
+            return (byte)(reg + 1);
+#else
             reg++;
             regs.F = (byte)(( regs.F & BIT_F_CARRY ) | ( (reg == 0x80) ? BIT_F_PARITY : 0 ) | 
                 ((reg & 0x0f) > 0 ? 0 : BIT_F_HALF ));
@@ -373,9 +584,15 @@ namespace rm {
             regs.F |= sz53[reg];
             regs.modified_F = true;
             return reg;
+#endif
         }
 
         byte Dec(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            lazyF.carry = LazyCarry();
+            SetLazyFlags(LAZY_DEC, reg, reg);
+            return (byte)(reg - 1);
+#else
              regs.F = (byte)(( regs.F & BIT_F_CARRY ) | ( (reg & 0x0f) > 0 ? 0 : BIT_F_HALF ) | BIT_F_NEG);
              reg--;
              regs.F |= (byte)(((reg) == 0x7f ? BIT_F_PARITY : 0));
@@ -383,10 +600,12 @@ namespace rm {
              regs.F |= sz53[reg];
              regs.modified_F = true;
              return reg;
+#endif
         }
 
         //16 bit addition (no carry)
         ushort Add_RR(ushort rr1, ushort rr2) {
+            MaterializeFlags();
             int add16temp = (rr1) + (rr2);
             byte lookup = (byte)((((rr1) & 0x0800 ) >> 11 ) | ( (  (rr2) & 0x0800 ) >> 10 ) | ( ( add16temp & 0x0800 ) >>  9));
             rr1 = (ushort)add16temp;
@@ -398,16 +617,22 @@ namespace rm {
 
         //8 bit add to accumulator (no carry)
         void Add_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_ADD, regs.A, reg);
+            regs.A += reg;
+#else
              int addtemp = regs.A + reg;
              byte lookup = (byte)(((regs.A & 0x88 ) >> 3 ) | (((reg) & 0x88 ) >> 2 ) | ( ( addtemp & 0x88 ) >> 1 ));
              regs.A= (byte)(addtemp & 0xff);
              regs.F = (byte)(((addtemp & 0x100) > 0 ? BIT_F_CARRY : 0 ) | halfcarry_add[lookup & 0x07] | 
                 overflow_add[lookup >> 4] | sz53[regs.A]);
              regs.modified_F = true;
+#endif
         }
 
         //Add with carry into accumulator
         void Adc_R(byte reg) {
+            MaterializeFlags();
             int adctemp = regs.A + (reg) + ( regs.F & BIT_F_CARRY ); 
             byte lookup = (byte)(((regs.A & 0x88) >> 3) | (((reg) & 0x88)>>2) | ((adctemp & 0x88)>> 1)); 
             regs.A= (byte)(adctemp & 0xff);
@@ -418,6 +643,7 @@ namespace rm {
 
         //Add with carry into regs.HL
         void Adc_RR(ushort reg) {
+            MaterializeFlags();
             int add16temp = regs.HL + (reg) + ( regs.F & BIT_F_CARRY );
             byte lookup = (byte)(((regs.HL & 0x8800 ) >> 11 ) | (((reg) & 0x8800 ) >> 10 ) | ( ( add16temp & 0x8800 ) >>  9 ));
             regs.HL = (ushort)(add16temp);
@@ -429,16 +655,22 @@ namespace rm {
 
         //8 bit subtract to accumulator (no carry)
         void Sub_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_SUB, regs.A, reg);
+            regs.A -= reg;
+#else
             int subtemp = regs.A - (reg);
             byte lookup = (byte)(((regs.A & 0x88 ) >> 3 ) | ( (reg & 0x88 ) >> 2 ) | ((subtemp & 0x88 ) >> 1 )); 
             regs.A= (byte)subtemp;
             regs.F = (byte)(((subtemp & 0x100) > 0 ? BIT_F_CARRY : 0 ) | BIT_F_NEG | halfcarry_sub[lookup & 0x07] | 
                 overflow_sub[lookup >> 4] | sz53[regs.A]);
             regs.modified_F = true;
+#endif
         }
 
         //8 bit subtract from accumulator with carry (SBC A, r)
         void Sbc_R(byte reg) {
+            MaterializeFlags();
             int sbctemp = regs.A - (reg) - ( regs.F & BIT_F_CARRY );
             byte lookup = (byte)(((regs.A & 0x88 ) >> 3 ) |( ( (reg) & 0x88 ) >> 2 ) |( ( sbctemp & 0x88 ) >> 1 ));
             regs.A= (byte)sbctemp;
@@ -449,6 +681,7 @@ namespace rm {
 
         //16 bit subtract from regs.HL with carry
         void Sbc_RR(ushort reg) {
+            MaterializeFlags();
             int sub16temp = regs.HL - (reg) - (regs.F & BIT_F_CARRY);
             byte lookup = (byte)(((regs.HL & 0x8800 ) >> 11 ) | ( ((reg) & 0x8800 ) >> 10 ) | (( sub16temp & 0x8800 ) >>  9 ));
             regs.HL = (ushort)sub16temp;
@@ -459,17 +692,26 @@ namespace rm {
 
         //Comparison with accumulator
         void Cp_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_CP, regs.A, reg);
+#else
             int cptemp = regs.A - reg;
             byte lookup = (byte)(((regs.A & 0x88 ) >> 3 ) | ( ( (reg) & 0x88 ) >> 2 ) | ( (cptemp & 0x88 ) >> 1 ));
             regs.F = (byte)(((cptemp & 0x100) > 0 ? BIT_F_CARRY : ( cptemp > 0 ? 0 : BIT_F_ZERO ) ) | BIT_F_NEG |
                 halfcarry_sub[lookup & 0x07] | overflow_sub[lookup >> 4] |( reg & ( BIT_F_3 | BIT_F_5 ) ) | ( cptemp & BIT_F_SIGN ));
             regs.modified_F = true;
+#endif
         }
 
         //AND with accumulator
         void And_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_AND, regs.A, reg);
+            regs.A &= reg;
+#else
             regs.A &= reg;
             regs.F = (byte)(BIT_F_HALF | sz53p[regs.A]);
+#endif
             
             //For ROM TRAP
             if (((reg & (~96)) == 0) &&  (reg != 96))
@@ -479,16 +721,26 @@ namespace rm {
 
         //XOR with accumulator
         void Xor_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_XOR, regs.A, reg);
+            regs.A ^= reg;
+#else
             regs.A = (byte)( regs.A ^ reg);
             regs.F = sz53p[regs.A];
             regs.modified_F = true;
+#endif
         }
 
         //OR with accumulator
         void Or_R(byte reg) {
+#if RM_Z80_LAZY_FLAGS
+            SetLazyFlags(LAZY_OR, regs.A, reg);
+            regs.A |= reg;
+#else
             regs.A |= reg;
             regs.F = sz53p[regs.A];
             regs.modified_F = true;
+#endif
         }
 
         //Rotate left with carry register (RLC r)
@@ -510,6 +762,7 @@ namespace rm {
 
         //Rotate left register (RL r)
         byte Rl_R(byte reg) {
+            MaterializeFlags();
             byte rltemp = reg;
             reg = (byte)((reg << 1) | (regs.F & BIT_F_CARRY));
             regs.F = (byte)(( rltemp >> 7 ) | sz53p[reg]);
@@ -519,6 +772,7 @@ namespace rm {
 
         //Rotate right register (RL r)
         byte Rr_R(byte reg) {
+            MaterializeFlags();
             byte rrtemp = reg;
             reg = (byte)((reg >> 1 ) | ( regs.F << 7 ));
             regs.F = (byte)(( rrtemp & BIT_F_CARRY ) | sz53p[reg]);
@@ -564,6 +818,7 @@ namespace rm {
 
         //Bit test operation (BIT b, r)
         void Bit_R(int b, byte val) {
+            MaterializeFlags();
             regs.F = (byte)(( regs.F & BIT_F_CARRY ) | BIT_F_HALF | ( val & ( BIT_F_3 | BIT_F_5 ) ));
             if( !((val & ( 0x01 << (b))) > 0)) regs.F |= BIT_F_PARITY | BIT_F_ZERO;
             if( (b == 7) && ((val & 0x80) > 0)) regs.F |= BIT_F_SIGN; 
@@ -571,6 +826,7 @@ namespace rm {
         }
 
         void Bit_MemPtr(int b, byte val) {
+            MaterializeFlags();
             regs.F = (byte)((regs.F & BIT_F_CARRY) | BIT_F_HALF | ((regs.MemPtr >> 8) & (BIT_F_3 | BIT_F_5)));
             if (!((val & (0x01 << (b))) > 0)) regs.F |= BIT_F_PARITY | BIT_F_ZERO;
             if ((b == 7) && ((val & 0x80) > 0)) regs.F |= BIT_F_SIGN;
@@ -642,6 +898,7 @@ namespace rm {
         }
 
         byte In_BC(){
+            MaterializeFlags();
             byte result = In(regs.BC);
             regs.F = (byte)((regs.F & BIT_F_CARRY) | sz53p[result]);
             regs.modified_F = true;
@@ -662,18 +919,149 @@ namespace rm {
         }
 
         void Step() {
+            Step(INT_MIN);
+        }
+
+        //Step() that carries on with the following instructions while RunUntil(tstate) would,
+        //without coming back here in between. Only tail dispatch does that; otherwise it always
+        //runs one instruction. Returns the number of instructions executed.
+        int Step(int tstate) {
             int opcode = FetchInstruction();
             regs.modified_F = false;
-            Execute(opcode);
+            int count = Execute(opcode, tstate) + 1;
+            EndStep();
+            return count;
+        }
+
+        //Latches Q once an instruction is done
+        void EndStep() {
+#if RM_Z80_LAZY_FLAGS
+            //Q is only worked out from F if someone asks for it. See GetQ().
+            regs.Q = 0;
+            qFromF = !regs.modified_F;
+#else
             regs.Q = (byte)((regs.modified_F ? 0 : regs.F) & (BIT_F_3 | BIT_F_5));
+#endif
+        }
+
+        //RunUntil()'s loop condition
+        bool KeepRunning(int tstate) const {
+            return t_states < tstate && regs.PC != breakPC && !yieldRequested;
+        }
+
+        //Same bookkeeping zx_spectrum::Process() does between instructions
+        void BetweenInstructions() {
+            if (interrupt_count > 0)
+                interrupt_count--;
+        }
+
+        //Brings F up to date if opcode needs it (see lazy_flags_safe)
+        void PrepareFlags(int opcode) {
+#if RM_Z80_LAZY_FLAGS
+            if (!lazy_flags_safe[opcode])
+                MaterializeFlags();
+#else
+            (void)opcode;
+#endif
+        }
+
+#if RM_Z80_TAIL_DISPATCH
+        //Called by RM_Z80_NEXT at the end of every handler. Does what one more turn of RunUntil()'s
+        //loop would, up to fetching the next opcode, or returns false if the loop would stop.
+        //A halted CPU goes back through Step() so HALT keeps a single code path.
+        bool ContinueRun(int& opcode, int tstate, int& count) {
+            if (!KeepRunning(tstate) || is_halted)
+                return false;
+
+            EndStep();
+            count++;
+            BetweenInstructions();
+
+            opcode = FetchInstruction();
+            regs.modified_F = false;
+            PrepareFlags(opcode);
+            return true;
+        }
+#endif
+
+        //Executes instructions back to back until t_states reaches tstate, PC hits breakPC
+        //or the bus raises yieldRequested. Interrupts are not serviced here; the caller has to
+        //stop at the interrupt window. Returns the number of instructions executed.
+        int RunUntil(int tstate) {
+            int count = 0;
+            yieldRequested = false;
+
+            while (KeepRunning(tstate)) {
+                BetweenInstructions();
+                count += Step(tstate);
+            }
+
+            return count;
+        }
+
+        //Copies the architectural state (registers, interrupt and clock state) from a core
+        //on another bus, so a machine can switch between bus policies between instructions.
+        template<class OtherBus>
+        void CopyStateFrom(Z80Core<OtherBus> const& other) {
+            t_states = other.t_states;
+            interrupt_mode = other.interrupt_mode;
+            interrupt_count = other.interrupt_count;
+            iff_1 = other.iff_1;
+            iff_2 = other.iff_2;
+            is_halted = other.is_halted;
+            disp = other.disp;
+            addr = other.addr;
+            val = other.val;
+            and_32_Or_64 = other.and_32_Or_64;
+            parityBitNeedsReset = other.parityBitNeedsReset;
+
+            regs.SP = other.regs.SP;
+            regs.PC = other.regs.PC;
+            regs.IX = other.regs.IX;
+            regs.IY = other.regs.IY;
+            regs.AF_ = other.regs.AF_;
+            regs.BC_ = other.regs.BC_;
+            regs.DE_ = other.regs.DE_;
+            regs.HL_ = other.regs.HL_;
+            regs.MemPtr = other.regs.MemPtr;
+            regs.AF = other.regs.AF;
+            regs.BC = other.regs.BC;
+            regs.HL = other.regs.HL;
+            regs.DE = other.regs.DE;
+            regs.I = other.regs.I;
+            regs.R = other.regs.R;
+            regs.R_ = other.regs.R_;
+            regs.Q = other.regs.Q;
+            regs.modified_F = other.regs.modified_F;
+
+#if RM_Z80_LAZY_FLAGS
+            lazyF.op = other.lazyF.op;
+            lazyF.a = other.lazyF.a;
+            lazyF.b = other.lazyF.b;
+            lazyF.carry = other.lazyF.carry;
+            qFromF = other.qFromF;
+#endif
         }
 
         //Executes a single opcode
         void Execute(int opcode) {
+            Execute(opcode, INT_MIN);
+        }
+
+        //Executes opcode and, with tail dispatch, the instructions after it until ContinueRun()
+        //says stop. Returns the number executed after opcode itself.
+        int Execute(int opcode, int tstate) {
+            int count = 0;
+#if !RM_Z80_TAIL_DISPATCH
+            (void)tstate;
+#endif
+
             if (is_halted)
-                return;
+                return count;
             //disp = 0;
 
+            PrepareFlags(opcode);
+
             bool ac;
             int blockIOData;
             byte data;
@@ -683,647 +1071,902 @@ namespace rm {
             byte result;
             ushort temp;
 
+            //(IX+d)/(IY+d) and the byte read from it, for the DDCB and FDCB handlers. Declared
+            //here rather than in their blocks so that no jump skips the initialisation.
+            ushort offset = 0;
+            byte b = 0;
+
+#if RM_Z80_COMPUTED_GOTO
+            //One table of handler addresses per prefix. Opcodes a prefix does not list
+            //go to that prefix's default handler.
+            static void* const main_table[256] = {
+                &&main_00, &&main_01, &&main_02, &&main_03, &&main_04, &&main_05, &&main_06, &&main_07,
+                &&main_08, &&main_09, &&main_0A, &&main_0B, &&main_0C, &&main_0D, &&main_0E, &&main_0F,
+                &&main_10, &&main_11, &&main_12, &&main_13, &&main_14, &&main_15, &&main_16, &&main_17,
+                &&main_18, &&main_19, &&main_1A, &&main_1B, &&main_1C, &&main_1D, &&main_1E, &&main_1F,
+                &&main_20, &&main_21, &&main_22, &&main_23, &&main_24, &&main_25, &&main_26, &&main_27,
+                &&main_28, &&main_29, &&main_2A, &&main_2B, &&main_2C, &&main_2D, &&main_2E, &&main_2F,
+                &&main_30, &&main_31, &&main_32, &&main_33, &&main_34, &&main_35, &&main_36, &&main_37,
+                &&main_38, &&main_39, &&main_3A, &&main_3B, &&main_3C, &&main_3D, &&main_3E, &&main_3F,
+                &&main_40, &&main_41, &&main_42, &&main_43, &&main_44, &&main_45, &&main_46, &&main_47,
+                &&main_48, &&main_49, &&main_4A, &&main_4B, &&main_4C, &&main_4D, &&main_4E, &&main_4F,
+                &&main_50, &&main_51, &&main_52, &&main_53, &&main_54, &&main_55, &&main_56, &&main_57,
+                &&main_58, &&main_59, &&main_5A, &&main_5B, &&main_5C, &&main_5D, &&main_5E, &&main_5F,
+                &&main_60, &&main_61, &&main_62, &&main_63, &&main_64, &&main_65, &&main_66, &&main_67,
+                &&main_68, &&main_69, &&main_6A, &&main_6B, &&main_6C, &&main_6D, &&main_6E, &&main_6F,
+                &&main_70, &&main_71, &&main_72, &&main_73, &&main_74, &&main_75, &&main_76, &&main_77,
+                &&main_78, &&main_79, &&main_7A, &&main_7B, &&main_7C, &&main_7D, &&main_7E, &&main_7F,
+                &&main_80, &&main_81, &&main_82, &&main_83, &&main_84, &&main_85, &&main_86, &&main_87,
+                &&main_88, &&main_89, &&main_8A, &&main_8B, &&main_8C, &&main_8D, &&main_8E, &&main_8F,
+                &&main_90, &&main_91, &&main_92, &&main_93, &&main_94, &&main_95, &&main_96, &&main_97,
+                &&main_98, &&main_99, &&main_9A, &&main_9B, &&main_9C, &&main_9D, &&main_9E, &&main_9F,
+                &&main_A0, &&main_A1, &&main_A2, &&main_A3, &&main_A4, &&main_A5, &&main_A6, &&main_A7,
+                &&main_A8, &&main_A9, &&main_AA, &&main_AB, &&main_AC, &&main_AD, &&main_AE, &&main_AF,
+                &&main_B0, &&main_B1, &&main_B2, &&main_B3, &&main_B4, &&main_B5, &&main_B6, &&main_B7,
+                &&main_B8, &&main_B9, &&main_BA, &&main_BB, &&main_BC, &&main_BD, &&main_BE, &&main_BF,
+                &&main_C0, &&main_C1, &&main_C2, &&main_C3, &&main_C4, &&main_C5, &&main_C6, &&main_C7,
+                &&main_C8, &&main_C9, &&main_CA, &&main_CB, &&main_CC, &&main_CD, &&main_CE, &&main_CF,
+                &&main_D0, &&main_D1, &&main_D2, &&main_D3, &&main_D4, &&main_D5, &&main_D6, &&main_D7,
+                &&main_D8, &&main_D9, &&main_DA, &&main_DB, &&main_DC, &&main_DD, &&main_DE, &&main_DF,
+                &&main_E0, &&main_E1, &&main_E2, &&main_E3, &&main_E4, &&main_E5, &&main_E6, &&main_E7,
+                &&main_E8, &&main_E9, &&main_EA, &&main_EB, &&main_EC, &&main_ED, &&main_EE, &&main_EF,
+                &&main_F0, &&main_F1, &&main_F2, &&main_F3, &&main_F4, &&main_F5, &&main_F6, &&main_F7,
+                &&main_F8, &&main_F9, &&main_FA, &&main_FB, &&main_FC, &&main_FD, &&main_FE, &&main_FF
+            };
+
+            static void* const cb_table[256] = {
+                &&cb_00, &&cb_01, &&cb_02, &&cb_03, &&cb_04, &&cb_05, &&cb_06, &&cb_07,
+                &&cb_08, &&cb_09, &&cb_0A, &&cb_0B, &&cb_0C, &&cb_0D, &&cb_0E, &&cb_0F,
+                &&cb_10, &&cb_11, &&cb_12, &&cb_13, &&cb_14, &&cb_15, &&cb_16, &&cb_17,
+                &&cb_18, &&cb_19, &&cb_1A, &&cb_1B, &&cb_1C, &&cb_1D, &&cb_1E, &&cb_1F,
+                &&cb_20, &&cb_21, &&cb_22, &&cb_23, &&cb_24, &&cb_25, &&cb_26, &&cb_27,
+                &&cb_28, &&cb_29, &&cb_2A, &&cb_2B, &&cb_2C, &&cb_2D, &&cb_2E, &&cb_2F,
+                &&cb_30, &&cb_31, &&cb_32, &&cb_33, &&cb_34, &&cb_35, &&cb_36, &&cb_37,
+                &&cb_38, &&cb_39, &&cb_3A, &&cb_3B, &&cb_3C, &&cb_3D, &&cb_3E, &&cb_3F,
+                &&cb_40, &&cb_41, &&cb_42, &&cb_43, &&cb_44, &&cb_45, &&cb_46, &&cb_47,
+                &&cb_48, &&cb_49, &&cb_4A, &&cb_4B, &&cb_4C, &&cb_4D, &&cb_4E, &&cb_4F,
+                &&cb_50, &&cb_51, &&cb_52, &&cb_53, &&cb_54, &&cb_55, &&cb_56, &&cb_57,
+                &&cb_58, &&cb_59, &&cb_5A, &&cb_5B, &&cb_5C, &&cb_5D, &&cb_5E, &&cb_5F,
+                &&cb_60, &&cb_61, &&cb_62, &&cb_63, &&cb_64, &&cb_65, &&cb_66, &&cb_67,
+                &&cb_68, &&cb_69, &&cb_6A, &&cb_6B, &&cb_6C, &&cb_6D, &&cb_6E, &&cb_6F,
+                &&cb_70, &&cb_71, &&cb_72, &&cb_73, &&cb_74, &&cb_75, &&cb_76, &&cb_77,
+                &&cb_78, &&cb_79, &&cb_7A, &&cb_7B, &&cb_7C, &&cb_7D, &&cb_7E, &&cb_7F,
+                &&cb_80, &&cb_81, &&cb_82, &&cb_83, &&cb_84, &&cb_85, &&cb_86, &&cb_87,
+                &&cb_88, &&cb_89, &&cb_8A, &&cb_8B, &&cb_8C, &&cb_8D, &&cb_8E, &&cb_8F,
+                &&cb_90, &&cb_91, &&cb_92, &&cb_93, &&cb_94, &&cb_95, &&cb_96, &&cb_97,
+                &&cb_98, &&cb_99, &&cb_9A, &&cb_9B, &&cb_9C, &&cb_9D, &&cb_9E, &&cb_9F,
+                &&cb_A0, &&cb_A1, &&cb_A2, &&cb_A3, &&cb_A4, &&cb_A5, &&cb_A6, &&cb_A7,
+                &&cb_A8, &&cb_A9, &&cb_AA, &&cb_AB, &&cb_AC, &&cb_AD, &&cb_AE, &&cb_AF,
+                &&cb_B0, &&cb_B1, &&cb_B2, &&cb_B3, &&cb_B4, &&cb_B5, &&cb_B6, &&cb_B7,
+                &&cb_B8, &&cb_B9, &&cb_BA, &&cb_BB, &&cb_BC, &&cb_BD, &&cb_BE, &&cb_BF,
+                &&cb_C0, &&cb_C1, &&cb_C2, &&cb_C3, &&cb_C4, &&cb_C5, &&cb_C6, &&cb_C7,
+                &&cb_C8, &&cb_C9, &&cb_CA, &&cb_CB, &&cb_CC, &&cb_CD, &&cb_CE, &&cb_CF,
+                &&cb_D0, &&cb_D1, &&cb_D2, &&cb_D3, &&cb_D4, &&cb_D5, &&cb_D6, &&cb_D7,
+                &&cb_D8, &&cb_D9, &&cb_DA, &&cb_DB, &&cb_DC, &&cb_DD, &&cb_DE, &&cb_DF,
+                &&cb_E0, &&cb_E1, &&cb_E2, &&cb_E3, &&cb_E4, &&cb_E5, &&cb_E6, &&cb_E7,
+                &&cb_E8, &&cb_E9, &&cb_EA, &&cb_EB, &&cb_EC, &&cb_ED, &&cb_EE, &&cb_EF,
+                &&cb_F0, &&cb_F1, &&cb_F2, &&cb_F3, &&cb_F4, &&cb_F5, &&cb_F6, &&cb_F7,
+                &&cb_F8, &&cb_F9, &&cb_FA, &&cb_FB, &&cb_FC, &&cb_FD, &&cb_FE, &&cb_FF
+            };
+
+            static void* const dd_table[256] = {
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_09, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_19, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_21, &&dd_22, &&dd_23, &&dd_24, &&dd_25, &&dd_26, &&dd_default,
+                &&dd_default, &&dd_29, &&dd_2A, &&dd_2B, &&dd_2C, &&dd_2D, &&dd_2E, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_34, &&dd_35, &&dd_36, &&dd_default,
+                &&dd_default, &&dd_39, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_44, &&dd_45, &&dd_46, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_4C, &&dd_4D, &&dd_4E, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_54, &&dd_55, &&dd_56, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_5C, &&dd_5D, &&dd_5E, &&dd_default,
+                &&dd_60, &&dd_61, &&dd_62, &&dd_63, &&dd_64, &&dd_65, &&dd_66, &&dd_67,
+                &&dd_68, &&dd_69, &&dd_6A, &&dd_6B, &&dd_6C, &&dd_6D, &&dd_6E, &&dd_6F,
+                &&dd_70, &&dd_71, &&dd_72, &&dd_73, &&dd_74, &&dd_75, &&dd_default, &&dd_77,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_7C, &&dd_7D, &&dd_7E, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_84, &&dd_85, &&dd_86, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_8C, &&dd_8D, &&dd_8E, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_94, &&dd_95, &&dd_96, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_9C, &&dd_9D, &&dd_9E, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_A4, &&dd_A5, &&dd_A6, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_AC, &&dd_AD, &&dd_AE, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_B4, &&dd_B5, &&dd_B6, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_BC, &&dd_BD, &&dd_BE, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_CB, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_E1, &&dd_default, &&dd_E3, &&dd_default, &&dd_E5, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_E9, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default,
+                &&dd_default, &&dd_F9, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default, &&dd_default
+            };
+
+            static void* const ddcb_table[256] = {
+                &&ddcb_00, &&ddcb_01, &&ddcb_02, &&ddcb_03, &&ddcb_04, &&ddcb_05, &&ddcb_06, &&ddcb_07,
+                &&ddcb_08, &&ddcb_09, &&ddcb_0A, &&ddcb_0B, &&ddcb_0C, &&ddcb_0D, &&ddcb_0E, &&ddcb_0F,
+                &&ddcb_10, &&ddcb_11, &&ddcb_12, &&ddcb_13, &&ddcb_14, &&ddcb_15, &&ddcb_16, &&ddcb_17,
+                &&ddcb_18, &&ddcb_19, &&ddcb_1A, &&ddcb_1B, &&ddcb_1C, &&ddcb_1D, &&ddcb_1E, &&ddcb_1F,
+                &&ddcb_20, &&ddcb_21, &&ddcb_22, &&ddcb_23, &&ddcb_24, &&ddcb_25, &&ddcb_26, &&ddcb_27,
+                &&ddcb_28, &&ddcb_29, &&ddcb_2A, &&ddcb_2B, &&ddcb_2C, &&ddcb_2D, &&ddcb_2E, &&ddcb_2F,
+                &&ddcb_30, &&ddcb_31, &&ddcb_32, &&ddcb_33, &&ddcb_34, &&ddcb_35, &&ddcb_36, &&ddcb_37,
+                &&ddcb_38, &&ddcb_39, &&ddcb_3A, &&ddcb_3B, &&ddcb_3C, &&ddcb_3D, &&ddcb_3E, &&ddcb_3F,
+                &&ddcb_40, &&ddcb_41, &&ddcb_42, &&ddcb_43, &&ddcb_44, &&ddcb_45, &&ddcb_46, &&ddcb_47,
+                &&ddcb_48, &&ddcb_49, &&ddcb_4A, &&ddcb_4B, &&ddcb_4C, &&ddcb_4D, &&ddcb_4E, &&ddcb_4F,
+                &&ddcb_50, &&ddcb_51, &&ddcb_52, &&ddcb_53, &&ddcb_54, &&ddcb_55, &&ddcb_56, &&ddcb_57,
+                &&ddcb_58, &&ddcb_59, &&ddcb_5A, &&ddcb_5B, &&ddcb_5C, &&ddcb_5D, &&ddcb_5E, &&ddcb_5F,
+                &&ddcb_60, &&ddcb_61, &&ddcb_62, &&ddcb_63, &&ddcb_64, &&ddcb_65, &&ddcb_66, &&ddcb_67,
+                &&ddcb_68, &&ddcb_69, &&ddcb_6A, &&ddcb_6B, &&ddcb_6C, &&ddcb_6D, &&ddcb_6E, &&ddcb_6F,
+                &&ddcb_70, &&ddcb_71, &&ddcb_72, &&ddcb_73, &&ddcb_74, &&ddcb_75, &&ddcb_76, &&ddcb_77,
+                &&ddcb_78, &&ddcb_79, &&ddcb_7A, &&ddcb_7B, &&ddcb_7C, &&ddcb_7D, &&ddcb_7E, &&ddcb_7F,
+                &&ddcb_80, &&ddcb_81, &&ddcb_82, &&ddcb_83, &&ddcb_84, &&ddcb_85, &&ddcb_86, &&ddcb_87,
+                &&ddcb_88, &&ddcb_89, &&ddcb_8A, &&ddcb_8B, &&ddcb_8C, &&ddcb_8D, &&ddcb_8E, &&ddcb_8F,
+                &&ddcb_90, &&ddcb_91, &&ddcb_92, &&ddcb_93, &&ddcb_94, &&ddcb_95, &&ddcb_96, &&ddcb_97,
+                &&ddcb_98, &&ddcb_99, &&ddcb_9A, &&ddcb_9B, &&ddcb_9C, &&ddcb_9D, &&ddcb_9E, &&ddcb_9F,
+                &&ddcb_A0, &&ddcb_A1, &&ddcb_A2, &&ddcb_A3, &&ddcb_A4, &&ddcb_A5, &&ddcb_A6, &&ddcb_A7,
+                &&ddcb_A8, &&ddcb_A9, &&ddcb_AA, &&ddcb_AB, &&ddcb_AC, &&ddcb_AD, &&ddcb_AE, &&ddcb_AF,
+                &&ddcb_B0, &&ddcb_B1, &&ddcb_B2, &&ddcb_B3, &&ddcb_B4, &&ddcb_B5, &&ddcb_B6, &&ddcb_B7,
+                &&ddcb_B8, &&ddcb_B9, &&ddcb_BA, &&ddcb_BB, &&ddcb_BC, &&ddcb_BD, &&ddcb_BE, &&ddcb_BF,
+                &&ddcb_C0, &&ddcb_C1, &&ddcb_C2, &&ddcb_C3, &&ddcb_C4, &&ddcb_C5, &&ddcb_C6, &&ddcb_C7,
+                &&ddcb_C8, &&ddcb_C9, &&ddcb_CA, &&ddcb_CB, &&ddcb_CC, &&ddcb_CD, &&ddcb_CE, &&ddcb_CF,
+                &&ddcb_D0, &&ddcb_D1, &&ddcb_D2, &&ddcb_D3, &&ddcb_D4, &&ddcb_D5, &&ddcb_D6, &&ddcb_D7,
+                &&ddcb_D8, &&ddcb_D9, &&ddcb_DA, &&ddcb_DB, &&ddcb_DC, &&ddcb_DD, &&ddcb_DE, &&ddcb_DF,
+                &&ddcb_E0, &&ddcb_E1, &&ddcb_E2, &&ddcb_E3, &&ddcb_E4, &&ddcb_E5, &&ddcb_E6, &&ddcb_E7,
+                &&ddcb_E8, &&ddcb_E9, &&ddcb_EA, &&ddcb_EB, &&ddcb_EC, &&ddcb_ED, &&ddcb_EE, &&ddcb_EF,
+                &&ddcb_F0, &&ddcb_F1, &&ddcb_F2, &&ddcb_F3, &&ddcb_F4, &&ddcb_F5, &&ddcb_F6, &&ddcb_F7,
+                &&ddcb_F8, &&ddcb_F9, &&ddcb_FA, &&ddcb_FB, &&ddcb_FC, &&ddcb_FD, &&ddcb_FE, &&ddcb_FF
+            };
+
+            static void* const ed_table[256] = {
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_40, &&ed_41, &&ed_42, &&ed_43, &&ed_44, &&ed_45, &&ed_46, &&ed_47,
+                &&ed_48, &&ed_49, &&ed_4A, &&ed_4B, &&ed_4C, &&ed_4D, &&ed_default, &&ed_4F,
+                &&ed_50, &&ed_51, &&ed_52, &&ed_53, &&ed_54, &&ed_55, &&ed_56, &&ed_57,
+                &&ed_58, &&ed_59, &&ed_5A, &&ed_5B, &&ed_5C, &&ed_5D, &&ed_5E, &&ed_5F,
+                &&ed_60, &&ed_61, &&ed_62, &&ed_63, &&ed_64, &&ed_65, &&ed_default, &&ed_67,
+                &&ed_68, &&ed_69, &&ed_6A, &&ed_6B, &&ed_6C, &&ed_6D, &&ed_default, &&ed_6F,
+                &&ed_70, &&ed_71, &&ed_72, &&ed_73, &&ed_74, &&ed_75, &&ed_76, &&ed_default,
+                &&ed_78, &&ed_79, &&ed_7A, &&ed_7B, &&ed_7C, &&ed_7D, &&ed_7E, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_A0, &&ed_A1, &&ed_A2, &&ed_A3, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_A8, &&ed_A9, &&ed_AA, &&ed_AB, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_B0, &&ed_B1, &&ed_B2, &&ed_B3, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_B8, &&ed_B9, &&ed_BA, &&ed_BB, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default,
+                &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default, &&ed_default
+            };
+
+            static void* const fd_table[256] = {
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_09, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_19, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_21, &&fd_22, &&fd_23, &&fd_24, &&fd_25, &&fd_26, &&fd_default,
+                &&fd_default, &&fd_29, &&fd_2A, &&fd_2B, &&fd_2C, &&fd_2D, &&fd_2E, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_34, &&fd_35, &&fd_36, &&fd_default,
+                &&fd_default, &&fd_39, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_44, &&fd_45, &&fd_46, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_4C, &&fd_4D, &&fd_4E, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_54, &&fd_55, &&fd_56, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_5C, &&fd_5D, &&fd_5E, &&fd_default,
+                &&fd_60, &&fd_61, &&fd_62, &&fd_63, &&fd_64, &&fd_65, &&fd_66, &&fd_67,
+                &&fd_68, &&fd_69, &&fd_6A, &&fd_6B, &&fd_6C, &&fd_6D, &&fd_6E, &&fd_6F,
+                &&fd_70, &&fd_71, &&fd_72, &&fd_73, &&fd_74, &&fd_75, &&fd_default, &&fd_77,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_7C, &&fd_7D, &&fd_7E, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_84, &&fd_85, &&fd_86, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_8C, &&fd_8D, &&fd_8E, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_94, &&fd_95, &&fd_96, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_9C, &&fd_9D, &&fd_9E, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_A4, &&fd_A5, &&fd_A6, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_AC, &&fd_AD, &&fd_AE, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_B4, &&fd_B5, &&fd_B6, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_BC, &&fd_BD, &&fd_BE, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_CB, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_E1, &&fd_default, &&fd_E3, &&fd_default, &&fd_E5, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_E9, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default,
+                &&fd_default, &&fd_F9, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default, &&fd_default
+            };
+
+            static void* const fdcb_table[256] = {
+                &&fdcb_00, &&fdcb_01, &&fdcb_02, &&fdcb_03, &&fdcb_04, &&fdcb_05, &&fdcb_06, &&fdcb_07,
+                &&fdcb_08, &&fdcb_09, &&fdcb_0A, &&fdcb_0B, &&fdcb_0C, &&fdcb_0D, &&fdcb_0E, &&fdcb_0F,
+                &&fdcb_10, &&fdcb_11, &&fdcb_12, &&fdcb_13, &&fdcb_14, &&fdcb_15, &&fdcb_16, &&fdcb_17,
+                &&fdcb_18, &&fdcb_19, &&fdcb_1A, &&fdcb_1B, &&fdcb_1C, &&fdcb_1D, &&fdcb_1E, &&fdcb_1F,
+                &&fdcb_20, &&fdcb_21, &&fdcb_22, &&fdcb_23, &&fdcb_24, &&fdcb_25, &&fdcb_26, &&fdcb_27,
+                &&fdcb_28, &&fdcb_29, &&fdcb_2A, &&fdcb_2B, &&fdcb_2C, &&fdcb_2D, &&fdcb_2E, &&fdcb_2F,
+                &&fdcb_30, &&fdcb_31, &&fdcb_32, &&fdcb_33, &&fdcb_34, &&fdcb_35, &&fdcb_36, &&fdcb_37,
+                &&fdcb_38, &&fdcb_39, &&fdcb_3A, &&fdcb_3B, &&fdcb_3C, &&fdcb_3D, &&fdcb_3E, &&fdcb_3F,
+                &&fdcb_40, &&fdcb_41, &&fdcb_42, &&fdcb_43, &&fdcb_44, &&fdcb_45, &&fdcb_46, &&fdcb_47,
+                &&fdcb_48, &&fdcb_49, &&fdcb_4A, &&fdcb_4B, &&fdcb_4C, &&fdcb_4D, &&fdcb_4E, &&fdcb_4F,
+                &&fdcb_50, &&fdcb_51, &&fdcb_52, &&fdcb_53, &&fdcb_54, &&fdcb_55, &&fdcb_56, &&fdcb_57,
+                &&fdcb_58, &&fdcb_59, &&fdcb_5A, &&fdcb_5B, &&fdcb_5C, &&fdcb_5D, &&fdcb_5E, &&fdcb_5F,
+                &&fdcb_60, &&fdcb_61, &&fdcb_62, &&fdcb_63, &&fdcb_64, &&fdcb_65, &&fdcb_66, &&fdcb_67,
+                &&fdcb_68, &&fdcb_69, &&fdcb_6A, &&fdcb_6B, &&fdcb_6C, &&fdcb_6D, &&fdcb_6E, &&fdcb_6F,
+                &&fdcb_70, &&fdcb_71, &&fdcb_72, &&fdcb_73, &&fdcb_74, &&fdcb_75, &&fdcb_76, &&fdcb_77,
+                &&fdcb_78, &&fdcb_79, &&fdcb_7A, &&fdcb_7B, &&fdcb_7C, &&fdcb_7D, &&fdcb_7E, &&fdcb_7F,
+                &&fdcb_80, &&fdcb_81, &&fdcb_82, &&fdcb_83, &&fdcb_84, &&fdcb_85, &&fdcb_86, &&fdcb_87,
+                &&fdcb_88, &&fdcb_89, &&fdcb_8A, &&fdcb_8B, &&fdcb_8C, &&fdcb_8D, &&fdcb_8E, &&fdcb_8F,
+                &&fdcb_90, &&fdcb_91, &&fdcb_92, &&fdcb_93, &&fdcb_94, &&fdcb_95, &&fdcb_96, &&fdcb_97,
+                &&fdcb_98, &&fdcb_99, &&fdcb_9A, &&fdcb_9B, &&fdcb_9C, &&fdcb_9D, &&fdcb_9E, &&fdcb_9F,
+                &&fdcb_A0, &&fdcb_A1, &&fdcb_A2, &&fdcb_A3, &&fdcb_A4, &&fdcb_A5, &&fdcb_A6, &&fdcb_A7,
+                &&fdcb_A8, &&fdcb_A9, &&fdcb_AA, &&fdcb_AB, &&fdcb_AC, &&fdcb_AD, &&fdcb_AE, &&fdcb_AF,
+                &&fdcb_B0, &&fdcb_B1, &&fdcb_B2, &&fdcb_B3, &&fdcb_B4, &&fdcb_B5, &&fdcb_B6, &&fdcb_B7,
+                &&fdcb_B8, &&fdcb_B9, &&fdcb_BA, &&fdcb_BB, &&fdcb_BC, &&fdcb_BD, &&fdcb_BE, &&fdcb_BF,
+                &&fdcb_C0, &&fdcb_C1, &&fdcb_C2, &&fdcb_C3, &&fdcb_C4, &&fdcb_C5, &&fdcb_C6, &&fdcb_C7,
+                &&fdcb_C8, &&fdcb_C9, &&fdcb_CA, &&fdcb_CB, &&fdcb_CC, &&fdcb_CD, &&fdcb_CE, &&fdcb_CF,
+                &&fdcb_D0, &&fdcb_D1, &&fdcb_D2, &&fdcb_D3, &&fdcb_D4, &&fdcb_D5, &&fdcb_D6, &&fdcb_D7,
+                &&fdcb_D8, &&fdcb_D9, &&fdcb_DA, &&fdcb_DB, &&fdcb_DC, &&fdcb_DD, &&fdcb_DE, &&fdcb_DF,
+                &&fdcb_E0, &&fdcb_E1, &&fdcb_E2, &&fdcb_E3, &&fdcb_E4, &&fdcb_E5, &&fdcb_E6, &&fdcb_E7,
+                &&fdcb_E8, &&fdcb_E9, &&fdcb_EA, &&fdcb_EB, &&fdcb_EC, &&fdcb_ED, &&fdcb_EE, &&fdcb_EF,
+                &&fdcb_F0, &&fdcb_F1, &&fdcb_F2, &&fdcb_F3, &&fdcb_F4, &&fdcb_F5, &&fdcb_F6, &&fdcb_F7,
+                &&fdcb_F8, &&fdcb_F9, &&fdcb_FA, &&fdcb_FB, &&fdcb_FC, &&fdcb_FD, &&fdcb_FE, &&fdcb_FF
+            };
+#endif
+
             //Massive switch-case to decode the instructions!
+            RM_Z80_DISPATCH(main, opcode);
             switch(opcode) {
 
-                case 0x00: //NOP
+                case 0x00: RM_Z80_OP(main_00) //NOP
                            // Log("NOP");
-                break;
+                RM_Z80_NEXT;
 
                 /** LD rr, nn (excluding DD prefix) **/
-                case 0x01: //LD regs.BC, nn
+                case 0x01: RM_Z80_OP(main_01) //LD regs.BC, nn
                 regs.BC = PeekWord(regs.PC);
                 // Log(String.Format("LD regs.BC, {0,-6:X}", regs.BC));
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x11:  //LD regs.DE, nn
+                case 0x11: RM_Z80_OP(main_11)  //LD regs.DE, nn
                 regs.DE = PeekWord(regs.PC);
                 // Log(String.Format("LD regs.DE, {0,-6:X}", regs.DE));
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x21:  //LD regs.HL, nn
+                case 0x21: RM_Z80_OP(main_21)  //LD regs.HL, nn
                 regs.HL = PeekWord(regs.PC);
                 // Log(String.Format("LD regs.HL, {0,-6:X}", regs.HL));
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2A:  //LD regs.HL, (nn)
+                case 0x2A: RM_Z80_OP(main_2A)  //LD regs.HL, (nn)
                 {
                     ushort w = PeekWord(regs.PC);
                     regs.HL = PeekWord(w);
                     // Log(String.Format("LD regs.HL, ({0,-6:X})", disp));
                     regs.PC += 2;
                     regs.MemPtr = (ushort)(w + 1);
-                    break;
+                    RM_Z80_NEXT;
                 }
-                case 0x31:  //LD regs.SP, nn
+                case 0x31: RM_Z80_OP(main_31)  //LD regs.SP, nn
                 regs.SP = PeekWord(regs.PC);
                 // Log(String.Format("LD regs.SP, {0,-6:X}", regs.SP));
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF9:  //LD regs.SP, regs.HL
+                case 0xF9: RM_Z80_OP(main_F9)  //LD regs.SP, regs.HL
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 // Log("LD regs.SP, regs.HL");
                 regs.SP = regs.HL;
-                break;
+                RM_Z80_NEXT;
 
                 /** INC rr **/
-                case 0x03:  //INC regs.BC
+                case 0x03: RM_Z80_OP(main_03)  //INC regs.BC
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 // Log("INC regs.BC");
                 regs.BC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x13:  //INC regs.DE
+                case 0x13: RM_Z80_OP(main_13)  //INC regs.DE
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 // Log("INC regs.DE");
                 regs.DE++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x23:  //INC regs.HL
+                case 0x23: RM_Z80_OP(main_23)  //INC regs.HL
                             // if (model == MachineModel._plus3)
                             //     totalTStates += 2;
                             // else
                 Contend(regs.IR(), 1, 2);
                 // Log("INC regs.HL");
                 regs.HL++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x33:  //INC regs.SP
+                case 0x33: RM_Z80_OP(main_33)  //INC regs.SP
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 // Log("INC regs.SP");
                 regs.SP++;
-                break;
+                RM_Z80_NEXT;
 
                 /** INC r + INC (regs.HL) **/
-                case 0x04:  //INC B
+                case 0x04: RM_Z80_OP(main_04)  //INC B
                 regs.B = Inc(regs.B);
                 // Log("INC B");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x0C:  //INC C
+                case 0x0C: RM_Z80_OP(main_0C)  //INC C
                 regs.C = Inc(regs.C);
                 // Log("INC C");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x14:  //INC D
+                case 0x14: RM_Z80_OP(main_14)  //INC D
                 regs.D = Inc(regs.D);
                 // Log("INC D");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1C:  //INC E
+                case 0x1C: RM_Z80_OP(main_1C)  //INC E
                 regs.E = Inc(regs.E);
                 // Log("INC E");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x24:  //INC H
+                case 0x24: RM_Z80_OP(main_24)  //INC H
                 regs.H = Inc(regs.H);
                 // Log("INC H");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2C:  //INC L
+                case 0x2C: RM_Z80_OP(main_2C)  //INC L
                 regs.L = Inc(regs.L);
                 // Log("INC L");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x34:  //INC (regs.HL)
+                case 0x34: RM_Z80_OP(main_34)  //INC (regs.HL)
                 val = PeekByte(regs.HL);
                 val = Inc(val);
                 Contend(regs.HL, 1, 1);
                 PokeByte(regs.HL, val);
                 // Log("INC (regs.HL)");
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3C:  //INC A
+                case 0x3C: RM_Z80_OP(main_3C)  //INC A
                             // Log("INC A");
                 regs.A = Inc(regs.A);
-                break;
+                RM_Z80_NEXT;
 
                 /** DEC r + DEC (regs.HL)**/
-                case 0x05: //DEC B
+                case 0x05: RM_Z80_OP(main_05) //DEC B
                            // Log("DEC B");
                 regs.B = Dec(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x0D:    //DEC C
+                case 0x0D: RM_Z80_OP(main_0D)    //DEC C
                               // Log("DEC C");
                 regs.C = Dec(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x15:  //DEC D
+                case 0x15: RM_Z80_OP(main_15)  //DEC D
                             // Log("DEC D");
                 regs.D = Dec(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1D:  //DEC E
+                case 0x1D: RM_Z80_OP(main_1D)  //DEC E
                             // Log("DEC E");
                 regs.E = Dec(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x25:  //DEC H
+                case 0x25: RM_Z80_OP(main_25)  //DEC H
                             // Log("DEC H");
                 regs.H = Dec(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2D:  //DEC L
+                case 0x2D: RM_Z80_OP(main_2D)  //DEC L
                             // Log("DEC L");
                 regs.L = Dec(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x35:  //DEC (regs.HL)
+                case 0x35: RM_Z80_OP(main_35)  //DEC (regs.HL)
                             // Log("DEC (regs.HL)");
                             //val = PeekByte(regs.HL);
                 val = Dec(PeekByte(regs.HL));
                 Contend(regs.HL, 1, 1);
                 PokeByte(regs.HL, val);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3D:  //DEC A
+                case 0x3D: RM_Z80_OP(main_3D)  //DEC A
                             // Log("DEC A");
                 regs.A = Dec(regs.A);
              
                 TapeEdgeDecA();
-                break;
+                RM_Z80_NEXT;
 
                 /** DEC rr **/
-                case 0x0B:  //DEC regs.BC
+                case 0x0B: RM_Z80_OP(main_0B)  //DEC regs.BC
                             // Log("DEC regs.BC");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 regs.BC--;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1B:  //DEC regs.DE
+                case 0x1B: RM_Z80_OP(main_1B)  //DEC regs.DE
                             // Log("DEC regs.DE");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 regs.DE--;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2B:  //DEC regs.HL
+                case 0x2B: RM_Z80_OP(main_2B)  //DEC regs.HL
                             // Log("DEC regs.HL");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 regs.HL--;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3B:  //DEC regs.SP
+                case 0x3B: RM_Z80_OP(main_3B)  //DEC regs.SP
                             // Log("DEC regs.SP");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 2;
                             //else
                 Contend(regs.IR(), 1, 2);
                 regs.SP--;
-                break;
+                RM_Z80_NEXT;
 
                 /** LD (rr), r + LD (nn), regs.HL  + LD (nn), A **/
-                case 0x02: //LD (regs.BC), A
+                case 0x02: RM_Z80_OP(main_02) //LD (regs.BC), A
                            // Log("LD (regs.BC), A");
                 PokeByte(regs.BC, regs.A);
                 regs.MemPtr = (ushort)(((regs.BC + 1) & 0xff) | (regs.A << 8));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x12:  //LD (regs.DE), A
+                case 0x12: RM_Z80_OP(main_12)  //LD (regs.DE), A
                             // Log("LD (regs.DE), A");
                 PokeByte(regs.DE, regs.A);
                 regs.MemPtr = (ushort)(((regs.DE + 1) & 0xff) | (regs.A << 8));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x22:  //LD (nn), regs.HL
+                case 0x22: RM_Z80_OP(main_22)  //LD (nn), regs.HL
                 addr = PeekWord(regs.PC);
                 // Log(String.Format("LD ({0,-6:X}), regs.HL", addr));
 
                 PokeWord(addr, regs.HL);
                 regs.MemPtr = (ushort)(addr + 1);
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x32:  //LD (nn), A
+                case 0x32: RM_Z80_OP(main_32)  //LD (nn), A
                 addr = PeekWord(regs.PC);
                 // Log(String.Format("LD ({0,-6:X}), A", addr));
 
                 PokeByte(addr, regs.A);
                 regs.MemPtr = (ushort)(((addr + 1) & 0xff) | (regs.A << 8));
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x36:  //LD (regs.HL), n
+                case 0x36: RM_Z80_OP(main_36)  //LD (regs.HL), n
                 val = PeekByte(regs.PC);
                 // Log(String.Format("LD (regs.HL), {0,-6:X}", val));
 
                 PokeByte(regs.HL, val);
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
                 /** LD r, r **/
-                case 0x06: //LD B, n
+                case 0x06: RM_Z80_OP(main_06) //LD B, n
                 regs.B = PeekByte(regs.PC);
                 // Log(String.Format("LD B, {0,-6:X}", B));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x0A:  //LD A, (regs.BC)
+                case 0x0A: RM_Z80_OP(main_0A)  //LD A, (regs.BC)
                 regs.A = PeekByte(regs.BC);
                 regs.MemPtr = (ushort)(regs.BC + 1);
                 // Log("LD A, (regs.BC)");
 
-                break;
+                RM_Z80_NEXT;
 
-                case 0x0E:  //LD C, n
+                case 0x0E: RM_Z80_OP(main_0E)  //LD C, n
                 regs.C = PeekByte(regs.PC);
                 // Log(String.Format("LD C, {0,-6:X}", C));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x16:  //LD D,n
+                case 0x16: RM_Z80_OP(main_16)  //LD D,n
                 regs.D = PeekByte(regs.PC);
                 // Log(String.Format("LD D, {0,-6:X}", D));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1A:  //LD A,(regs.DE)
+                case 0x1A: RM_Z80_OP(main_1A)  //LD A,(regs.DE)
                             // Log("LD A, (regs.DE)");
                 regs.A = PeekByte(regs.DE);
                 regs.MemPtr = (ushort)(regs.DE + 1);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1E:  //LD E,n
+                case 0x1E: RM_Z80_OP(main_1E)  //LD E,n
                 regs.E = PeekByte(regs.PC);
                 // Log(String.Format("LD E, {0,-6:X}", E));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x26:  //LD H,n
+                case 0x26: RM_Z80_OP(main_26)  //LD H,n
                 regs.H = PeekByte(regs.PC);
                 // Log(String.Format("LD H, {0,-6:X}", H));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2E:  //LD L,n
+                case 0x2E: RM_Z80_OP(main_2E)  //LD L,n
                 regs.L = PeekByte(regs.PC);
                 // Log(String.Format("LD L, {0,-6:X}", L));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3A:  //LD A,(nn)
+                case 0x3A: RM_Z80_OP(main_3A)  //LD A,(nn)
                 addr = PeekWord(regs.PC);
                 // Log(String.Format("LD A, ({0,-6:X})", addr));
                 regs.MemPtr = (ushort)(addr + 1);
                 regs.A = PeekByte(addr);
                 regs.PC += 2;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3E:  //LD A,n
+                case 0x3E: RM_Z80_OP(main_3E)  //LD A,n
                 regs.A = PeekByte(regs.PC);
                 // Log(String.Format("LD A, {0,-6:X}", A));
 
                 regs.PC += 1;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x40:  //LD B,B
+                case 0x40: RM_Z80_OP(main_40)  //LD B,B
                             // Log("LD B, B");
                 //regs.B = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x41:  //LD B,C
+                case 0x41: RM_Z80_OP(main_41)  //LD B,C
                             // Log("LD B, C");
                 regs.B = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x42:  //LD B,D
+                case 0x42: RM_Z80_OP(main_42)  //LD B,D
                             // Log("LD B, D");
                 regs.B = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x43:  //LD B,E
+                case 0x43: RM_Z80_OP(main_43)  //LD B,E
                             // Log("LD B, E");
                 regs.B = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x44:  //LD B,H
+                case 0x44: RM_Z80_OP(main_44)  //LD B,H
                             // Log("LD B, H");
                 regs.B = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x45:  //LD B,L
+                case 0x45: RM_Z80_OP(main_45)  //LD B,L
                             // Log("LD B, L");
                 regs.B = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x46:  //LD B,(regs.HL)
+                case 0x46: RM_Z80_OP(main_46)  //LD B,(regs.HL)
                             // Log("LD B, (regs.HL)");
                 regs.B = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x47:  //LD B,A
+                case 0x47: RM_Z80_OP(main_47)  //LD B,A
                             // Log("LD B, A");
                 regs.B = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x48:  //LD C,B
+                case 0x48: RM_Z80_OP(main_48)  //LD C,B
                             // Log("LD C, B");
                 regs.C = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x49:  //LD C,C
+                case 0x49: RM_Z80_OP(main_49)  //LD C,C
                             // Log("LD C, C");
                 //C = C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4A:  //LD C,D
+                case 0x4A: RM_Z80_OP(main_4A)  //LD C,D
                             // Log("LD C, D");
                 regs.C = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4B:  //LD C,E
+                case 0x4B: RM_Z80_OP(main_4B)  //LD C,E
                             // Log("LD C, E");
                 regs.C = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4C:  //LD C,H
+                case 0x4C: RM_Z80_OP(main_4C)  //LD C,H
                             // Log("LD C, H");
                 regs.C = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4D:  //LD C,L
+                case 0x4D: RM_Z80_OP(main_4D)  //LD C,L
                             // Log("LD C, L");
                 regs.C = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4E:  //LD C, (regs.HL)
+                case 0x4E: RM_Z80_OP(main_4E)  //LD C, (regs.HL)
                             // Log("LD C, (regs.HL)");
                 regs.C = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x4F:  //LD C,A
+                case 0x4F: RM_Z80_OP(main_4F)  //LD C,A
                             // Log("LD C, A");
                 regs.C = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x50:  //LD D,B
+                case 0x50: RM_Z80_OP(main_50)  //LD D,B
                             // Log("LD D, B");
                 regs.D = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x51:  //LD D,C
+                case 0x51: RM_Z80_OP(main_51)  //LD D,C
                             // Log("LD D, C");
                 regs.D = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x52:  //LD D,D
+                case 0x52: RM_Z80_OP(main_52)  //LD D,D
                             // Log("LD D, D");
                 //regs.D = D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x53:  //LD D,E
+                case 0x53: RM_Z80_OP(main_53)  //LD D,E
                             // Log("LD D, E");
                 regs.D = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x54:  //LD D,H
+                case 0x54: RM_Z80_OP(main_54)  //LD D,H
                             // Log("LD D, H");
                 regs.D = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x55:  //LD D,L
+                case 0x55: RM_Z80_OP(main_55)  //LD D,L
                             // Log("LD D, L");
                 regs.D = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x56:  //LD D,(regs.HL)
+                case 0x56: RM_Z80_OP(main_56)  //LD D,(regs.HL)
                             // Log("LD D, (regs.HL)");
                 regs.D = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x57:  //LD D,A
+                case 0x57: RM_Z80_OP(main_57)  //LD D,A
                             // Log("LD D, A");
                 regs.D = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x58:  //LD E,B
+                case 0x58: RM_Z80_OP(main_58)  //LD E,B
                             // Log("LD E, B");
                 regs.E = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x59:  //LD E,C
+                case 0x59: RM_Z80_OP(main_59)  //LD E,C
                             // Log("LD E, C");
                 regs.E = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5A:  //LD E,D
+                case 0x5A: RM_Z80_OP(main_5A)  //LD E,D
                             // Log("LD E, D");
                 regs.E = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5B:  //LD E,E
+                case 0x5B: RM_Z80_OP(main_5B)  //LD E,E
                             // Log("LD E, E");
                 //regs.E = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5C:  //LD E,H
+                case 0x5C: RM_Z80_OP(main_5C)  //LD E,H
                             // Log("LD E, H");
                 regs.E = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5D:  //LD E,L
+                case 0x5D: RM_Z80_OP(main_5D)  //LD E,L
                             // Log("LD E, L");
                 regs.E = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5E:  //LD E,(regs.HL)
+                case 0x5E: RM_Z80_OP(main_5E)  //LD E,(regs.HL)
                             // Log("LD E, (regs.HL)");
                 regs.E = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x5F:  //LD E,A
+                case 0x5F: RM_Z80_OP(main_5F)  //LD E,A
                             // Log("LD E, A");
                 regs.E = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x60:  //LD H,B
+                case 0x60: RM_Z80_OP(main_60)  //LD H,B
                             // Log("LD H, B");
                 regs.H = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x61:  //LD H,C
+                case 0x61: RM_Z80_OP(main_61)  //LD H,C
                             // Log("LD H, C");
                 regs.H = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x62:  //LD H,D
+                case 0x62: RM_Z80_OP(main_62)  //LD H,D
                             // Log("LD H, D");
                 regs.H = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x63:  //LD H,E
+                case 0x63: RM_Z80_OP(main_63)  //LD H,E
                             // Log("LD H, E");
                 regs.H = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x64:  //LD H,H
+                case 0x64: RM_Z80_OP(main_64)  //LD H,H
                             // Log("LD H, H");
                 //regs.H = H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x65:  //LD H,L
+                case 0x65: RM_Z80_OP(main_65)  //LD H,L
                             // Log("LD H, L");
                 regs.H = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x66:  //LD H,(regs.HL)
+                case 0x66: RM_Z80_OP(main_66)  //LD H,(regs.HL)
                             // Log("LD H, (regs.HL)");
                 regs.H = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x67:  //LD H,A
+                case 0x67: RM_Z80_OP(main_67)  //LD H,A
                             // Log("LD H, A");
                 regs.H = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x68:  //LD L,B
+                case 0x68: RM_Z80_OP(main_68)  //LD L,B
                             // Log("LD L, B");
                 regs.L = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x69:  //LD L,C
+                case 0x69: RM_Z80_OP(main_69)  //LD L,C
                             // Log("LD L, C");
                 regs.L = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6A:  //LD L,D
+                case 0x6A: RM_Z80_OP(main_6A)  //LD L,D
                             // Log("LD L, D");
                 regs.L = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6B:  //LD L,E
+                case 0x6B: RM_Z80_OP(main_6B)  //LD L,E
                             // Log("LD L, E");
                 regs.L = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6C:  //LD L,H
+                case 0x6C: RM_Z80_OP(main_6C)  //LD L,H
                             // Log("LD L, H");
                 regs.L = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6D:  //LD L,L
+                case 0x6D: RM_Z80_OP(main_6D)  //LD L,L
                             // Log("LD L, L");
                 //regs.L = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6E:  //LD L,(regs.HL)
+                case 0x6E: RM_Z80_OP(main_6E)  //LD L,(regs.HL)
                             // Log("LD L, (regs.HL)");
                 regs.L = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x6F:  //LD L,A
+                case 0x6F: RM_Z80_OP(main_6F)  //LD L,A
                             // Log("LD L, A");
                 regs.L = regs.A;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x70:  //LD (regs.HL),B
+                case 0x70: RM_Z80_OP(main_70)  //LD (regs.HL),B
                             // Log("LD (regs.HL), B");
                 PokeByte(regs.HL, regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x71:  //LD (regs.HL),C
+                case 0x71: RM_Z80_OP(main_71)  //LD (regs.HL),C
                             // Log("LD (regs.HL), C");
                 PokeByte(regs.HL, regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x72:  //LD (regs.HL),D
+                case 0x72: RM_Z80_OP(main_72)  //LD (regs.HL),D
                             // Log("LD (regs.HL), D");
                 PokeByte(regs.HL, regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x73:  //LD (regs.HL),E
+                case 0x73: RM_Z80_OP(main_73)  //LD (regs.HL),E
                             // Log("LD (regs.HL), E");
                 PokeByte(regs.HL, regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x74:  //LD (regs.HL),H
+                case 0x74: RM_Z80_OP(main_74)  //LD (regs.HL),H
                             // Log("LD (regs.HL), H");
                 PokeByte(regs.HL, regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x75:  //LD (regs.HL),L
+                case 0x75: RM_Z80_OP(main_75)  //LD (regs.HL),L
                             // Log("LD (regs.HL), L");
                 PokeByte(regs.HL, regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x77:  //LD (regs.HL),A
+                case 0x77: RM_Z80_OP(main_77)  //LD (regs.HL),A
                             // Log("LD (regs.HL), A");
                 PokeByte(regs.HL, regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x78:  //LD A,B
+                case 0x78: RM_Z80_OP(main_78)  //LD A,B
                             // Log("LD A, B");
                 regs.A = regs.B;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x79:  //LD A,C
+                case 0x79: RM_Z80_OP(main_79)  //LD A,C
                             // Log("LD A, C");
                 regs.A = regs.C;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7A:  //LD A,D
+                case 0x7A: RM_Z80_OP(main_7A)  //LD A,D
                             // Log("LD A, D");
                 regs.A = regs.D;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7B:  //LD A,E
+                case 0x7B: RM_Z80_OP(main_7B)  //LD A,E
                             // Log("LD A, E");
                 regs.A = regs.E;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7C:  //LD A,H
+                case 0x7C: RM_Z80_OP(main_7C)  //LD A,H
                             // Log("LD A, H");
                 regs.A = regs.H;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7D:  //LD A,L
+                case 0x7D: RM_Z80_OP(main_7D)  //LD A,L
                             // Log("LD A, L");
                 regs.A = regs.L;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7E:  //LD A,(regs.HL)
+                case 0x7E: RM_Z80_OP(main_7E)  //LD A,(regs.HL)
                             // Log("LD A, (regs.HL)");
                 regs.A = PeekByte(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x7F:  //LD A,A
+                case 0x7F: RM_Z80_OP(main_7F)  //LD A,A
                             // Log("LD A, A");
                 //regs.A = regs.A;
-                break;
+                RM_Z80_NEXT;
 
                 /** Accumulator Rotates **/
-                case 0x07: //RLCA
+                case 0x07: RM_Z80_OP(main_07) //RLCA
                            // Log("RLCA");
                 ac = (regs.A & BIT_F_SIGN) != 0; //save the msb bit
 
@@ -1338,9 +1981,9 @@ namespace rm {
                 SetCarry(ac);
                 SetHalf(false);
                 SetNeg(false);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x0F:  //RRCA
+                case 0x0F: RM_Z80_OP(main_0F)  //RRCA
                             // Log("RRCA");
 
                 ac = (regs.A & BIT_F_CARRY) != 0; //save the lsb bit
@@ -1357,9 +2000,9 @@ namespace rm {
                 SetCarry(ac);
                 SetHalf(false);
                 SetNeg(false);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x17:  //RLA
+                case 0x17: RM_Z80_OP(main_17)  //RLA
                             // Log("RLA");
                 ac = ((regs.A & BIT_F_SIGN) != 0);
 
@@ -1376,9 +2019,9 @@ namespace rm {
                 SetCarry(ac);
                 SetHalf(false);
                 SetNeg(false);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x1F:  //RRA
+                case 0x1F: RM_Z80_OP(main_1F)  //RRA
                             // Log("RRA");
                 ac = (regs.A & BIT_F_CARRY) != 0; //save the lsb bit
                 lsb = regs.F & BIT_F_CARRY;
@@ -1394,21 +2037,21 @@ namespace rm {
                 SetCarry(ac);
                 SetHalf(false);
                 SetNeg(false);
-                break;
+                RM_Z80_NEXT;
 
                 /** Exchange operations **/
-                case 0x08:     //EX regs.AF, regs.AF'
+                case 0x08: RM_Z80_OP(main_08)     //EX regs.AF, regs.AF'
                                // Log("EX regs.AF, regs.AF'");
                 ex_af_af();
                 regs.modified_F = false;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD9:   //EXX
+                case 0xD9: RM_Z80_OP(main_D9)   //EXX
                              // Log("EXX");
                 exx();
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE3:  //EX (regs.SP), regs.HL
+                case 0xE3: RM_Z80_OP(main_E3)  //EX (regs.SP), regs.HL
                             // Log("EX (regs.SP), regs.HL");
                             //int temp = regs.HL;
                 addr = PeekWord(regs.SP);
@@ -1418,17 +2061,17 @@ namespace rm {
                 Contend(regs.SP, 1, 2);
                 regs.HL = addr;
                 regs.MemPtr = regs.HL;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xEB:  //EX regs.DE, regs.HL
+                case 0xEB: RM_Z80_OP(main_EB)  //EX regs.DE, regs.HL
                             // Log("EX regs.DE, regs.HL");
                 temp = regs.DE;
                 regs.DE = regs.HL;
                 regs.HL = temp;
-                break;
+                RM_Z80_NEXT;
 
                 /** Add regs.HL, rr **/
-                case 0x09:     //ADD regs.HL, regs.BC
+                case 0x09: RM_Z80_OP(main_09)     //ADD regs.HL, regs.BC
                                // Log("ADD regs.HL, regs.BC");
                                //if (model == MachineModel._plus3)
                                //    totalTStates += 7;
@@ -1438,9 +2081,9 @@ namespace rm {
                 regs.MemPtr = (ushort)(regs.HL + 1);
                 regs.HL = Add_RR(regs.HL, regs.BC);
 
-                break;
+                RM_Z80_NEXT;
 
-                case 0x19:    //ADD regs.HL, regs.DE
+                case 0x19: RM_Z80_OP(main_19)    //ADD regs.HL, regs.DE
                               // Log("ADD regs.HL, regs.DE");
                               //if (model == MachineModel._plus3)
                               //    totalTStates += 7;
@@ -1449,9 +2092,9 @@ namespace rm {
                 regs.MemPtr = (ushort)(regs.HL + 1);
                 regs.HL = Add_RR(regs.HL, regs.DE);
 
-                break;
+                RM_Z80_NEXT;
 
-                case 0x29:  //ADD regs.HL, regs.HL
+                case 0x29: RM_Z80_OP(main_29)  //ADD regs.HL, regs.HL
                             // Log("ADD regs.HL, regs.HL");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 7;
@@ -1459,9 +2102,9 @@ namespace rm {
                 Contend(regs.IR(), 1, 7);
                 regs.MemPtr = (ushort)(regs.HL + 1);
                 regs.HL = Add_RR(regs.HL, regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x39:  //ADD regs.HL, regs.SP
+                case 0x39: RM_Z80_OP(main_39)  //ADD regs.HL, regs.SP
                             // Log("ADD regs.HL, regs.SP");
                             //if (model == MachineModel._plus3)
                             //    totalTStates += 7;
@@ -1469,208 +2112,208 @@ namespace rm {
                 Contend(regs.IR(), 1, 7);
                 regs.MemPtr = (ushort)(regs.HL + 1);
                 regs.HL = Add_RR(regs.HL, regs.SP);
-                break;
+                RM_Z80_NEXT;
 
                 /*** ADD r, r ***/
-                case 0x80:  //ADD A,B
+                case 0x80: RM_Z80_OP(main_80)  //ADD A,B
                             // Log("ADD A, B");
                 Add_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x81:  //ADD A,C
+                case 0x81: RM_Z80_OP(main_81)  //ADD A,C
                             // Log("ADD A, C");
                 Add_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x82:  //ADD A,D
+                case 0x82: RM_Z80_OP(main_82)  //ADD A,D
                             // Log("ADD A, D");
                 Add_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x83:  //ADD A,E
+                case 0x83: RM_Z80_OP(main_83)  //ADD A,E
                             // Log("ADD A, E");
                 Add_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x84:  //ADD A,H
+                case 0x84: RM_Z80_OP(main_84)  //ADD A,H
                             // Log("ADD A, H");
                 Add_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x85:  //ADD A,L
+                case 0x85: RM_Z80_OP(main_85)  //ADD A,L
                             // Log("ADD A, L");
                 Add_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x86:  //ADD A, (regs.HL)
+                case 0x86: RM_Z80_OP(main_86)  //ADD A, (regs.HL)
                             // Log("ADD A, (regs.HL)");
                 Add_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x87:  //ADD A, A
+                case 0x87: RM_Z80_OP(main_87)  //ADD A, A
                             // Log("ADD A, A");
                 Add_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC6:  //ADD A, n
+                case 0xC6: RM_Z80_OP(main_C6)  //ADD A, n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("ADD A, {0,-6:X}", disp));
                     Add_R(b);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
                 /** Adc a, r **/
-                case 0x88:  //ADC A,B
+                case 0x88: RM_Z80_OP(main_88)  //ADC A,B
                             // Log("ADC A, B");
                 Adc_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x89:  //ADC A,C
+                case 0x89: RM_Z80_OP(main_89)  //ADC A,C
                             // Log("ADC A, C");
                 Adc_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8A:  //ADC A,D
+                case 0x8A: RM_Z80_OP(main_8A)  //ADC A,D
                             // Log("ADC A, D");
                 Adc_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8B:  //ADC A,E
+                case 0x8B: RM_Z80_OP(main_8B)  //ADC A,E
                             // Log("ADC A, E");
                 Adc_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8C:  //ADC A,H
+                case 0x8C: RM_Z80_OP(main_8C)  //ADC A,H
                             // Log("ADC A, H");
                 Adc_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8D:  //ADC A,L
+                case 0x8D: RM_Z80_OP(main_8D)  //ADC A,L
                             // Log("ADC A, L");
                 Adc_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8E:  //ADC A,(regs.HL)
+                case 0x8E: RM_Z80_OP(main_8E)  //ADC A,(regs.HL)
                             // Log("ADC A, (regs.HL)");
                 Adc_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x8F:  //ADC A,A
+                case 0x8F: RM_Z80_OP(main_8F)  //ADC A,A
                             // Log("ADC A, A");
                 Adc_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCE:  //ADC A, n
+                case 0xCE: RM_Z80_OP(main_CE)  //ADC A, n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("ADC A, {0,-6:X}", disp));
                     Adc_R(b);
                     regs.PC += 1;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
-                case 0x90:  //SUB B
+                case 0x90: RM_Z80_OP(main_90)  //SUB B
                             // Log("SUB B");
                 Sub_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x91:  //SUB C
+                case 0x91: RM_Z80_OP(main_91)  //SUB C
                             // Log("SUB C");
                 Sub_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x92:  //SUB D
+                case 0x92: RM_Z80_OP(main_92)  //SUB D
                             // Log("SUB D");
                 Sub_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x93:  //SUB E
+                case 0x93: RM_Z80_OP(main_93)  //SUB E
                             // Log("SUB E");
                 Sub_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x94:  //SUB H
+                case 0x94: RM_Z80_OP(main_94)  //SUB H
                             // Log("SUB H");
                 Sub_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x95:  //SUB L
+                case 0x95: RM_Z80_OP(main_95)  //SUB L
                             // Log("SUB L");
                 Sub_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x96:  //SUB (regs.HL)
+                case 0x96: RM_Z80_OP(main_96)  //SUB (regs.HL)
                             // Log("SUB (regs.HL)");
                 Sub_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x97:  //SUB A
+                case 0x97: RM_Z80_OP(main_97)  //SUB A
                             // Log("SUB A");
                 Sub_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD6:  //SUB n
+                case 0xD6: RM_Z80_OP(main_D6)  //SUB n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("SUB {0,-6:X}", disp));
                     Sub_R(b);
                     regs.PC += 1;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
-                case 0x98:  //SBC A, B
+                case 0x98: RM_Z80_OP(main_98)  //SBC A, B
                             // Log("SBC A, B");
                 Sbc_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x99:  //SBC A, C
+                case 0x99: RM_Z80_OP(main_99)  //SBC A, C
                             // Log("SBC A, C");
                 Sbc_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9A:  //SBC A, D
+                case 0x9A: RM_Z80_OP(main_9A)  //SBC A, D
                             // Log("SBC A, D");
                 Sbc_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9B:  //SBC A, E
+                case 0x9B: RM_Z80_OP(main_9B)  //SBC A, E
                             // Log("SBC A, E");
                 Sbc_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9C:  //SBC A, H
+                case 0x9C: RM_Z80_OP(main_9C)  //SBC A, H
                             // Log("SBC A, H");
                 Sbc_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9D:  //SBC A, L
+                case 0x9D: RM_Z80_OP(main_9D)  //SBC A, L
                             // Log("SBC A, L");
                 Sbc_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9E:  //SBC A, (regs.HL)
+                case 0x9E: RM_Z80_OP(main_9E)  //SBC A, (regs.HL)
                             // Log("SBC A, (regs.HL)");
                 Sbc_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0x9F:  //SBC A, A
+                case 0x9F: RM_Z80_OP(main_9F)  //SBC A, A
                             // Log("SBC A, A");
                 Sbc_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDE:  //SBC A, n
+                case 0xDE: RM_Z80_OP(main_DE)  //SBC A, n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("SBC A, {0,-6:X}", disp));
                     Sbc_R(b);
                     regs.PC += 1;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
                 /*** Relative Jumps ***/
-                case 0x10:  //DJNZ n
+                case 0x10: RM_Z80_OP(main_10)  //DJNZ n
                 Contend(regs.IR(), 1, 1);
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("DJNZ {0,-6:X}", regs.PC + disp + 1));
@@ -1682,18 +2325,18 @@ namespace rm {
                 }
                 regs.PC++;
 
-                break;
+                RM_Z80_NEXT;
 
-                case 0x18:  //JR n
+                case 0x18: RM_Z80_OP(main_18)  //JR n
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("JR {0,-6:X}", regs.PC + disp + 1));
                 Contend(regs.PC, 1, 5);
                 regs.PC = (ushort)(regs.PC + disp);
                 regs.PC++;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x20:  //JRNZ n
+                case 0x20: RM_Z80_OP(main_20)  //JRNZ n
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("JR NZ, {0,-6:X}", regs.PC + disp + 1));
                 if((regs.F & BIT_F_ZERO) == 0) {
@@ -1702,9 +2345,9 @@ namespace rm {
                     regs.MemPtr = (ushort)(regs.PC + 1);
                 }
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x28:  //JRZ n
+                case 0x28: RM_Z80_OP(main_28)  //JRZ n
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("JR Z, {0,-6:X}", regs.PC + disp + 1));
 
@@ -1714,9 +2357,9 @@ namespace rm {
                     regs.MemPtr = (ushort)(regs.PC + 1);
                 }
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x30:  //JRNC n
+                case 0x30: RM_Z80_OP(main_30)  //JRNC n
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("JR NC, {0,-6:X}", regs.PC + disp + 1));
 
@@ -1726,9 +2369,9 @@ namespace rm {
                     regs.MemPtr = (ushort)(regs.PC + 1);
                 }
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x38:  //JRC n
+                case 0x38: RM_Z80_OP(main_38)  //JRC n
                 disp = GetDisplacement(PeekByte(regs.PC));
                 // Log(String.Format("JR C, {0,-6:X}", regs.PC + disp + 1));
 
@@ -1738,10 +2381,10 @@ namespace rm {
                     regs.MemPtr = (ushort)(regs.PC + 1);
                 }
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
                 /*** Direct jumps ***/
-                case 0xC2:  //JPNZ nn
+                case 0xC2: RM_Z80_OP(main_C2)  //JPNZ nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP NZ, {0,-6:X}", disp));
                 if((regs.F & BIT_F_ZERO) == 0) {
@@ -1751,16 +2394,16 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC3:  //JP nn
+                case 0xC3: RM_Z80_OP(main_C3)  //JP nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP {0,-6:X}", disp));
                 regs.PC = (ushort)disp;
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCA:  //JPZ nn
+                case 0xCA: RM_Z80_OP(main_CA)  //JPZ nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP Z, {0,-6:X}", disp));
                 if((regs.F & BIT_F_ZERO) != 0) {
@@ -1770,9 +2413,9 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD2:  //JPNC nn
+                case 0xD2: RM_Z80_OP(main_D2)  //JPNC nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP NC, {0,-6:X}", disp));
                 if((regs.F & BIT_F_CARRY) == 0) {
@@ -1782,9 +2425,9 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDA:  //JPC nn
+                case 0xDA: RM_Z80_OP(main_DA)  //JPC nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP C, {0,-6:X}", disp));
                 if((regs.F & BIT_F_CARRY) != 0) {
@@ -1794,9 +2437,9 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE2:  //JP PO nn
+                case 0xE2: RM_Z80_OP(main_E2)  //JP PO nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP PO, {0,-6:X}", disp));
                 if((regs.F & BIT_F_PARITY) == 0) {
@@ -1806,16 +2449,16 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE9:  //JP (regs.HL)
+                case 0xE9: RM_Z80_OP(main_E9)  //JP (regs.HL)
                             // Log("JP (regs.HL)");
                             //regs.PC = PeekWord(regs.HL);
                 regs.PC = regs.HL;
                 //  regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xEA:  //JP PE nn
+                case 0xEA: RM_Z80_OP(main_EA)  //JP PE nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP PE, {0,-6:X}", disp));
                 if((regs.F & BIT_F_PARITY) != 0) {
@@ -1825,9 +2468,9 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF2:  //JP P nn
+                case 0xF2: RM_Z80_OP(main_F2)  //JP P nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP P, {0,-6:X}", disp));
                 if((regs.F & BIT_F_SIGN) == 0) {
@@ -1837,9 +2480,9 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFA:  //JP M nn
+                case 0xFA: RM_Z80_OP(main_FA)  //JP M nn
                 disp = PeekWord(regs.PC);
                 // Log(String.Format("JP M, {0,-6:X}", disp));
                 if((regs.F & BIT_F_SIGN) != 0) {
@@ -1849,46 +2492,46 @@ namespace rm {
                     regs.PC += 2;
                 }
                 regs.MemPtr = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
                 /*** Compare instructions **/
-                case 0xB8:  //CP B
+                case 0xB8: RM_Z80_OP(main_B8)  //CP B
                             // Log("CP B");
                 Cp_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB9:  //CP C
+                case 0xB9: RM_Z80_OP(main_B9)  //CP C
                             // Log("CP C");
                 Cp_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBA:  //CP D
+                case 0xBA: RM_Z80_OP(main_BA)  //CP D
                             // Log("CP D");
                 Cp_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBB:  //CP E
+                case 0xBB: RM_Z80_OP(main_BB)  //CP E
                             // Log("CP E");
                 Cp_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBC:  //CP H
+                case 0xBC: RM_Z80_OP(main_BC)  //CP H
                             // Log("CP H");
                 Cp_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBD:  //CP L
+                case 0xBD: RM_Z80_OP(main_BD)  //CP L
                             // Log("CP L");
                 Cp_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBE:  //CP (regs.HL)
+                case 0xBE: RM_Z80_OP(main_BE)  //CP (regs.HL)
                             // Log("CP (regs.HL)");
                 val = PeekByte(regs.HL);
                 Cp_R(val);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xBF:  //CP A
+                case 0xBF: RM_Z80_OP(main_BF)  //CP A
                             // Log("CP A");
                 Cp_R(regs.A);
                 TapeEdgeCpA();
@@ -1896,19 +2539,19 @@ namespace rm {
                 //if(tape_readToPlay && !tapeTrapsDisabled)
                 //    if(regs.PC == 0x56b)
                 //        FlashLoadTape();
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFE:  //CP n
+                case 0xFE: RM_Z80_OP(main_FE)  //CP n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format(String.Format("CP {0,-6:X}", disp)));
                     Cp_R(b);
                     regs.PC += 1;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
                 /*** Carry Flag operations ***/
-                case 0x37:  //SCF
+                case 0x37: RM_Z80_OP(main_37)  //SCF
                 {
                     // Log("SCF");
                     //Undocumented SCF behaviour:
@@ -1918,12 +2561,12 @@ namespace rm {
                     //            | (regs.A & (BIT_F_3 | BIT_F_5)) | BIT_F_CARRY);
 
                     regs.F = (byte)((regs.F & (BIT_F_PARITY | BIT_F_ZERO | BIT_F_SIGN))
-                                | ((regs.Q | (regs.A & (BIT_F_3 | BIT_F_5))) | BIT_F_CARRY));
+                                | ((GetQ() | (regs.A & (BIT_F_3 | BIT_F_5))) | BIT_F_CARRY));
                     regs.modified_F = true;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0x3F:  //CCF
+                case 0x3F: RM_Z80_OP(main_3F)  //CCF
                 {
                         // Log("CCF");
                         //Undocumented SCF behaviour:
@@ -1934,284 +2577,284 @@ namespace rm {
 
                         regs.F = (byte)((regs.F & (BIT_F_PARITY | BIT_F_ZERO | BIT_F_SIGN))
                                     | ((regs.F & BIT_F_CARRY) != 0 ? BIT_F_HALF : BIT_F_CARRY)
-                                    | (regs.Q | (regs.A & (BIT_F_3 | BIT_F_5))));
+                                    | (GetQ() | (regs.A & (BIT_F_3 | BIT_F_5))));
                         regs.modified_F = true;
                     }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA0:  //AND B
+                case 0xA0: RM_Z80_OP(main_A0)  //AND B
                             // Log("AND B");
                 And_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA1:  //AND C
+                case 0xA1: RM_Z80_OP(main_A1)  //AND C
                             // Log("AND C");
                 And_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA2:  //AND D
+                case 0xA2: RM_Z80_OP(main_A2)  //AND D
                             // Log("AND D");
                 And_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA3:  //AND E
+                case 0xA3: RM_Z80_OP(main_A3)  //AND E
                             // Log("AND E");
                 And_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA4:  //AND H
+                case 0xA4: RM_Z80_OP(main_A4)  //AND H
                             // Log("AND H");
                 And_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA5:  //AND L
+                case 0xA5: RM_Z80_OP(main_A5)  //AND L
                             // Log("AND L");
                 And_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA6:  //AND (regs.HL)
+                case 0xA6: RM_Z80_OP(main_A6)  //AND (regs.HL)
                             // Log("AND (regs.HL)");
                 And_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA7:  //AND A
+                case 0xA7: RM_Z80_OP(main_A7)  //AND A
                             // Log("AND A");
                 And_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE6:  //AND n
+                case 0xE6: RM_Z80_OP(main_E6)  //AND n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("AND {0,-6:X}", disp));
                     And_R(b);
 
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
                 }
                 
-                case 0xA8: //XOR B
+                case 0xA8: RM_Z80_OP(main_A8) //XOR B
                            // Log("XOR B");
                 Xor_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xA9: //XOR C
+                case 0xA9: RM_Z80_OP(main_A9) //XOR C
                            // Log("XOR C");
                 Xor_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAA: //XOR D
+                case 0xAA: RM_Z80_OP(main_AA) //XOR D
                            // Log("XOR D");
                 Xor_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAB: //XOR E
+                case 0xAB: RM_Z80_OP(main_AB) //XOR E
                            // Log("XOR E");
                 Xor_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAC: //XOR H
+                case 0xAC: RM_Z80_OP(main_AC) //XOR H
                            // Log("XOR H");
                 Xor_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAD: //XOR L
+                case 0xAD: RM_Z80_OP(main_AD) //XOR L
                            // Log("XOR L");
                 Xor_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAE: //XOR (regs.HL)
+                case 0xAE: RM_Z80_OP(main_AE) //XOR (regs.HL)
                            // Log("XOR (regs.HL)");
                 Xor_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0xAF: //XOR A
+                case 0xAF: RM_Z80_OP(main_AF) //XOR A
                            // Log("XOR A");
                 Xor_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xEE:  //XOR n
+                case 0xEE: RM_Z80_OP(main_EE)  //XOR n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("XOR {0,-6:X}", disp));
                     Xor_R(b);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
-                case 0xB0:  //OR B
+                case 0xB0: RM_Z80_OP(main_B0)  //OR B
                             // Log("OR B");
                 Or_R(regs.B);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB1:  //OR C
+                case 0xB1: RM_Z80_OP(main_B1)  //OR C
                             // Log("OR C");
                 Or_R(regs.C);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB2:  //OR D
+                case 0xB2: RM_Z80_OP(main_B2)  //OR D
                             // Log("OR D");
                 Or_R(regs.D);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB3:  //OR E
+                case 0xB3: RM_Z80_OP(main_B3)  //OR E
                             // Log("OR E");
                 Or_R(regs.E);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB4:  //OR H
+                case 0xB4: RM_Z80_OP(main_B4)  //OR H
                             // Log("OR H");
                 Or_R(regs.H);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB5:  //OR L
+                case 0xB5: RM_Z80_OP(main_B5)  //OR L
                             // Log("OR L");
                 Or_R(regs.L);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB6:  //OR (regs.HL)
+                case 0xB6: RM_Z80_OP(main_B6)  //OR (regs.HL)
                             // Log("OR (regs.HL)");
                 Or_R(PeekByte(regs.HL));
-                break;
+                RM_Z80_NEXT;
 
-                case 0xB7:  //OR A
+                case 0xB7: RM_Z80_OP(main_B7)  //OR A
                             // Log("OR A");
                 Or_R(regs.A);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF6:  //OR n
+                case 0xF6: RM_Z80_OP(main_F6)  //OR n
                 {
                     byte b = PeekByte(regs.PC);
                     // Log(String.Format("OR {0,-6:X}", disp));
                     Or_R(b);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
                 }
 
-                case 0xC0:  //RET NZ
+                case 0xC0: RM_Z80_OP(main_C0)  //RET NZ
                             // Log("RET NZ");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_ZERO) == 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC8:  //RET Z
+                case 0xC8: RM_Z80_OP(main_C8)  //RET Z
                             // Log("RET Z");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_ZERO) != 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC9:  //RET
+                case 0xC9: RM_Z80_OP(main_C9)  //RET
                             // Log("RET");
                 regs.PC = PopStack();
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD0:  //RET NC
+                case 0xD0: RM_Z80_OP(main_D0)  //RET NC
                             // Log("RET NC");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_CARRY) == 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD8:  //RET C
+                case 0xD8: RM_Z80_OP(main_D8)  //RET C
                             // Log("RET C");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_CARRY) != 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE0:  //RET PO
+                case 0xE0: RM_Z80_OP(main_E0)  //RET PO
                             // Log("RET PO");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_PARITY) == 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE8:  //RET PE
+                case 0xE8: RM_Z80_OP(main_E8)  //RET PE
                             // Log("RET PE");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_PARITY) != 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF0:  //RET P
+                case 0xF0: RM_Z80_OP(main_F0)  //RET P
                             // Log("RET P");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_SIGN) == 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF8:  //RET M
+                case 0xF8: RM_Z80_OP(main_F8)  //RET M
                             // Log("RET M");
                 Contend(regs.IR(), 1, 1);
                 if((regs.F & BIT_F_SIGN) != 0) {
                     regs.PC = PopStack();
                     regs.MemPtr = regs.PC;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC1:  //POP regs.BC
+                case 0xC1: RM_Z80_OP(main_C1)  //POP regs.BC
                             // Log("POP regs.BC");
                 regs.BC = PopStack();
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC5:  //PUSH regs.BC
+                case 0xC5: RM_Z80_OP(main_C5)  //PUSH regs.BC
                             // Log("PUSH regs.BC");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.BC);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD1:  //POP regs.DE
+                case 0xD1: RM_Z80_OP(main_D1)  //POP regs.DE
                             // Log("POP regs.DE");
 
                 regs.DE = PopStack();
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD5:  //PUSH regs.DE
+                case 0xD5: RM_Z80_OP(main_D5)  //PUSH regs.DE
                             // Log("PUSH regs.DE");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.DE);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE1:  //POP regs.HL
+                case 0xE1: RM_Z80_OP(main_E1)  //POP regs.HL
                             // Log("POP regs.HL");
                 regs.HL = PopStack();
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE5:  //PUSH regs.HL
+                case 0xE5: RM_Z80_OP(main_E5)  //PUSH regs.HL
                             // Log("PUSH regs.HL");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.HL);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF1:  //POP regs.AF
+                case 0xF1: RM_Z80_OP(main_F1)  //POP regs.AF
                             // Log("POP regs.AF");
                 regs.AF = PopStack();
                 regs.modified_F = false;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF5:  //PUSH regs.AF
+                case 0xF5: RM_Z80_OP(main_F5)  //PUSH regs.AF
                             // Log("PUSH regs.AF");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.AF);
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC4:  //CALL NZ, nn
+                case 0xC4: RM_Z80_OP(main_C4)  //CALL NZ, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL NZ, {0,-6:X}", disp));
@@ -2223,9 +2866,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCC:  //CALL Z, nn
+                case 0xCC: RM_Z80_OP(main_CC)  //CALL Z, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL Z, {0,-6:X}", disp));
@@ -2237,18 +2880,18 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCD:  //CALL nn
+                case 0xCD: RM_Z80_OP(main_CD)  //CALL nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL {0,-6:X}", disp));
                 Contend(regs.PC + 1, 1, 1);
                 PushStack((ushort)(regs.PC + 2));
                 regs.PC = (ushort)disp;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD4:  //CALL NC, nn
+                case 0xD4: RM_Z80_OP(main_D4)  //CALL NC, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL NC, {0,-6:X}", disp));
@@ -2260,9 +2903,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDC:  //CALL C, nn
+                case 0xDC: RM_Z80_OP(main_DC)  //CALL C, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL C, {0,-6:X}", disp));
@@ -2274,9 +2917,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE4:  //CALL PO, nn
+                case 0xE4: RM_Z80_OP(main_E4)  //CALL PO, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL PO, {0,-6:X}", disp));
@@ -2288,9 +2931,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xEC:  //CALL PE, nn
+                case 0xEC: RM_Z80_OP(main_EC)  //CALL PE, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL PE, {0,-6:X}", disp));
@@ -2302,9 +2945,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF4:  //CALL P, nn
+                case 0xF4: RM_Z80_OP(main_F4)  //CALL P, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL P, {0,-6:X}", disp));
@@ -2316,9 +2959,9 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFC:  //CALL M, nn
+                case 0xFC: RM_Z80_OP(main_FC)  //CALL M, nn
                 disp = PeekWord(regs.PC);
                 regs.MemPtr = (ushort)disp;
                 // Log(String.Format("CALL M, {0,-6:X}", disp));
@@ -2330,73 +2973,73 @@ namespace rm {
                 else {
                     regs.PC += 2;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xC7:  //RST 0x00
+                case 0xC7: RM_Z80_OP(main_C7)  //RST 0x00
                             // Log("RST 00");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x00;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCF:  //RST 0x08
+                case 0xCF: RM_Z80_OP(main_CF)  //RST 0x08
                             // Log("RST 08");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x08;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD7:  //RST 0x10
+                case 0xD7: RM_Z80_OP(main_D7)  //RST 0x10
                             // Log("RST 10");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x10;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDF:  //RST 0x18
+                case 0xDF: RM_Z80_OP(main_DF)  //RST 0x18
                             // Log("RST 18");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x18;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xE7:  //RST 0x20
+                case 0xE7: RM_Z80_OP(main_E7)  //RST 0x20
                             // Log("RST 20");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x20;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xEF:  //RST 0x28
+                case 0xEF: RM_Z80_OP(main_EF)  //RST 0x28
                             // Log("RST 28");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x28;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF7:  //RST 0x30
+                case 0xF7: RM_Z80_OP(main_F7)  //RST 0x30
                             // Log("RST 30");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x30;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFF:  //RST 0x38
+                case 0xFF: RM_Z80_OP(main_FF)  //RST 0x38
                             // Log("RST 38");
                 Contend(regs.IR(), 1, 1);
                 PushStack(regs.PC);
                 regs.PC = 0x38;
                 regs.MemPtr = regs.PC;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDB:  //IN A, (n)
+                case 0xDB: RM_Z80_OP(main_DB)  //IN A, (n)
 
                 disp = PeekByte(regs.PC);
                 port = (ushort)((regs.A << 8) | disp);
@@ -2412,31 +3055,31 @@ namespace rm {
 
                 and_32_Or_64 = false;
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xD3:  //OUT (n), A
+                case 0xD3: RM_Z80_OP(main_D3)  //OUT (n), A
                 disp = PeekByte(regs.PC);
                 // Log(String.Format("OUT ({0:X}), A", disp));
                 Out((ushort)(disp | (regs.A << 8)), regs.A);
                 regs.MemPtr = (ushort)(((disp + 1) & 0xff) | (regs.A << 8));
                 regs.PC++;
-                break;
+                RM_Z80_NEXT;
 
-                case 0x27:  //DAA
+                case 0x27: RM_Z80_OP(main_27)  //DAA
                             // Log("DAA");
                 DAA();
-                break;
+                RM_Z80_NEXT;
 
-                case 0x2f:  //CPL
+                case 0x2f: RM_Z80_OP(main_2F)  //CPL
                             // Log("CPL");
                 regs.A = (byte)(regs.A ^ 0xff);
                 SetF3((regs.A & BIT_F_3) != 0);
                 SetF5((regs.A & BIT_F_5) != 0);
                 SetNeg(true);
                 SetHalf(true);
-                break;
+                RM_Z80_NEXT;
 
-                case 0x76:  //HALT
+                case 0x76: RM_Z80_OP(main_76)  //HALT
                             // Log("HALT");
                 is_halted = true;
                 //Refer to the section HALT and Special reset in:
@@ -2446,1403 +3089,1405 @@ namespace rm {
                 // again and again until an exit condition occurs. When an interrupt occurs during the halt state PC is pushed
                 // unchanged onto the stack as it is already the correct return address."
                 //regs.PC--;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xF3:  //DI
+                case 0xF3: RM_Z80_OP(main_F3)  //DI
                             // Log("DI");
                 iff_1 = false;
                 iff_2 = false;
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFB:  //EI
+                case 0xFB: RM_Z80_OP(main_FB)  //EI
                             // Log("EI");
                 iff_1 = true;
                 iff_2 = true;
                 interrupt_count = 1;
 
-                break;
+                RM_Z80_NEXT;
 
-                case 0xCB:
-                switch(opcode = FetchInstruction()) {
-                    case 0x00: //RLC B
+                case 0xCB: RM_Z80_OP(main_CB)
+                opcode = FetchInstruction();
+                RM_Z80_DISPATCH(cb, opcode);
+                switch(opcode) {
+                    case 0x00: RM_Z80_OP(cb_00) //RLC B
                                // Log("RLC B");
                     regs.B = Rlc_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x01: //RLC C
+                    case 0x01: RM_Z80_OP(cb_01) //RLC C
                                // Log("RLC C");
                     regs.C = Rlc_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x02: //RLC D
+                    case 0x02: RM_Z80_OP(cb_02) //RLC D
                                // Log("RLC D");
                     regs.D = Rlc_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x03: //RLC E
+                    case 0x03: RM_Z80_OP(cb_03) //RLC E
                                // Log("RLC E");
                     regs.E = Rlc_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x04: //RLC H
+                    case 0x04: RM_Z80_OP(cb_04) //RLC H
                                // Log("RLC H");
                     regs.H = Rlc_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x05: //RLC L
+                    case 0x05: RM_Z80_OP(cb_05) //RLC L
                                // Log("RLC L");
                     regs.L = Rlc_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x06: //RLC (regs.HL)
+                    case 0x06: RM_Z80_OP(cb_06) //RLC (regs.HL)
                                // Log("RLC (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Rlc_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x07: //RLC A
+                    case 0x07: RM_Z80_OP(cb_07) //RLC A
                                // Log("RLC A");
                     regs.A = Rlc_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x08: //RRC B
+                    case 0x08: RM_Z80_OP(cb_08) //RRC B
                                // Log("RRC B");
                     regs.B = Rrc_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x09: //RRC C
+                    case 0x09: RM_Z80_OP(cb_09) //RRC C
                                // Log("RRC C");
                     regs.C = Rrc_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x0A: //RRC D
+                    case 0x0A: RM_Z80_OP(cb_0A) //RRC D
                                // Log("RRC D");
                     regs.D = Rrc_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x0B: //RRC E
+                    case 0x0B: RM_Z80_OP(cb_0B) //RRC E
                                // Log("RRC E");
                     regs.E = Rrc_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x0C: //RRC H
+                    case 0x0C: RM_Z80_OP(cb_0C) //RRC H
                                // Log("RRC H");
                     regs.H = Rrc_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x0D: //RRC L
+                    case 0x0D: RM_Z80_OP(cb_0D) //RRC L
                                // Log("RRC L");
                     regs.L = Rrc_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x0E: //RRC (regs.HL)
+                    case 0x0E: RM_Z80_OP(cb_0E) //RRC (regs.HL)
                                // Log("RRC (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Rrc_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x0F: //RRC A
+                    case 0x0F: RM_Z80_OP(cb_0F) //RRC A
                                // Log("RRC A");
                     regs.A = Rrc_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x10: //RL B
+                    case 0x10: RM_Z80_OP(cb_10) //RL B
                                // Log("RL B");
                     regs.B = Rl_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x11: //RL C
+                    case 0x11: RM_Z80_OP(cb_11) //RL C
                                // Log("RL C");
                     regs.C = Rl_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x12: //RL D
+                    case 0x12: RM_Z80_OP(cb_12) //RL D
                                // Log("RL D");
                     regs.D = Rl_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x13: //RL E
+                    case 0x13: RM_Z80_OP(cb_13) //RL E
                                // Log("RL E");
                     regs.E = Rl_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x14: //RL H
+                    case 0x14: RM_Z80_OP(cb_14) //RL H
                                // Log("RL H");
                     regs.H = Rl_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x15: //RL L
+                    case 0x15: RM_Z80_OP(cb_15) //RL L
                                // Log("RL L");
                     regs.L = Rl_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x16: //RL (regs.HL)
+                    case 0x16: RM_Z80_OP(cb_16) //RL (regs.HL)
                                // Log("RL (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Rl_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x17: //RL A
+                    case 0x17: RM_Z80_OP(cb_17) //RL A
                                // Log("RL A");
                     regs.A = Rl_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x18: //RR B
+                    case 0x18: RM_Z80_OP(cb_18) //RR B
                                // Log("RR B");
                     regs.B = Rr_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x19: //RR C
+                    case 0x19: RM_Z80_OP(cb_19) //RR C
                                // Log("RR C");
                     regs.C = Rr_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x1A: //RR D
+                    case 0x1A: RM_Z80_OP(cb_1A) //RR D
                                // Log("RR D");
                     regs.D = Rr_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x1B: //RR E
+                    case 0x1B: RM_Z80_OP(cb_1B) //RR E
                                // Log("RR E");
                     regs.E = Rr_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x1C: //RR H
+                    case 0x1C: RM_Z80_OP(cb_1C) //RR H
                                // Log("RR H");
                     regs.H = Rr_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x1D: //RR L
+                    case 0x1D: RM_Z80_OP(cb_1D) //RR L
                                // Log("RR L");
                     regs.L = Rr_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x1E: //RR (regs.HL)
+                    case 0x1E: RM_Z80_OP(cb_1E) //RR (regs.HL)
                                // Log("RR (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Rr_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x1F: //RR A
+                    case 0x1F: RM_Z80_OP(cb_1F) //RR A
                                // Log("RR A");
                     regs.A = Rr_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x20:  //SLA B
+                    case 0x20: RM_Z80_OP(cb_20)  //SLA B
                                 // Log("SLA B");
                     regs.B = Sla_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x21:  //SLA C
+                    case 0x21: RM_Z80_OP(cb_21)  //SLA C
                                 // Log("SLA C");
                     regs.C = Sla_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x22:  //SLA D
+                    case 0x22: RM_Z80_OP(cb_22)  //SLA D
                                 // Log("SLA D");
                     regs.D = Sla_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x23:  //SLA E
+                    case 0x23: RM_Z80_OP(cb_23)  //SLA E
                                 // Log("SLA E");
                     regs.E = Sla_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x24:  //SLA H
+                    case 0x24: RM_Z80_OP(cb_24)  //SLA H
                                 // Log("SLA H");
                     regs.H = Sla_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x25:  //SLA L
+                    case 0x25: RM_Z80_OP(cb_25)  //SLA L
                                 // Log("SLA L");
                     regs.L = Sla_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x26:  //SLA (regs.HL)
+                    case 0x26: RM_Z80_OP(cb_26)  //SLA (regs.HL)
                                 // Log("SLA (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Sla_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x27:  //SLA A
+                    case 0x27: RM_Z80_OP(cb_27)  //SLA A
                                 // Log("SLA A");
                     regs.A = Sla_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x28:  //SRA B
+                    case 0x28: RM_Z80_OP(cb_28)  //SRA B
                                 // Log("SRA B");
                     regs.B = Sra_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x29:  //SRA C
+                    case 0x29: RM_Z80_OP(cb_29)  //SRA C
                                 // Log("SRA C");
                     regs.C = Sra_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2A:  //SRA D
+                    case 0x2A: RM_Z80_OP(cb_2A)  //SRA D
                                 // Log("SRA D");
                     regs.D = Sra_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2B:  //SRA E
+                    case 0x2B: RM_Z80_OP(cb_2B)  //SRA E
                                 // Log("SRA E");
                     regs.E = Sra_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2C:  //SRA H
+                    case 0x2C: RM_Z80_OP(cb_2C)  //SRA H
                                 // Log("SRA H");
                     regs.H = Sra_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2D:  //SRA L
+                    case 0x2D: RM_Z80_OP(cb_2D)  //SRA L
                                 // Log("SRA L");
                     regs.L = Sra_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2E:  //SRA (regs.HL)
+                    case 0x2E: RM_Z80_OP(cb_2E)  //SRA (regs.HL)
                                 // Log("SRA (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Sra_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x2F:  //SRA A
+                    case 0x2F: RM_Z80_OP(cb_2F)  //SRA A
                                 // Log("SRA A");
                     regs.A = Sra_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x30:  //SLL B
+                    case 0x30: RM_Z80_OP(cb_30)  //SLL B
                                 // Log("SLL B");
                     regs.B = Sll_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x31:  //SLL C
+                    case 0x31: RM_Z80_OP(cb_31)  //SLL C
                                 // Log("SLL C");
                     regs.C = Sll_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x32:  //SLL D
+                    case 0x32: RM_Z80_OP(cb_32)  //SLL D
                                 // Log("SLL D");
                     regs.D = Sll_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x33:  //SLL E
+                    case 0x33: RM_Z80_OP(cb_33)  //SLL E
                                 // Log("SLL E");
                     regs.E = Sll_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x34:  //SLL H
+                    case 0x34: RM_Z80_OP(cb_34)  //SLL H
                                 // Log("SLL H");
                     regs.H = Sll_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x35:  //SLL L
+                    case 0x35: RM_Z80_OP(cb_35)  //SLL L
                                 // Log("SLL L");
                     regs.L = Sll_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x36:  //SLL (regs.HL)
+                    case 0x36: RM_Z80_OP(cb_36)  //SLL (regs.HL)
                                 // Log("SLL (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Sll_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x37:  //SLL A
+                    case 0x37: RM_Z80_OP(cb_37)  //SLL A
                                 // Log("SLL A");
                                 //tstates += 8;
                     regs.A = Sll_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x38:  //SRL B
+                    case 0x38: RM_Z80_OP(cb_38)  //SRL B
                                 // Log("SRL B");
                                 //tstates += 8;
                     regs.B = Srl_R(regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x39:  //SRL C
+                    case 0x39: RM_Z80_OP(cb_39)  //SRL C
                                 // Log("SRL C");
                                 //tstates += 8;
                     regs.C = Srl_R(regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x3A:  //SRL D
+                    case 0x3A: RM_Z80_OP(cb_3A)  //SRL D
                                 // Log("SRL D");
                                 //tstates += 8;
                     regs.D = Srl_R(regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x3B:  //SRL E
+                    case 0x3B: RM_Z80_OP(cb_3B)  //SRL E
                                 // Log("SRL E");
                                 //tstates += 8;
                     regs.E = Srl_R(regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x3C:  //SRL H
+                    case 0x3C: RM_Z80_OP(cb_3C)  //SRL H
                                 // Log("SRL H");
                                 //tstates += 8;
                     regs.H = Srl_R(regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x3D:  //SRL L
+                    case 0x3D: RM_Z80_OP(cb_3D)  //SRL L
                                 // Log("SRL L");
                                 //tstates += 8;
                     regs.L = Srl_R(regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x3E:  //SRL (regs.HL)
+                    case 0x3E: RM_Z80_OP(cb_3E)  //SRL (regs.HL)
                                 // Log("SRL (regs.HL)");
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Srl_R(b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x3F:  //SRL A
+                    case 0x3F: RM_Z80_OP(cb_3F)  //SRL A
                                 // Log("SRL A");
                     regs.A = Srl_R(regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x40:  //BIT 0, B
+                    case 0x40: RM_Z80_OP(cb_40)  //BIT 0, B
                                 // Log("BIT 0, B");
                     Bit_R(0, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x41:  //BIT 0, C
+                    case 0x41: RM_Z80_OP(cb_41)  //BIT 0, C
                                 // Log("BIT 0, C");
                     Bit_R(0, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x42:  //BIT 0, D
+                    case 0x42: RM_Z80_OP(cb_42)  //BIT 0, D
                                 // Log("BIT 0, D");
                     Bit_R(0, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x43:  //BIT 0, E
+                    case 0x43: RM_Z80_OP(cb_43)  //BIT 0, E
                                 // Log("BIT 0, E");
                     Bit_R(0, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x44:  //BIT 0, H
+                    case 0x44: RM_Z80_OP(cb_44)  //BIT 0, H
                                 // Log("BIT 0, H");
                     Bit_R(0, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x45:  //BIT 0, L
+                    case 0x45: RM_Z80_OP(cb_45)  //BIT 0, L
                                 // Log("BIT 0, L");
                     Bit_R(0, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x46:  //BIT 0, (regs.HL)
+                    case 0x46: RM_Z80_OP(cb_46)  //BIT 0, (regs.HL)
                                 // Log("BIT 0, (regs.HL)");
                     Bit_MemPtr(0, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x47:  //BIT 0, A
+                    case 0x47: RM_Z80_OP(cb_47)  //BIT 0, A
                                 // Log("BIT 0, A");
                     Bit_R(0, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x48:  //BIT 1, B
+                    case 0x48: RM_Z80_OP(cb_48)  //BIT 1, B
                                 // Log("BIT 1, B");
                     Bit_R(1, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x49:  //BIT 1, C
+                    case 0x49: RM_Z80_OP(cb_49)  //BIT 1, C
                                 // Log("BIT 1, C");
                     Bit_R(1, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4A:  //BIT 1, D
+                    case 0x4A: RM_Z80_OP(cb_4A)  //BIT 1, D
                                 // Log("BIT 1, D");
                     Bit_R(1, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4B:  //BIT 1, E
+                    case 0x4B: RM_Z80_OP(cb_4B)  //BIT 1, E
                                 // Log("BIT 1, E");
                     Bit_R(1, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4C:  //BIT 1, H
+                    case 0x4C: RM_Z80_OP(cb_4C)  //BIT 1, H
                                 // Log("BIT 1, H");
                     Bit_R(1, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4D:  //BIT 1, L
+                    case 0x4D: RM_Z80_OP(cb_4D)  //BIT 1, L
                                 // Log("BIT 1, L");
                     Bit_R(1, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4E:  //BIT 1, (regs.HL)
+                    case 0x4E: RM_Z80_OP(cb_4E)  //BIT 1, (regs.HL)
                                 // Log("BIT 1, (regs.HL)");
                     Bit_MemPtr(1, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4F:  //BIT 1, A
+                    case 0x4F: RM_Z80_OP(cb_4F)  //BIT 1, A
                                 // Log("BIT 1, A");
                     Bit_R(1, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x50:  //BIT 2, B
+                    case 0x50: RM_Z80_OP(cb_50)  //BIT 2, B
                                 // Log("BIT 2, B");
                     Bit_R(2, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x51:  //BIT 2, C
+                    case 0x51: RM_Z80_OP(cb_51)  //BIT 2, C
                                 // Log("BIT 2, C");
                     Bit_R(2, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x52:  //BIT 2, D
+                    case 0x52: RM_Z80_OP(cb_52)  //BIT 2, D
                                 // Log("BIT 2, D");
                     Bit_R(2, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x53:  //BIT 2, E
+                    case 0x53: RM_Z80_OP(cb_53)  //BIT 2, E
                                 // Log("BIT 2, E");
                     Bit_R(2, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x54:  //BIT 2, H
+                    case 0x54: RM_Z80_OP(cb_54)  //BIT 2, H
                                 // Log("BIT 2, H");
                     Bit_R(2, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x55:  //BIT 2, L
+                    case 0x55: RM_Z80_OP(cb_55)  //BIT 2, L
                                 // Log("BIT 2, L");
                     Bit_R(2, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x56:  //BIT 2, (regs.HL)
+                    case 0x56: RM_Z80_OP(cb_56)  //BIT 2, (regs.HL)
                                 // Log("BIT 2, (regs.HL)");
                     Bit_MemPtr(2, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x57:  //BIT 2, A
+                    case 0x57: RM_Z80_OP(cb_57)  //BIT 2, A
                                 // Log("BIT 2, A");
                     Bit_R(2, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x58:  //BIT 3, B
+                    case 0x58: RM_Z80_OP(cb_58)  //BIT 3, B
                                 // Log("BIT 3, B");
                     Bit_R(3, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x59:  //BIT 3, C
+                    case 0x59: RM_Z80_OP(cb_59)  //BIT 3, C
                                 // Log("BIT 3, C");
                     Bit_R(3, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5A:  //BIT 3, D
+                    case 0x5A: RM_Z80_OP(cb_5A)  //BIT 3, D
                                 // Log("BIT 3, D");
                     Bit_R(3, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5B:  //BIT 3, E
+                    case 0x5B: RM_Z80_OP(cb_5B)  //BIT 3, E
                                 // Log("BIT 3, E");
                     Bit_R(3, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5C:  //BIT 3, H
+                    case 0x5C: RM_Z80_OP(cb_5C)  //BIT 3, H
                                 // Log("BIT 3, H");
                     Bit_R(3, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5D:  //BIT 3, L
+                    case 0x5D: RM_Z80_OP(cb_5D)  //BIT 3, L
                                 // Log("BIT 3, L");
                     Bit_R(3, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5E:  //BIT 3, (regs.HL)
+                    case 0x5E: RM_Z80_OP(cb_5E)  //BIT 3, (regs.HL)
                                 // Log("BIT 3, (regs.HL)");
                     Bit_MemPtr(3, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5F:  //BIT 3, A
+                    case 0x5F: RM_Z80_OP(cb_5F)  //BIT 3, A
                                 // Log("BIT 3, A");
                     Bit_R(3, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x60:  //BIT 4, B
+                    case 0x60: RM_Z80_OP(cb_60)  //BIT 4, B
                                 // Log("BIT 4, B");
                     Bit_R(4, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x61:  //BIT 4, C
+                    case 0x61: RM_Z80_OP(cb_61)  //BIT 4, C
                                 // Log("BIT 4, C");
                     Bit_R(4, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x62:  //BIT 4, D
+                    case 0x62: RM_Z80_OP(cb_62)  //BIT 4, D
                                 // Log("BIT 4, D");
                     Bit_R(4, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x63:  //BIT 4, E
+                    case 0x63: RM_Z80_OP(cb_63)  //BIT 4, E
                                 // Log("BIT 4, E");
                     Bit_R(4, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x64:  //BIT 4, H
+                    case 0x64: RM_Z80_OP(cb_64)  //BIT 4, H
                                 // Log("BIT 4, H");
                     Bit_R(4, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x65:  //BIT 4, L
+                    case 0x65: RM_Z80_OP(cb_65)  //BIT 4, L
                                 // Log("BIT 4, L");
                     Bit_R(4, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x66:  //BIT 4, (regs.HL)
+                    case 0x66: RM_Z80_OP(cb_66)  //BIT 4, (regs.HL)
                                 // Log("BIT 4, (regs.HL)");
                     Bit_MemPtr(4, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x67:  //BIT 4, A
+                    case 0x67: RM_Z80_OP(cb_67)  //BIT 4, A
                                 // Log("BIT 4, A");
                     Bit_R(4, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x68:  //BIT 5, B
+                    case 0x68: RM_Z80_OP(cb_68)  //BIT 5, B
                                 // Log("BIT 5, B");
                     Bit_R(5, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x69:  //BIT 5, C
+                    case 0x69: RM_Z80_OP(cb_69)  //BIT 5, C
                                 // Log("BIT 5, C");
                     Bit_R(5, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6A:  //BIT 5, D
+                    case 0x6A: RM_Z80_OP(cb_6A)  //BIT 5, D
                                 // Log("BIT 5, D");
                     Bit_R(5, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6B:  //BIT 5, E
+                    case 0x6B: RM_Z80_OP(cb_6B)  //BIT 5, E
                                 // Log("BIT 5, E");
                     Bit_R(5, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6C:  //BIT 5, H
+                    case 0x6C: RM_Z80_OP(cb_6C)  //BIT 5, H
                                 // Log("BIT 5, H");
                     Bit_R(5, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6D:  //BIT 5, L
+                    case 0x6D: RM_Z80_OP(cb_6D)  //BIT 5, L
                                 // Log("BIT 5, L");
                     Bit_R(5, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6E:  //BIT 5, (regs.HL)
+                    case 0x6E: RM_Z80_OP(cb_6E)  //BIT 5, (regs.HL)
                                 // Log("BIT 5, (regs.HL)");
                     Bit_MemPtr(5, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6F:  //BIT 5, A
+                    case 0x6F: RM_Z80_OP(cb_6F)  //BIT 5, A
                                 // Log("BIT 5, A");
                     Bit_R(5, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x70:  //BIT 6, B
+                    case 0x70: RM_Z80_OP(cb_70)  //BIT 6, B
                                 // Log("BIT 6, B");
                     Bit_R(6, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x71:  //BIT 6, C
+                    case 0x71: RM_Z80_OP(cb_71)  //BIT 6, C
                                 // Log("BIT 6, C");
                     Bit_R(6, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x72:  //BIT 6, D
+                    case 0x72: RM_Z80_OP(cb_72)  //BIT 6, D
                                 // Log("BIT 6, D");
                     Bit_R(6, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x73:  //BIT 6, E
+                    case 0x73: RM_Z80_OP(cb_73)  //BIT 6, E
                                 // Log("BIT 6, E");
                     Bit_R(6, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x74:  //BIT 6, H
+                    case 0x74: RM_Z80_OP(cb_74)  //BIT 6, H
                                 // Log("BIT 6, H");
                     Bit_R(6, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x75:  //BIT 6, L
+                    case 0x75: RM_Z80_OP(cb_75)  //BIT 6, L
                                 // Log("BIT 6, L");
                     Bit_R(6, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x76:  //BIT 6, (regs.HL)
+                    case 0x76: RM_Z80_OP(cb_76)  //BIT 6, (regs.HL)
                                 // Log("BIT 6, (regs.HL)");
                     Bit_MemPtr(6, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x77:  //BIT 6, A
+                    case 0x77: RM_Z80_OP(cb_77)  //BIT 6, A
                                 // Log("BIT 6, A");
                     Bit_R(6, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x78:  //BIT 7, B
+                    case 0x78: RM_Z80_OP(cb_78)  //BIT 7, B
                                 // Log("BIT 7, B");
                     Bit_R(7, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x79:  //BIT 7, C
+                    case 0x79: RM_Z80_OP(cb_79)  //BIT 7, C
                                 // Log("BIT 7, C");
                     Bit_R(7, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7A:  //BIT 7, D
+                    case 0x7A: RM_Z80_OP(cb_7A)  //BIT 7, D
                                 // Log("BIT 7, D");
                     Bit_R(7, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7B:  //BIT 7, E
+                    case 0x7B: RM_Z80_OP(cb_7B)  //BIT 7, E
                                 // Log("BIT 7, E");
                     Bit_R(7, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7C:  //BIT 7, H
+                    case 0x7C: RM_Z80_OP(cb_7C)  //BIT 7, H
                                 // Log("BIT 7, H");
                     Bit_R(7, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7D:  //BIT 7, L
+                    case 0x7D: RM_Z80_OP(cb_7D)  //BIT 7, L
                                 // Log("BIT 7, L");
                     Bit_R(7, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7E:  //BIT 7, (regs.HL)
+                    case 0x7E: RM_Z80_OP(cb_7E)  //BIT 7, (regs.HL)
                                 // Log("BIT 7, (regs.HL)");
                     Bit_MemPtr(7, PeekByte(regs.HL));
                     Contend(regs.HL, 1, 1);
 
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7F:  //BIT 7, A
+                    case 0x7F: RM_Z80_OP(cb_7F)  //BIT 7, A
                                 // Log("BIT 7, A");
                     Bit_R(7, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x80:  //RES 0, B
+                    case 0x80: RM_Z80_OP(cb_80)  //RES 0, B
                                 // Log("RES 0, B");
                     regs.B = Res_R(0, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x81:  //RES 0, C
+                    case 0x81: RM_Z80_OP(cb_81)  //RES 0, C
                                 // Log("RES 0, C");
                     regs.C = Res_R(0, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x82:  //RES 0, D
+                    case 0x82: RM_Z80_OP(cb_82)  //RES 0, D
                                 // Log("RES 0, D");
                     regs.D = Res_R(0, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x83:  //RES 0, E
+                    case 0x83: RM_Z80_OP(cb_83)  //RES 0, E
                                 // Log("RES 0, E");
                     regs.E = Res_R(0, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x84:  //RES 0, H
+                    case 0x84: RM_Z80_OP(cb_84)  //RES 0, H
                                 // Log("RES 0, H");
                     regs.H = Res_R(0, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x85:  //RES 0, L
+                    case 0x85: RM_Z80_OP(cb_85)  //RES 0, L
                                 // Log("RES 0, L");
                     regs.L = Res_R(0, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x86:  //RES 0, (regs.HL)
+                    case 0x86: RM_Z80_OP(cb_86)  //RES 0, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(0, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x87:  //RES 0, A
+                    case 0x87: RM_Z80_OP(cb_87)  //RES 0, A
                                 // Log("RES 0, A");
                     regs.A = Res_R(0, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x88:  //RES 1, B
+                    case 0x88: RM_Z80_OP(cb_88)  //RES 1, B
                                 // Log("RES 1, B");
                     regs.B = Res_R(1, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x89:  //RES 1, C
+                    case 0x89: RM_Z80_OP(cb_89)  //RES 1, C
                                 // Log("RES 1, C");
                     regs.C = Res_R(1, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8A:  //RES 1, D
+                    case 0x8A: RM_Z80_OP(cb_8A)  //RES 1, D
                                 // Log("RES 1, D");
                     regs.D = Res_R(1, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8B:  //RES 1, E
+                    case 0x8B: RM_Z80_OP(cb_8B)  //RES 1, E
                                 // Log("RES 1, E");
                     regs.E = Res_R(1, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8C:  //RES 1, H
+                    case 0x8C: RM_Z80_OP(cb_8C)  //RES 1, H
                                 // Log("RES 1, H");
                                 //tstates += 8;
                     regs.H = Res_R(1, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8D:  //RES 1, L
+                    case 0x8D: RM_Z80_OP(cb_8D)  //RES 1, L
                                 // Log("RES 1, L");
                     regs.L = Res_R(1, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8E:  //RES 1, (regs.HL)
+                    case 0x8E: RM_Z80_OP(cb_8E)  //RES 1, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(1, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x8F:  //RES 1, A
+                    case 0x8F: RM_Z80_OP(cb_8F)  //RES 1, A
                                 // Log("RES 1, A");
                     regs.A = Res_R(1, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x90:  //RES 2, B
+                    case 0x90: RM_Z80_OP(cb_90)  //RES 2, B
                                 // Log("RES 2, B");
                     regs.B = Res_R(2, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x91:  //RES 2, C
+                    case 0x91: RM_Z80_OP(cb_91)  //RES 2, C
                                 // Log("RES 2, C");
                     regs.C = Res_R(2, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x92:  //RES 2, D
+                    case 0x92: RM_Z80_OP(cb_92)  //RES 2, D
                                 // Log("RES 2, D");
                     regs.D = Res_R(2, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x93:  //RES 2, E
+                    case 0x93: RM_Z80_OP(cb_93)  //RES 2, E
                                 // Log("RES 2, E");
                     regs.E = Res_R(2, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x94:  //RES 2, H
+                    case 0x94: RM_Z80_OP(cb_94)  //RES 2, H
                                 // Log("RES 2, H");
                     regs.H = Res_R(2, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x95:  //RES 2, L
+                    case 0x95: RM_Z80_OP(cb_95)  //RES 2, L
                                 // Log("RES 2, L");
                     regs.L = Res_R(2, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x96:  //RES 2, (regs.HL)
+                    case 0x96: RM_Z80_OP(cb_96)  //RES 2, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(2, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x97:  //RES 2, A
+                    case 0x97: RM_Z80_OP(cb_97)  //RES 2, A
                                 // Log("RES 2, A");
                     regs.A = Res_R(2, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x98:  //RES 3, B
+                    case 0x98: RM_Z80_OP(cb_98)  //RES 3, B
                                 // Log("RES 3, B");
                     regs.B = Res_R(3, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x99:  //RES 3, C
+                    case 0x99: RM_Z80_OP(cb_99)  //RES 3, C
                                 // Log("RES 3, C");
                     regs.C = Res_R(3, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9A:  //RES 3, D
+                    case 0x9A: RM_Z80_OP(cb_9A)  //RES 3, D
                                 // Log("RES 3, D");
                     regs.D = Res_R(3, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9B:  //RES 3, E
+                    case 0x9B: RM_Z80_OP(cb_9B)  //RES 3, E
                                 // Log("RES 3, E");
                     regs.E = Res_R(3, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9C:  //RES 3, H
+                    case 0x9C: RM_Z80_OP(cb_9C)  //RES 3, H
                                 // Log("RES 3, H");
                     regs.H = Res_R(3, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9D:  //RES 3, L
+                    case 0x9D: RM_Z80_OP(cb_9D)  //RES 3, L
                                 // Log("RES 3, L");
                     regs.L = Res_R(3, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9E:  //RES 3, (regs.HL)
+                    case 0x9E: RM_Z80_OP(cb_9E)  //RES 3, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(3, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x9F:  //RES 3, A
+                    case 0x9F: RM_Z80_OP(cb_9F)  //RES 3, A
                                 // Log("RES 3, A");
                     regs.A = Res_R(3, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA0:  //RES 4, B
+                    case 0xA0: RM_Z80_OP(cb_A0)  //RES 4, B
                                 // Log("RES 4, B");
                     regs.B = Res_R(4, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA1:  //RES 4, C
+                    case 0xA1: RM_Z80_OP(cb_A1)  //RES 4, C
                                 // Log("RES 4, C");
                     regs.C = Res_R(4, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA2:  //RES 4, D
+                    case 0xA2: RM_Z80_OP(cb_A2)  //RES 4, D
                                 // Log("RES 4, D");
                     regs.D = Res_R(4, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA3:  //RES 4, E
+                    case 0xA3: RM_Z80_OP(cb_A3)  //RES 4, E
                                 // Log("RES 4, E");
                     regs.E = Res_R(4, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA4:  //RES 4, H
+                    case 0xA4: RM_Z80_OP(cb_A4)  //RES 4, H
                                 // Log("RES 4, H");
                     regs.H = Res_R(4, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA5:  //RES 4, L
+                    case 0xA5: RM_Z80_OP(cb_A5)  //RES 4, L
                                 // Log("RES 4, L");
                     regs.L = Res_R(4, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA6:  //RES 4, (regs.HL)
+                    case 0xA6: RM_Z80_OP(cb_A6)  //RES 4, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(4, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
 
-                    case 0xA7:  //RES 4, A
+                    case 0xA7: RM_Z80_OP(cb_A7)  //RES 4, A
                                 // Log("RES 4, A");
                     regs.A = Res_R(4, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA8:  //RES 5, B
+                    case 0xA8: RM_Z80_OP(cb_A8)  //RES 5, B
                                 // Log("RES 5, B");
                     regs.B = Res_R(5, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA9:  //RES 5, C
+                    case 0xA9: RM_Z80_OP(cb_A9)  //RES 5, C
                                 // Log("RES 5, C");
                     regs.C = Res_R(5, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAA:  //RES 5, D
+                    case 0xAA: RM_Z80_OP(cb_AA)  //RES 5, D
                                 // Log("RES 5, D");
                     regs.D = Res_R(5, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAB:  //RES 5, E
+                    case 0xAB: RM_Z80_OP(cb_AB)  //RES 5, E
                                 // Log("RES 5, E");
                     regs.E = Res_R(5, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAC:  //RES 5, H
+                    case 0xAC: RM_Z80_OP(cb_AC)  //RES 5, H
                                 // Log("RES 5, H");
                     regs.H = Res_R(5, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAD:  //RES 5, L
+                    case 0xAD: RM_Z80_OP(cb_AD)  //RES 5, L
                                 // Log("RES 5, L");
                     regs.L = Res_R(5, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAE:  //RES 5, (regs.HL)
+                    case 0xAE: RM_Z80_OP(cb_AE)  //RES 5, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(5, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
 
-                    case 0xAF:  //RES 5, A
+                    case 0xAF: RM_Z80_OP(cb_AF)  //RES 5, A
                                 // Log("RES 5, A");
                     regs.A = Res_R(5, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB0:  //RES 6, B
+                    case 0xB0: RM_Z80_OP(cb_B0)  //RES 6, B
                                 // Log("RES 6, B");
                     regs.B = Res_R(6, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB1:  //RES 6, C
+                    case 0xB1: RM_Z80_OP(cb_B1)  //RES 6, C
                                 // Log("RES 6, C");
                     regs.C = Res_R(6, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB2:  //RES 6, D
+                    case 0xB2: RM_Z80_OP(cb_B2)  //RES 6, D
                                 // Log("RES 6, D");
                     regs.D = Res_R(6, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB3:  //RES 6, E
+                    case 0xB3: RM_Z80_OP(cb_B3)  //RES 6, E
                                 // Log("RES 6, E");
                     regs.E = Res_R(6, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB4:  //RES 6, H
+                    case 0xB4: RM_Z80_OP(cb_B4)  //RES 6, H
                                 // Log("RES 6, H");
                     regs.H = Res_R(6, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB5:  //RES 6, L
+                    case 0xB5: RM_Z80_OP(cb_B5)  //RES 6, L
                                 // Log("RES 6, L");
                     regs.L = Res_R(6, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB6:  //RES 6, (regs.HL)
+                    case 0xB6: RM_Z80_OP(cb_B6)  //RES 6, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(6, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xB7:  //RES 6, A
+                    case 0xB7: RM_Z80_OP(cb_B7)  //RES 6, A
                                 // Log("RES 6, A");
                     regs.A = Res_R(6, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB8:  //RES 7, B
+                    case 0xB8: RM_Z80_OP(cb_B8)  //RES 7, B
                                 // Log("RES 7, B");
                     regs.B = Res_R(7, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB9:  //RES 7, C
+                    case 0xB9: RM_Z80_OP(cb_B9)  //RES 7, C
                                 // Log("RES 7, C");
                     regs.C = Res_R(7, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBA:  //RES 7, D
+                    case 0xBA: RM_Z80_OP(cb_BA)  //RES 7, D
                                 // Log("RES 7, D");
                     regs.D = Res_R(7, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBB:  //RES 7, E
+                    case 0xBB: RM_Z80_OP(cb_BB)  //RES 7, E
                                 // Log("RES 7, E");
                     regs.E = Res_R(7, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBC:  //RES 7, H
+                    case 0xBC: RM_Z80_OP(cb_BC)  //RES 7, H
                                 // Log("RES 7, H");
                     regs.H = Res_R(7, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBD:  //RES 7, L
+                    case 0xBD: RM_Z80_OP(cb_BD)  //RES 7, L
                                 // Log("RES 7, L");
                     regs.L = Res_R(7, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBE:  //RES 7, (regs.HL)
+                    case 0xBE: RM_Z80_OP(cb_BE)  //RES 7, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Res_R(7, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0xBF:  //RES 7, A
+                    case 0xBF: RM_Z80_OP(cb_BF)  //RES 7, A
                                 // Log("RES 7, A");
                     regs.A = Res_R(7, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC0:  //SET 0, B
+                    case 0xC0: RM_Z80_OP(cb_C0)  //SET 0, B
                                 // Log("SET 0, B");
                     regs.B = Set_R(0, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC1:  //SET 0, C
+                    case 0xC1: RM_Z80_OP(cb_C1)  //SET 0, C
                                 // Log("SET 0, C");
                     regs.C = Set_R(0, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC2:  //SET 0, D
+                    case 0xC2: RM_Z80_OP(cb_C2)  //SET 0, D
                                 // Log("SET 0, D");
                     regs.D = Set_R(0, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC3:  //SET 0, E
+                    case 0xC3: RM_Z80_OP(cb_C3)  //SET 0, E
                                 // Log("SET 0, E");
                     regs.E = Set_R(0, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC4:  //SET 0, H
+                    case 0xC4: RM_Z80_OP(cb_C4)  //SET 0, H
                                 // Log("SET 0, H");
                     regs.H = Set_R(0, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC5:  //SET 0, L
+                    case 0xC5: RM_Z80_OP(cb_C5)  //SET 0, L
                                 // Log("SET 0, L");
                     regs.L = Set_R(0, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC6:  //SET 0, (regs.HL)
+                    case 0xC6: RM_Z80_OP(cb_C6)  //SET 0, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(0, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xC7:  //SET 0, A
+                    case 0xC7: RM_Z80_OP(cb_C7)  //SET 0, A
                                 // Log("SET 0, A");
                     regs.A = Set_R(0, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC8:  //SET 1, B
+                    case 0xC8: RM_Z80_OP(cb_C8)  //SET 1, B
                                 // Log("SET 1, B");
                     regs.B = Set_R(1, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xC9:  //SET 1, C
+                    case 0xC9: RM_Z80_OP(cb_C9)  //SET 1, C
                                 // Log("SET 1, C");
                     regs.C = Set_R(1, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCA:  //SET 1, D
+                    case 0xCA: RM_Z80_OP(cb_CA)  //SET 1, D
                                 // Log("SET 1, D");
                     regs.D = Set_R(1, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCB:  //SET 1, E
+                    case 0xCB: RM_Z80_OP(cb_CB)  //SET 1, E
                                 // Log("SET 1, E");
                     regs.E = Set_R(1, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCC:  //SET 1, H
+                    case 0xCC: RM_Z80_OP(cb_CC)  //SET 1, H
                                 // Log("SET 1, H");
                     regs.H = Set_R(1, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCD:  //SET 1, L
+                    case 0xCD: RM_Z80_OP(cb_CD)  //SET 1, L
                                 // Log("SET 1, L");
                     regs.L = Set_R(1, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCE:  //SET 1, (regs.HL)
+                    case 0xCE: RM_Z80_OP(cb_CE)  //SET 1, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(1, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0xCF:  //SET 1, A
+                    case 0xCF: RM_Z80_OP(cb_CF)  //SET 1, A
                                 // Log("SET 1, A");
                     regs.A = Set_R(1, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD0:  //SET 2, B
+                    case 0xD0: RM_Z80_OP(cb_D0)  //SET 2, B
                                 // Log("SET 2, B");
                     regs.B = Set_R(2, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD1:  //SET 2, C
+                    case 0xD1: RM_Z80_OP(cb_D1)  //SET 2, C
                                 // Log("SET 2, C");
                     regs.C = Set_R(2, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD2:  //SET 2, D
+                    case 0xD2: RM_Z80_OP(cb_D2)  //SET 2, D
                                 // Log("SET 2, D");
                     regs.D = Set_R(2, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD3:  //SET 2, E
+                    case 0xD3: RM_Z80_OP(cb_D3)  //SET 2, E
                                 // Log("SET 2, E");
                     regs.E = Set_R(2, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD4:  //SET 2, H
+                    case 0xD4: RM_Z80_OP(cb_D4)  //SET 2, H
                                 // Log("SET 2, H");
                     regs.H = Set_R(2, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD5:  //SET 2, L
+                    case 0xD5: RM_Z80_OP(cb_D5)  //SET 2, L
                                 // Log("SET 2, L");
                     regs.L = Set_R(2, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD6:  //SET 2, (regs.HL)
+                    case 0xD6: RM_Z80_OP(cb_D6)  //SET 2, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(2, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xD7:  //SET 2, A
+                    case 0xD7: RM_Z80_OP(cb_D7)  //SET 2, A
                                 // Log("SET 2, A");
                     regs.A = Set_R(2, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD8:  //SET 3, B
+                    case 0xD8: RM_Z80_OP(cb_D8)  //SET 3, B
                                 // Log("SET 3, B");
                     regs.B = Set_R(3, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xD9:  //SET 3, C
+                    case 0xD9: RM_Z80_OP(cb_D9)  //SET 3, C
                                 // Log("SET 3, C");
                     regs.C = Set_R(3, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xDA:  //SET 3, D
+                    case 0xDA: RM_Z80_OP(cb_DA)  //SET 3, D
                                 // Log("SET 3, D");
                     regs.D = Set_R(3, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xDB:  //SET 3, E
+                    case 0xDB: RM_Z80_OP(cb_DB)  //SET 3, E
                                 // Log("SET 3, E");
                     regs.E = Set_R(3, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xDC:  //SET 3, H
+                    case 0xDC: RM_Z80_OP(cb_DC)  //SET 3, H
                                 // Log("SET 3, H");
                     regs.H = Set_R(3, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xDD:  //SET 3, L
+                    case 0xDD: RM_Z80_OP(cb_DD)  //SET 3, L
                                 // Log("SET 3, L");
                     regs.L = Set_R(3, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xDE:  //SET 3, (regs.HL)
+                    case 0xDE: RM_Z80_OP(cb_DE)  //SET 3, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(3, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xDF:  //SET 3, A
+                    case 0xDF: RM_Z80_OP(cb_DF)  //SET 3, A
                                 // Log("SET 3, A");
                     regs.A = Set_R(3, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE0:  //SET 4, B
+                    case 0xE0: RM_Z80_OP(cb_E0)  //SET 4, B
                                 // Log("SET 4, B");
                     regs.B = Set_R(4, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE1:  //SET 4, C
+                    case 0xE1: RM_Z80_OP(cb_E1)  //SET 4, C
                                 // Log("SET 4, C");
                     regs.C = Set_R(4, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE2:  //SET 4, D
+                    case 0xE2: RM_Z80_OP(cb_E2)  //SET 4, D
                                 // Log("SET 4, D");
                     regs.D = Set_R(4, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE3:  //SET 4, E
+                    case 0xE3: RM_Z80_OP(cb_E3)  //SET 4, E
                                 // Log("SET 4, E");
                     regs.E = Set_R(4, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE4:  //SET 4, H
+                    case 0xE4: RM_Z80_OP(cb_E4)  //SET 4, H
                                 // Log("SET 4, H");
                     regs.H = Set_R(4, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE5:  //SET 4, L
+                    case 0xE5: RM_Z80_OP(cb_E5)  //SET 4, L
                                 // Log("SET 4, L");
                     regs.L = Set_R(4, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE6:  //SET 4, (regs.HL)
+                    case 0xE6: RM_Z80_OP(cb_E6)  //SET 4, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(4, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xE7:  //SET 4, A
+                    case 0xE7: RM_Z80_OP(cb_E7)  //SET 4, A
                                 // Log("SET 4, A");
                     regs.A = Set_R(4, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE8:  //SET 5, B
+                    case 0xE8: RM_Z80_OP(cb_E8)  //SET 5, B
                                 // Log("SET 5, B");
                     regs.B = Set_R(5, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE9:  //SET 5, C
+                    case 0xE9: RM_Z80_OP(cb_E9)  //SET 5, C
                                 // Log("SET 5, C");
                     regs.C = Set_R(5, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xEA:  //SET 5, D
+                    case 0xEA: RM_Z80_OP(cb_EA)  //SET 5, D
                                 // Log("SET 5, D");
                     regs.D = Set_R(5, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xEB:  //SET 5, E
+                    case 0xEB: RM_Z80_OP(cb_EB)  //SET 5, E
                                 // Log("SET 5, E");
                     regs.E = Set_R(5, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xEC:  //SET 5, H
+                    case 0xEC: RM_Z80_OP(cb_EC)  //SET 5, H
                                 // Log("SET 5, H");
                     regs.H = Set_R(5, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xED:  //SET 5, L
+                    case 0xED: RM_Z80_OP(cb_ED)  //SET 5, L
                                 // Log("SET 5, L");
                     regs.L = Set_R(5, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xEE:  //SET 5, (regs.HL)
+                    case 0xEE: RM_Z80_OP(cb_EE)  //SET 5, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(5, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0xEF:  //SET 5, A
+                    case 0xEF: RM_Z80_OP(cb_EF)  //SET 5, A
                                 // Log("SET 5, A");
                     regs.A = Set_R(5, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF0:  //SET 6, B
+                    case 0xF0: RM_Z80_OP(cb_F0)  //SET 6, B
                                 // Log("SET 6, B");
                     regs.B = Set_R(6, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF1:  //SET 6, C
+                    case 0xF1: RM_Z80_OP(cb_F1)  //SET 6, C
                                 // Log("SET 6, C");
                     regs.C = Set_R(6, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF2:  //SET 6, D
+                    case 0xF2: RM_Z80_OP(cb_F2)  //SET 6, D
                                 // Log("SET 6, D");
                     regs.D = Set_R(6, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF3:  //SET 6, E
+                    case 0xF3: RM_Z80_OP(cb_F3)  //SET 6, E
                                 // Log("SET 6, E");
                     regs.E = Set_R(6, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF4:  //SET 6, H
+                    case 0xF4: RM_Z80_OP(cb_F4)  //SET 6, H
                                 // Log("SET 6, H");
                     regs.H = Set_R(6, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF5:  //SET 6, L
+                    case 0xF5: RM_Z80_OP(cb_F5)  //SET 6, L
                                 // Log("SET 6, L");
                     regs.L = Set_R(6, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF6:  //SET 6, (regs.HL)
+                    case 0xF6: RM_Z80_OP(cb_F6)  //SET 6, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(6, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xF7:  //SET 6, A
+                    case 0xF7: RM_Z80_OP(cb_F7)  //SET 6, A
                                 // Log("SET 6, A");
                     regs.A = Set_R(6, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF8:  //SET 7, B
+                    case 0xF8: RM_Z80_OP(cb_F8)  //SET 7, B
                                 // Log("SET 7, B");
                     regs.B = Set_R(7, regs.B);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xF9:  //SET 7, C
+                    case 0xF9: RM_Z80_OP(cb_F9)  //SET 7, C
                                 // Log("SET 7, C");
                     regs.C = Set_R(7, regs.C);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xFA:  //SET 7, D
+                    case 0xFA: RM_Z80_OP(cb_FA)  //SET 7, D
                                 // Log("SET 7, D");
                     regs.D = Set_R(7, regs.D);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xFB:  //SET 7, E
+                    case 0xFB: RM_Z80_OP(cb_FB)  //SET 7, E
                                 // Log("SET 7, E");
                     regs.E = Set_R(7, regs.E);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xFC:  //SET 7, H
+                    case 0xFC: RM_Z80_OP(cb_FC)  //SET 7, H
                                 // Log("SET 7, H");
                     regs.H = Set_R(7, regs.H);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xFD:  //SET 7, L
+                    case 0xFD: RM_Z80_OP(cb_FD)  //SET 7, L
                                 // Log("SET 7, L");
                     regs.L = Set_R(7, regs.L);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xFE:  //SET 7, (regs.HL)
+                    case 0xFE: RM_Z80_OP(cb_FE)  //SET 7, (regs.HL)
                     {
                         byte b = PeekByte(regs.HL);
                         Contend(regs.HL, 1, 1);
                         PokeByte(regs.HL, Set_R(7, b));
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xFF:  //SET 7, A
+                    case 0xFF: RM_Z80_OP(cb_FF)  //SET 7, A
                                 // Log("SET 7, A");
                     regs.A = Set_R(7, regs.A);
-                    break;
+                    RM_Z80_NEXT;
 
                     //  default:
                     //      String msg = "ERROR: Could not handle DD " + opcode.ToString();
@@ -3850,49 +4495,51 @@ namespace rm {
                     //                  MessageBoxButtons.OKCancel, MessageBoxIcon.Error);
                     //      break;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xDD:
-                switch(opcode = FetchInstruction()) {
-                    case 0x09:  //ADD regs.IX, regs.BC
+                case 0xDD: RM_Z80_OP(main_DD)
+                opcode = FetchInstruction();
+                RM_Z80_DISPATCH(dd, opcode);
+                switch(opcode) {
+                    case 0x09: RM_Z80_OP(dd_09)  //ADD regs.IX, regs.BC
                                 // Log("ADD regs.IX, regs.BC");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IX + 1);
                     regs.IX = Add_RR(regs.IX, regs.BC);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x19:  //ADD regs.IX, regs.DE
+                    case 0x19: RM_Z80_OP(dd_19)  //ADD regs.IX, regs.DE
                                 // Log("ADD regs.IX, regs.DE");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IX + 1);
                     regs.IX = Add_RR(regs.IX, regs.DE);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x29:  //ADD regs.IX, regs.IX
+                    case 0x29: RM_Z80_OP(dd_29)  //ADD regs.IX, regs.IX
                                 // Log("ADD regs.IX, regs.IX");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IX + 1);
                     regs.IX = Add_RR(regs.IX, regs.IX);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x39:  //ADD regs.IX, regs.SP
+                    case 0x39: RM_Z80_OP(dd_39)  //ADD regs.IX, regs.SP
                                 // Log("ADD regs.IX, regs.SP");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IX + 1);
                     regs.IX = Add_RR(regs.IX, regs.SP);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x84:  //ADD A, IXH
+                    case 0x84: RM_Z80_OP(dd_84)  //ADD A, IXH
                                 // Log("ADD A, IXH");
                     Add_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x85:  //ADD A, IXL
+                    case 0x85: RM_Z80_OP(dd_85)  //ADD A, IXL
                                 // Log("ADD A, IXL");
                     Add_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x86:  //Add A, (regs.IX+d)
+                    case 0x86: RM_Z80_OP(dd_86)  //Add A, (regs.IX+d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -3901,20 +4548,20 @@ namespace rm {
                         Add_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x8C:  //ADC A, IXH
+                    case 0x8C: RM_Z80_OP(dd_8C)  //ADC A, IXH
                                 // Log("ADC A, IXH");
                     Adc_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8D:  //ADC A, IXL
+                    case 0x8D: RM_Z80_OP(dd_8D)  //ADC A, IXL
                                 // Log("ADC A, IXL");
                     Adc_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8E: //ADC A, (regs.IX+d)
+                    case 0x8E: RM_Z80_OP(dd_8E) //ADC A, (regs.IX+d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -3926,20 +4573,20 @@ namespace rm {
                         Adc_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x94:  //SUB A, IXH
+                    case 0x94: RM_Z80_OP(dd_94)  //SUB A, IXH
                                 // Log("SUB A, IXH");
                     Sub_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x95:  //SUB A, IXL
+                    case 0x95: RM_Z80_OP(dd_95)  //SUB A, IXL
                                 // Log("SUB A, IXL");
                     Sub_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x96:  //SUB (regs.IX + d)
+                    case 0x96: RM_Z80_OP(dd_96)  //SUB (regs.IX + d)
                     {
                         int b= GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -3951,20 +4598,20 @@ namespace rm {
                         Sub_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x9C:  //SBC A, IXH
+                    case 0x9C: RM_Z80_OP(dd_9C)  //SBC A, IXH
                                 // Log("SBC A, IXH");
                     Sbc_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9D:  //SBC A, IXL
+                    case 0x9D: RM_Z80_OP(dd_9D)  //SBC A, IXL
                                 // Log("SBC A, IXL");
                     Sbc_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9E:  //SBC A, (regs.IX + d)
+                    case 0x9E: RM_Z80_OP(dd_9E)  //SBC A, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -3976,48 +4623,48 @@ namespace rm {
                         regs.MemPtr = offset;
                         Sbc_R(PeekByte(offset));
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x23:  //INC regs.IX
+                    case 0x23: RM_Z80_OP(dd_23)  //INC regs.IX
                                 // Log("INC regs.IX");
                                 //if (model == MachineModel._plus3)
                                 //    totalTStates += 2;
                                 //else
                     Contend(regs.IR(), 1, 2);
                     regs.IX++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x24:  //INC IXH
+                    case 0x24: RM_Z80_OP(dd_24)  //INC IXH
                                 // Log("INC IXH");
                     regs.IXH = Inc(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x25:  //DEC IXH
+                    case 0x25: RM_Z80_OP(dd_25)  //DEC IXH
                                 // Log("DEC IXH");
                     regs.IXH = Dec(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2B:  //DEC regs.IX
+                    case 0x2B: RM_Z80_OP(dd_2B)  //DEC regs.IX
                                 // Log("DEC regs.IX");
                                 //if (model == MachineModel._plus3)
                                 //    totalTStates += 2;
                                 //else
                     Contend(regs.IR(), 1, 2);
                     regs.IX--;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2C:  //INC IXL
+                    case 0x2C: RM_Z80_OP(dd_2C)  //INC IXL
                                 // Log("INC IXL");
                     regs.IXL = Inc(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2D:  //DEC IXL
+                    case 0x2D: RM_Z80_OP(dd_2D)  //DEC IXL
                                 // Log("DEC IXL");
                     regs.IXL = Dec(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x34:  //INC (regs.IX + d)
+                    case 0x34: RM_Z80_OP(dd_34)  //INC (regs.IX + d)
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + d); //The displacement required
@@ -4028,10 +4675,10 @@ namespace rm {
                         PokeByte(offset, b);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x35:  //DEC (regs.IX + d)
+                    case 0x35: RM_Z80_OP(dd_35)  //DEC (regs.IX + d)
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + d); //The displacement required
@@ -4042,20 +4689,20 @@ namespace rm {
                         PokeByte(offset, b);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xA4:  //AND IXH
+                    case 0xA4: RM_Z80_OP(dd_A4)  //AND IXH
                                 // Log("AND IXH");
                     And_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA5:  //AND IXL
+                    case 0xA5: RM_Z80_OP(dd_A5)  //AND IXL
                                 // Log("AND IXL");
                     And_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA6:  //AND (regs.IX + d)
+                    case 0xA6: RM_Z80_OP(dd_A6)  //AND (regs.IX + d)
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + d); //The displacement required
@@ -4067,20 +4714,20 @@ namespace rm {
                         And_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xAC:  //XOR IXH
+                    case 0xAC: RM_Z80_OP(dd_AC)  //XOR IXH
                                 // Log("XOR IXH");
                     Xor_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAD:  //XOR IXL
+                    case 0xAD: RM_Z80_OP(dd_AD)  //XOR IXL
                                 // Log("XOR IXL");
                     Xor_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAE:  //XOR (regs.IX + d)
+                    case 0xAE: RM_Z80_OP(dd_AE)  //XOR (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4092,20 +4739,20 @@ namespace rm {
                         Xor_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xB4:  //OR IXH
+                    case 0xB4: RM_Z80_OP(dd_B4)  //OR IXH
                                 // Log("OR IXH");
                     Or_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB5:  //OR IXL
+                    case 0xB5: RM_Z80_OP(dd_B5)  //OR IXL
                                 // Log("OR IXL");
                     Or_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB6:  //OR (regs.IX + d)
+                    case 0xB6: RM_Z80_OP(dd_B6)  //OR (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4117,20 +4764,20 @@ namespace rm {
                         Or_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xBC:  //CP IXH
+                    case 0xBC: RM_Z80_OP(dd_BC)  //CP IXH
                                 // Log("CP IXH");
                     Cp_R(regs.IXH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBD:  //CP IXL
+                    case 0xBD: RM_Z80_OP(dd_BD)  //CP IXL
                                 // Log("CP IXL");
                     Cp_R(regs.IXL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBE:  //CP (regs.IX + d)
+                    case 0xBE: RM_Z80_OP(dd_BE)  //CP (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4142,44 +4789,44 @@ namespace rm {
                         Cp_R(PeekByte(offset));
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x21:  //LD regs.IX, nn
+                    case 0x21: RM_Z80_OP(dd_21)  //LD regs.IX, nn
                                 // Log(string.Format("LD regs.IX, {0,-6:X}", PeekWord(regs.PC)));
                     regs.IX = PeekWord(regs.PC);
                     regs.PC += 2;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x22:  //LD (nn), regs.IX
+                    case 0x22: RM_Z80_OP(dd_22)  //LD (nn), regs.IX
                                 // Log(string.Format("LD ({0:X}), regs.IX", PeekWord(regs.PC)));
                     addr = PeekWord(regs.PC);
                     PokeWord(addr, regs.IX);
                     regs.PC += 2;
                     regs.MemPtr = (ushort)(addr + 1);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x26:  //LD IXH, n
+                    case 0x26: RM_Z80_OP(dd_26)  //LD IXH, n
                                 // Log(string.Format("LD IXH, {0:X}", PeekByte(regs.PC)));
                     regs.IXH = PeekByte(regs.PC);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2A:  //LD regs.IX, (nn)
+                    case 0x2A: RM_Z80_OP(dd_2A)  //LD regs.IX, (nn)
                                 // Log(string.Format("LD regs.IX, ({0:X})", PeekWord(regs.PC)));
                     addr = PeekWord(regs.PC);
                     regs.IX = PeekWord(addr);
                     regs.MemPtr = (ushort)(addr + 1);
                     regs.PC += 2;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2E:  //LD IXL, n
+                    case 0x2E: RM_Z80_OP(dd_2E)  //LD IXL, n
                                 // Log(string.Format("LD IXL, {0:X}", PeekByte(regs.PC)));
                     regs.IXL = PeekByte(regs.PC);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x36:  //LD (regs.IX + d), n
+                    case 0x36: RM_Z80_OP(dd_36)  //LD (regs.IX + d), n
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
 
@@ -4190,20 +4837,20 @@ namespace rm {
                         PokeByte(offset, b);
                         regs.MemPtr = offset;
                         regs.PC += 2;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x44:  //LD B, IXH
+                    case 0x44: RM_Z80_OP(dd_44)  //LD B, IXH
                                 // Log("LD B, IXH");
                     regs.B = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x45:  //LD B, IXL
+                    case 0x45: RM_Z80_OP(dd_45)  //LD B, IXL
                                 // Log("LD B, IXL");
                     regs.B = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x46:  //LD B, (regs.IX + d)
+                    case 0x46: RM_Z80_OP(dd_46)  //LD B, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4212,20 +4859,20 @@ namespace rm {
                         regs.B = PeekByte(offset);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x4C:  //LD C, IXH
+                    case 0x4C: RM_Z80_OP(dd_4C)  //LD C, IXH
                                 // Log("LD C, IXH");
                     regs.C = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4D:  //LD C, IXL
+                    case 0x4D: RM_Z80_OP(dd_4D)  //LD C, IXL
                                 // Log("LD C, IXL");
                     regs.C = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4E:  //LD C, (regs.IX + d)
+                    case 0x4E: RM_Z80_OP(dd_4E)  //LD C, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4235,21 +4882,21 @@ namespace rm {
                         regs.MemPtr = offset;
                         regs.PC++;
                     }
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x54:  //LD D, IXH
+                    case 0x54: RM_Z80_OP(dd_54)  //LD D, IXH
                                 // Log("LD D, IXH");
                                 //tstates += 4;
                     regs.D = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x55:  //LD D, IXL
+                    case 0x55: RM_Z80_OP(dd_55)  //LD D, IXL
                                 // Log("LD D, IXL");
                                 //tstates += 4;
                     regs.D = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x56:  //LD D, (regs.IX + d)
+                    case 0x56: RM_Z80_OP(dd_56)  //LD D, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4259,21 +4906,21 @@ namespace rm {
                         regs.MemPtr = offset;
                         regs.PC++;
                     }
-                        break;
+                        RM_Z80_NEXT;
 
-                    case 0x5C:  //LD E, IXH
+                    case 0x5C: RM_Z80_OP(dd_5C)  //LD E, IXH
                                 // Log("LD E, IXH");
                                 //tstates += 4;
                     regs.E = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5D:  //LD E, IXL
+                    case 0x5D: RM_Z80_OP(dd_5D)  //LD E, IXL
                                 // Log("LD E, IXL");
                                 //tstates += 4;
                     regs.E = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5E:  //LD E, (regs.IX + d)
+                    case 0x5E: RM_Z80_OP(dd_5E)  //LD E, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4282,47 +4929,47 @@ namespace rm {
                         regs.E = PeekByte(offset);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
                         
 
-                    case 0x60:  //LD IXH, B
+                    case 0x60: RM_Z80_OP(dd_60)  //LD IXH, B
                                 // Log("LD IXH, B");
                                 //tstates += 4;
                     regs.IXH = regs.B;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x61:  //LD IXH, C
+                    case 0x61: RM_Z80_OP(dd_61)  //LD IXH, C
                                 // Log("LD IXH, C");
                                 //tstates += 4;
                     regs.IXH = regs.C;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x62:  //LD IXH, D
+                    case 0x62: RM_Z80_OP(dd_62)  //LD IXH, D
                                 // Log("LD IXH, D");
                                 //tstates += 4;
                     regs.IXH = regs.D;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x63:  //LD IXH, E
+                    case 0x63: RM_Z80_OP(dd_63)  //LD IXH, E
                                 // Log("LD IXH, E");
                                 //tstates += 4;
                     regs.IXH = regs.E;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x64:  //LD IXH, IXH
+                    case 0x64: RM_Z80_OP(dd_64)  //LD IXH, IXH
                                 // Log("LD IXH, IXH");
                                 //tstates += 4;
                     regs.IXH = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x65:  //LD IXH, IXL
+                    case 0x65: RM_Z80_OP(dd_65)  //LD IXH, IXL
                                 // Log("LD IXH, IXL");
                                 //tstates += 4;
                     regs.IXH = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x66:  //LD H, (regs.IX + d)
+                    case 0x66: RM_Z80_OP(dd_66)  //LD H, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4331,51 +4978,51 @@ namespace rm {
                         regs.H = PeekByte(offset);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x67:  //LD IXH, A
+                    case 0x67: RM_Z80_OP(dd_67)  //LD IXH, A
                                 // Log("LD IXH, A");
                                 //tstates += 4;
                     regs.IXH = regs.A;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x68:  //LD IXL, B
+                    case 0x68: RM_Z80_OP(dd_68)  //LD IXL, B
                                 // Log("LD IXL, B");
                                 //tstates += 4;
                     regs.IXL = regs.B;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x69:  //LD IXL, C
+                    case 0x69: RM_Z80_OP(dd_69)  //LD IXL, C
                                 // Log("LD IXL, C");
                                 //tstates += 4;
                     regs.IXL = regs.C;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6A:  //LD IXL, D
+                    case 0x6A: RM_Z80_OP(dd_6A)  //LD IXL, D
                                 // Log("LD IXL, D");
                                 //tstates += 4;
                     regs.IXL = regs.D;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6B:  //LD IXL, E
+                    case 0x6B: RM_Z80_OP(dd_6B)  //LD IXL, E
                                 // Log("LD IXL, E");
                                 //tstates += 4;
                     regs.IXL = regs.E;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6C:  //LD IXL, IXH
+                    case 0x6C: RM_Z80_OP(dd_6C)  //LD IXL, IXH
                                 // Log("LD IXL, IXH");
                                 //tstates += 4;
                     regs.IXL = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6D:  //LD IXL, IXL
+                    case 0x6D: RM_Z80_OP(dd_6D)  //LD IXL, IXL
                                 // Log("LD IXL, IXL");
                                 //tstates += 4;
                     regs.IXL = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6E:  //LD L, (regs.IX + d)
+                    case 0x6E: RM_Z80_OP(dd_6E)  //LD L, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4384,16 +5031,16 @@ namespace rm {
                         regs.L = PeekByte(offset);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x6F:  //LD IXL, A
+                    case 0x6F: RM_Z80_OP(dd_6F)  //LD IXL, A
                                 // Log("LD IXL, A");
                                 //tstates += 4;
                     regs.IXL = regs.A;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x70:  //LD (regs.IX + d), B
+                    case 0x70: RM_Z80_OP(dd_70)  //LD (regs.IX + d), B
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4402,10 +5049,10 @@ namespace rm {
                         PokeByte(offset, regs.B);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x71:  //LD (regs.IX + d), C
+                    case 0x71: RM_Z80_OP(dd_71)  //LD (regs.IX + d), C
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4414,10 +5061,10 @@ namespace rm {
                         PokeByte(offset, regs.C);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x72:  //LD (regs.IX + d), D
+                    case 0x72: RM_Z80_OP(dd_72)  //LD (regs.IX + d), D
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4426,10 +5073,10 @@ namespace rm {
                         PokeByte(offset, regs.D);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x73:  //LD (regs.IX + d), E
+                    case 0x73: RM_Z80_OP(dd_73)  //LD (regs.IX + d), E
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4438,10 +5085,10 @@ namespace rm {
                         PokeByte(offset, regs.E);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x74:  //LD (regs.IX + d), H
+                    case 0x74: RM_Z80_OP(dd_74)  //LD (regs.IX + d), H
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4450,10 +5097,10 @@ namespace rm {
                         PokeByte(offset, regs.H);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x75:  //LD (regs.IX + d), L
+                    case 0x75: RM_Z80_OP(dd_75)  //LD (regs.IX + d), L
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4462,10 +5109,10 @@ namespace rm {
                         PokeByte(offset, regs.L);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x77:  //LD (regs.IX + d), A
+                    case 0x77: RM_Z80_OP(dd_77)  //LD (regs.IX + d), A
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4474,20 +5121,20 @@ namespace rm {
                         PokeByte(offset, regs.A);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x7C:  //LD A, IXH
+                    case 0x7C: RM_Z80_OP(dd_7C)  //LD A, IXH
                                 // Log("LD A, IXH");
                     regs.A = regs.IXH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7D:  //LD A, IXL
+                    case 0x7D: RM_Z80_OP(dd_7D)  //LD A, IXL
                                 // Log("LD A, IXL");
                     regs.A = regs.IXL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7E:  //LD A, (regs.IX + d)
+                    case 0x7E: RM_Z80_OP(dd_7E)  //LD A, (regs.IX + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IX + b); //The displacement required
@@ -4496,19 +5143,19 @@ namespace rm {
                         regs.A = PeekByte(offset);
                         regs.MemPtr = offset;
                         regs.PC++;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xF9:  //LD regs.SP, regs.IX
+                    case 0xF9: RM_Z80_OP(dd_F9)  //LD regs.SP, regs.IX
                                 // Log("LD regs.SP, regs.IX");
                     Contend(regs.IR(), 1, 2);
                     regs.SP = regs.IX;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCB: 
+                    case 0xCB: RM_Z80_OP(dd_CB) 
                      {
                             disp = GetDisplacement(PeekByte(regs.PC));
-                            ushort offset = (ushort)(regs.IX + disp); //The displacement required
+                            offset = (ushort)(regs.IX + disp); //The displacement required
                             regs.PC++;
                             //GetOpcode triggers memory execute event
                             //replacing with PeekByte for now
@@ -4516,1266 +5163,1267 @@ namespace rm {
                             opcode = PeekByte(regs.PC);
                             Contend(regs.PC, 1, 2);
                             regs.PC++;
-                            byte b = PeekByte(offset);
+                            b = PeekByte(offset);
                             Contend(offset, 1, 1);
                             // if ((opcode >= 0x40) && (opcode <= 0x7f))
                             regs.MemPtr = offset;
 
+                            RM_Z80_DISPATCH(ddcb, opcode);
                             switch(opcode) {
-                                case 0x00: //LD B, RLC (regs.IX+d)
+                                case 0x00: RM_Z80_OP(ddcb_00) //LD B, RLC (regs.IX+d)
                                            // Log(string.Format("LD B, RLC (regs.IX + {0:X})", disp));
                                 regs.B = Rlc_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x01: //LD C, RLC (regs.IX+d)
+                                case 0x01: RM_Z80_OP(ddcb_01) //LD C, RLC (regs.IX+d)
                                            // Log(string.Format("LD C, RLC (regs.IX + {0:X})", disp));
                                 regs.C = Rlc_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x02: //LD D, RLC (regs.IX+d)
+                                case 0x02: RM_Z80_OP(ddcb_02) //LD D, RLC (regs.IX+d)
                                            // Log(string.Format("LD D, RLC (regs.IX + {0:X})", disp));
                                 regs.D = Rlc_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x03: //LD E, RLC (regs.IX+d)
+                                case 0x03: RM_Z80_OP(ddcb_03) //LD E, RLC (regs.IX+d)
                                            // Log(string.Format("LD E, RLC (regs.IX + {0:X})", disp));
                                 regs.E = Rlc_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x04: //LD H, RLC (regs.IX+d)
+                                case 0x04: RM_Z80_OP(ddcb_04) //LD H, RLC (regs.IX+d)
                                            // Log(string.Format("LD H, RLC (regs.IX + {0:X})", disp));
                                 regs.H = Rlc_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x05: //LD L, RLC (regs.IX+d)
+                                case 0x05: RM_Z80_OP(ddcb_05) //LD L, RLC (regs.IX+d)
                                            // Log(string.Format("LD L, RLC (regs.IX + {0:X})", disp));
                                 regs.L = Rlc_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x06:  //RLC (regs.IX + d)
+                                case 0x06: RM_Z80_OP(ddcb_06)  //RLC (regs.IX + d)
                                             // Log(string.Format("RLC (regs.IX + {0:X})", disp));
                                 PokeByte(offset, Rlc_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x07: //LD A, RLC (regs.IX+d)
+                                case 0x07: RM_Z80_OP(ddcb_07) //LD A, RLC (regs.IX+d)
                                            // Log(string.Format("LD A, RLC (regs.IX + {0:X})", disp));
                                 regs.A = Rlc_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x08: //LD B, RRC (regs.IX+d)
+                                case 0x08: RM_Z80_OP(ddcb_08) //LD B, RRC (regs.IX+d)
                                            // Log(string.Format("LD B, RRC (regs.IX + {0:X})", disp));
                                 regs.B = Rrc_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x09: //LD C, RRC (regs.IX+d)
+                                case 0x09: RM_Z80_OP(ddcb_09) //LD C, RRC (regs.IX+d)
                                            // Log(string.Format("LD C, RRC (regs.IX + {0:X})", disp));
                                 regs.C = Rrc_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0A: //LD D, RRC (regs.IX+d)
+                                case 0x0A: RM_Z80_OP(ddcb_0A) //LD D, RRC (regs.IX+d)
                                            // Log(string.Format("LD D, RRC (regs.IX + {0:X})", disp));
                                 regs.D = Rrc_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0B: //LD E, RRC (regs.IX+d)
+                                case 0x0B: RM_Z80_OP(ddcb_0B) //LD E, RRC (regs.IX+d)
                                            // Log(string.Format("LD E, RRC (regs.IX + {0:X})", disp));
                                 regs.E = Rrc_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0C: //LD H, RRC (regs.IX+d)
+                                case 0x0C: RM_Z80_OP(ddcb_0C) //LD H, RRC (regs.IX+d)
                                            // Log(string.Format("LD H, RRC (regs.IX + {0:X})", disp));
                                 regs.H = Rrc_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0D: //LD L, RRC (regs.IX+d)
+                                case 0x0D: RM_Z80_OP(ddcb_0D) //LD L, RRC (regs.IX+d)
                                            // Log(string.Format("LD L, RRC (regs.IX + {0:X})", disp));
                                 regs.L = Rrc_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0E:  //RRC (regs.IX + d)
+                                case 0x0E: RM_Z80_OP(ddcb_0E)  //RRC (regs.IX + d)
                                             // Log(string.Format("RRC (regs.IX + {0:X})", disp));
                                 PokeByte(offset, Rrc_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x0F: //LD A, RRC (regs.IX+d)
+                                case 0x0F: RM_Z80_OP(ddcb_0F) //LD A, RRC (regs.IX+d)
                                            // Log(string.Format("LD A, RRC (regs.IX + {0:X})", disp));
                                 regs.A = Rrc_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x10: //LD B, RL (regs.IX+d)
+                                case 0x10: RM_Z80_OP(ddcb_10) //LD B, RL (regs.IX+d)
                                            // Log(string.Format("LD B, RL (regs.IX + {0:X})", disp));
                                 regs.B = Rl_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x11: //LD C, RL (regs.IX+d)
+                                case 0x11: RM_Z80_OP(ddcb_11) //LD C, RL (regs.IX+d)
                                            // Log(string.Format("LD C, RL (regs.IX + {0:X})", disp));
                                 regs.C = Rl_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x12: //LD D, RL (regs.IX+d)
+                                case 0x12: RM_Z80_OP(ddcb_12) //LD D, RL (regs.IX+d)
                                            // Log(string.Format("LD D, RL (regs.IX + {0:X})", disp));
                                 regs.D = Rl_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x13: //LD E, RL (regs.IX+d)
+                                case 0x13: RM_Z80_OP(ddcb_13) //LD E, RL (regs.IX+d)
                                            // Log(string.Format("LD E, RL (regs.IX + {0:X})", disp));
                                 regs.E = Rl_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x14: //LD H, RL (regs.IX+d)
+                                case 0x14: RM_Z80_OP(ddcb_14) //LD H, RL (regs.IX+d)
                                            // Log(string.Format("LD H, RL (regs.IX + {0:X})", disp));
                                 regs.H = Rl_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x15: //LD L, RL (regs.IX+d)
+                                case 0x15: RM_Z80_OP(ddcb_15) //LD L, RL (regs.IX+d)
                                            // Log(string.Format("LD L, RL (regs.IX + {0:X})", disp));
                                 regs.L = Rl_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x16:  //RL (regs.IX + d)
+                                case 0x16: RM_Z80_OP(ddcb_16)  //RL (regs.IX + d)
                                             // Log(string.Format("RL (regs.IX + {0:X})", disp));
                                 PokeByte(offset, Rl_R(b));
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x17: //LD A, RL (regs.IX+d)
+                                case 0x17: RM_Z80_OP(ddcb_17) //LD A, RL (regs.IX+d)
                                            // Log(string.Format("LD A, RL (regs.IX + {0:X})", disp));
                                 regs.A = Rl_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x18: //LD B, RR (regs.IX+d)
+                                case 0x18: RM_Z80_OP(ddcb_18) //LD B, RR (regs.IX+d)
                                            // Log(string.Format("LD B, RR (regs.IX + {0:X})", disp));
                                 regs.B = Rr_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x19: //LD C, RR (regs.IX+d)
+                                case 0x19: RM_Z80_OP(ddcb_19) //LD C, RR (regs.IX+d)
                                            // Log(string.Format("LD C, RR (regs.IX + {0:X})", disp));
                                 regs.C = Rr_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1A: //LD D, RR (regs.IX+d)
+                                case 0x1A: RM_Z80_OP(ddcb_1A) //LD D, RR (regs.IX+d)
                                            // Log(string.Format("LD D, RR (regs.IX + {0:X})", disp));
                                 regs.D = Rr_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1B: //LD E, RR (regs.IX+d)
+                                case 0x1B: RM_Z80_OP(ddcb_1B) //LD E, RR (regs.IX+d)
                                            // Log(string.Format("LD E, RR (regs.IX + {0:X})", disp));
                                 regs.E = Rr_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1C: //LD H, RR (regs.IX+d)
+                                case 0x1C: RM_Z80_OP(ddcb_1C) //LD H, RR (regs.IX+d)
                                            // Log(string.Format("LD H, RR (regs.IX + {0:X})", disp));
                                 regs.H = Rr_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1D: //LD L, RR (regs.IX+d)
+                                case 0x1D: RM_Z80_OP(ddcb_1D) //LD L, RR (regs.IX+d)
                                            // Log(string.Format("LD L, RR (regs.IX + {0:X})", disp));
                                 regs.L = Rr_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1E:  //RR (regs.IX + d)
+                                case 0x1E: RM_Z80_OP(ddcb_1E)  //RR (regs.IX + d)
                                             // Log(string.Format("RR (regs.IX + {0:X})", disp));
                                 PokeByte(offset, Rr_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x1F: //LD A, RR (regs.IX+d)
+                                case 0x1F: RM_Z80_OP(ddcb_1F) //LD A, RR (regs.IX+d)
                                            // Log(string.Format("LD A, RR (regs.IX + {0:X})", disp));
                                 regs.A = Rr_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x20: //LD B, SLA (regs.IX+d)
+                                case 0x20: RM_Z80_OP(ddcb_20) //LD B, SLA (regs.IX+d)
                                            // Log(string.Format("LD B, SLA (regs.IX + {0:X})", disp));
                                 regs.B = Sla_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x21: //LD C, SLA (regs.IX+d)
+                                case 0x21: RM_Z80_OP(ddcb_21) //LD C, SLA (regs.IX+d)
                                            // Log(string.Format("LD C, SLA (regs.IX + {0:X})", disp));
                                 regs.C = Sla_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x22: //LD D, SLA (regs.IX+d)
+                                case 0x22: RM_Z80_OP(ddcb_22) //LD D, SLA (regs.IX+d)
                                            // Log(string.Format("LD D, SLA (regs.IX + {0:X})", disp));
                                 regs.D = Sla_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x23: //LD E, SLA (regs.IX+d)
+                                case 0x23: RM_Z80_OP(ddcb_23) //LD E, SLA (regs.IX+d)
                                            // Log(string.Format("LD E, SLA (regs.IX + {0:X})", b));
                                 regs.E = Sla_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x24: //LD H, SLA (regs.IX+d)
+                                case 0x24: RM_Z80_OP(ddcb_24) //LD H, SLA (regs.IX+d)
                                            // Log(string.Format("LD H, SLA (regs.IX + {0:X})", b));
                                 regs.H = Sla_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x25: //LD L, SLA (regs.IX+d)
+                                case 0x25: RM_Z80_OP(ddcb_25) //LD L, SLA (regs.IX+d)
                                            // Log(string.Format("LD L, SLA (regs.IX + {0:X})", b));
                                 regs.L = Sla_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x26:  //SLA (regs.IX + d)
+                                case 0x26: RM_Z80_OP(ddcb_26)  //SLA (regs.IX + d)
                                             // Log(string.Format("SLA (regs.IX + {0:X})", b));
                                 PokeByte(offset, Sla_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x27: //LD A, SLA (regs.IX+d)
+                                case 0x27: RM_Z80_OP(ddcb_27) //LD A, SLA (regs.IX+d)
                                            // Log(string.Format("LD A, SLA (regs.IX + {0:X})", b));
                                 regs.A = Sla_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x28: //LD B, SRA (regs.IX+d)
+                                case 0x28: RM_Z80_OP(ddcb_28) //LD B, SRA (regs.IX+d)
                                            // Log(string.Format("LD B, SRA (regs.IX + {0:X})", b));
                                 regs.B = Sra_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x29: //LD C, SRA (regs.IX+d)
+                                case 0x29: RM_Z80_OP(ddcb_29) //LD C, SRA (regs.IX+d)
                                            // Log(string.Format("LD C, SRA (regs.IX + {0:X})", b));
                                 regs.C = Sra_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2A: //LD D, SRA (regs.IX+d)
+                                case 0x2A: RM_Z80_OP(ddcb_2A) //LD D, SRA (regs.IX+d)
                                            // Log(string.Format("LD D, SRA (regs.IX + {0:X})", b));
                                 regs.D = Sra_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2B: //LD E, SRA (regs.IX+d)
+                                case 0x2B: RM_Z80_OP(ddcb_2B) //LD E, SRA (regs.IX+d)
                                            // Log(string.Format("LD E, SRA (regs.IX + {0:X})", b));
                                 regs.E = Sra_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2C: //LD H, SRA (regs.IX+d)
+                                case 0x2C: RM_Z80_OP(ddcb_2C) //LD H, SRA (regs.IX+d)
                                            // Log(string.Format("LD H, SRA (regs.IX + {0:X})", b));
                                 regs.H = Sra_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2D: //LD L, SRA (regs.IX+d)
+                                case 0x2D: RM_Z80_OP(ddcb_2D) //LD L, SRA (regs.IX+d)
                                            // Log(string.Format("LD L, SRA (regs.IX + {0:X})", b));
                                 regs.L = Sra_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2E:  //SRA (regs.IX + d)
+                                case 0x2E: RM_Z80_OP(ddcb_2E)  //SRA (regs.IX + d)
                                             // Log(string.Format("SRA (regs.IX + {0:X})", b));
                                 PokeByte(offset, Sra_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x2F: //LD A, SRA (regs.IX+d)
+                                case 0x2F: RM_Z80_OP(ddcb_2F) //LD A, SRA (regs.IX+d)
                                            // Log(string.Format("LD A, SRA (regs.IX + {0:X})", b));
                                 regs.A = Sra_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x30: //LD B, SLL (regs.IX+d)
+                                case 0x30: RM_Z80_OP(ddcb_30) //LD B, SLL (regs.IX+d)
                                            // Log(string.Format("LD B, SLL (regs.IX + {0:X})", b));
                                 regs.B = Sll_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x31: //LD C, SLL (regs.IX+d)
+                                case 0x31: RM_Z80_OP(ddcb_31) //LD C, SLL (regs.IX+d)
                                            // Log(string.Format("LD C, SLL (regs.IX + {0:X})", b));
                                 regs.C = Sll_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x32: //LD D, SLL (regs.IX+d)
+                                case 0x32: RM_Z80_OP(ddcb_32) //LD D, SLL (regs.IX+d)
                                            // Log(string.Format("LD D, SLL (regs.IX + {0:X})", b));
                                 regs.D = Sll_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x33: //LD E, SLL (regs.IX+d)
+                                case 0x33: RM_Z80_OP(ddcb_33) //LD E, SLL (regs.IX+d)
                                            // Log(string.Format("LD E, SLL (regs.IX + {0:X})", b));
                                 regs.E = Sll_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x34: //LD H, SLL (regs.IX+d)
+                                case 0x34: RM_Z80_OP(ddcb_34) //LD H, SLL (regs.IX+d)
                                            // Log(string.Format("LD H, SLL (regs.IX + {0:X})", b));
                                 regs.H = Sll_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x35: //LD L, SLL (regs.IX+d)
+                                case 0x35: RM_Z80_OP(ddcb_35) //LD L, SLL (regs.IX+d)
                                            // Log(string.Format("LD L, SLL (regs.IX + {0:X})", b));
                                 regs.L = Sll_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x36:  //SLL (regs.IX + d)
+                                case 0x36: RM_Z80_OP(ddcb_36)  //SLL (regs.IX + d)
                                             // Log(string.Format("SLL (regs.IX + {0:X})", b));
                                 PokeByte(offset, Sll_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x37: //LD A, SLL (regs.IX+d)
+                                case 0x37: RM_Z80_OP(ddcb_37) //LD A, SLL (regs.IX+d)
                                            // Log(string.Format("LD A, SLL (regs.IX + {0:X})", b));
                                 regs.A = Sll_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x38: //LD B, SRL (regs.IX+d)
+                                case 0x38: RM_Z80_OP(ddcb_38) //LD B, SRL (regs.IX+d)
                                            // Log(string.Format("LD B, SRL (regs.IX + {0:X})", b));
                                 regs.B = Srl_R(b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x39: //LD C, SRL (regs.IX+d)
+                                case 0x39: RM_Z80_OP(ddcb_39) //LD C, SRL (regs.IX+d)
                                            // Log(string.Format("LD C, SRL (regs.IX + {0:X})", b));
                                 regs.C = Srl_R(b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3A: //LD D, SRL (regs.IX+d)
+                                case 0x3A: RM_Z80_OP(ddcb_3A) //LD D, SRL (regs.IX+d)
                                            // Log(string.Format("LD D, SRL (regs.IX + {0:X})", b));
                                 regs.D = Srl_R(b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3B: //LD E, SRL (regs.IX+d)
+                                case 0x3B: RM_Z80_OP(ddcb_3B) //LD E, SRL (regs.IX+d)
                                            // Log(string.Format("LD E, SRL (regs.IX + {0:X})", b));
                                 regs.E = Srl_R(b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3C: //LD H, SRL (regs.IX+d)
+                                case 0x3C: RM_Z80_OP(ddcb_3C) //LD H, SRL (regs.IX+d)
                                            // Log(string.Format("LD H, SRL (regs.IX + {0:X})", b));
                                 regs.H = Srl_R(b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3D: //LD L, SRL (regs.IX+d)
+                                case 0x3D: RM_Z80_OP(ddcb_3D) //LD L, SRL (regs.IX+d)
                                            // Log(string.Format("LD L, SRL (regs.IX + {0:X})", b));
                                 regs.L = Srl_R(b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3E:  //SRL (regs.IX + d)
+                                case 0x3E: RM_Z80_OP(ddcb_3E)  //SRL (regs.IX + d)
                                             // Log(string.Format("SRL (regs.IX + {0:X})", b));
                                 PokeByte(offset, Srl_R(b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x3F: //LD A, SRL (regs.IX+d)
+                                case 0x3F: RM_Z80_OP(ddcb_3F) //LD A, SRL (regs.IX+d)
                                            // Log(string.Format("LD A, SRL (regs.IX + {0:X})", b));
                                 regs.A = Srl_R(b);
                                 PokeByte(offset, regs.A);
-                                break;
-
-                                case 0x40:  //BIT 0, (regs.IX + d)
-                                case 0x41:  //BIT 0, (regs.IX + d)
-                                case 0x42:  //BIT 0, (regs.IX + d)
-                                case 0x43:  //BIT 0, (regs.IX + d)
-                                case 0x44:  //BIT 0, (regs.IX + d)
-                                case 0x45:  //BIT 0, (regs.IX + d)
-                                case 0x46:  //BIT 0, (regs.IX + d)
-                                case 0x47:  //BIT 0, (regs.IX + d)
+                                RM_Z80_NEXT;
+
+                                case 0x40: RM_Z80_OP(ddcb_40)  //BIT 0, (regs.IX + d)
+                                case 0x41: RM_Z80_OP(ddcb_41)  //BIT 0, (regs.IX + d)
+                                case 0x42: RM_Z80_OP(ddcb_42)  //BIT 0, (regs.IX + d)
+                                case 0x43: RM_Z80_OP(ddcb_43)  //BIT 0, (regs.IX + d)
+                                case 0x44: RM_Z80_OP(ddcb_44)  //BIT 0, (regs.IX + d)
+                                case 0x45: RM_Z80_OP(ddcb_45)  //BIT 0, (regs.IX + d)
+                                case 0x46: RM_Z80_OP(ddcb_46)  //BIT 0, (regs.IX + d)
+                                case 0x47: RM_Z80_OP(ddcb_47)  //BIT 0, (regs.IX + d)
                                             // Log(string.Format("BIT 0, (regs.IX + {0:X})", disp));
                                 Bit_MemPtr(0, b);
                                 
-                                break;
-
-                                case 0x48:  //BIT 1, (regs.IX + d)
-                                case 0x49:  //BIT 1, (regs.IX + d)
-                                case 0x4A:  //BIT 1, (regs.IX + d)
-                                case 0x4B:  //BIT 1, (regs.IX + d)
-                                case 0x4C:  //BIT 1, (regs.IX + d)
-                                case 0x4D:  //BIT 1, (regs.IX + d)
-                                case 0x4E:  //BIT 1, (regs.IX + d)
-                                case 0x4F:  //BIT 1, (regs.IX + d)
+                                RM_Z80_NEXT;
+
+                                case 0x48: RM_Z80_OP(ddcb_48)  //BIT 1, (regs.IX + d)
+                                case 0x49: RM_Z80_OP(ddcb_49)  //BIT 1, (regs.IX + d)
+                                case 0x4A: RM_Z80_OP(ddcb_4A)  //BIT 1, (regs.IX + d)
+                                case 0x4B: RM_Z80_OP(ddcb_4B)  //BIT 1, (regs.IX + d)
+                                case 0x4C: RM_Z80_OP(ddcb_4C)  //BIT 1, (regs.IX + d)
+                                case 0x4D: RM_Z80_OP(ddcb_4D)  //BIT 1, (regs.IX + d)
+                                case 0x4E: RM_Z80_OP(ddcb_4E)  //BIT 1, (regs.IX + d)
+                                case 0x4F: RM_Z80_OP(ddcb_4F)  //BIT 1, (regs.IX + d)
                                             // Log(string.Format("BIT 1, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(1, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x50:  //BIT 2, (regs.IX + d)
-                                case 0x51:  //BIT 2, (regs.IX + d)
-                                case 0x52:  //BIT 2, (regs.IX + d)
-                                case 0x53:  //BIT 2, (regs.IX + d)
-                                case 0x54:  //BIT 2, (regs.IX + d)
-                                case 0x55:  //BIT 2, (regs.IX + d)
-                                case 0x56:  //BIT 2, (regs.IX + d)
-                                case 0x57:  //BIT 2, (regs.IX + d)
+                                case 0x50: RM_Z80_OP(ddcb_50)  //BIT 2, (regs.IX + d)
+                                case 0x51: RM_Z80_OP(ddcb_51)  //BIT 2, (regs.IX + d)
+                                case 0x52: RM_Z80_OP(ddcb_52)  //BIT 2, (regs.IX + d)
+                                case 0x53: RM_Z80_OP(ddcb_53)  //BIT 2, (regs.IX + d)
+                                case 0x54: RM_Z80_OP(ddcb_54)  //BIT 2, (regs.IX + d)
+                                case 0x55: RM_Z80_OP(ddcb_55)  //BIT 2, (regs.IX + d)
+                                case 0x56: RM_Z80_OP(ddcb_56)  //BIT 2, (regs.IX + d)
+                                case 0x57: RM_Z80_OP(ddcb_57)  //BIT 2, (regs.IX + d)
                                             // Log(string.Format("BIT 2, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(2, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x58:  //BIT 3, (regs.IX + d)
-                                case 0x59:  //BIT 3, (regs.IX + d)
-                                case 0x5A:  //BIT 3, (regs.IX + d)
-                                case 0x5B:  //BIT 3, (regs.IX + d)
-                                case 0x5C:  //BIT 3, (regs.IX + d)
-                                case 0x5D:  //BIT 3, (regs.IX + d)
-                                case 0x5E:  //BIT 3, (regs.IX + d)
-                                case 0x5F:  //BIT 3, (regs.IX + d)
+                                case 0x58: RM_Z80_OP(ddcb_58)  //BIT 3, (regs.IX + d)
+                                case 0x59: RM_Z80_OP(ddcb_59)  //BIT 3, (regs.IX + d)
+                                case 0x5A: RM_Z80_OP(ddcb_5A)  //BIT 3, (regs.IX + d)
+                                case 0x5B: RM_Z80_OP(ddcb_5B)  //BIT 3, (regs.IX + d)
+                                case 0x5C: RM_Z80_OP(ddcb_5C)  //BIT 3, (regs.IX + d)
+                                case 0x5D: RM_Z80_OP(ddcb_5D)  //BIT 3, (regs.IX + d)
+                                case 0x5E: RM_Z80_OP(ddcb_5E)  //BIT 3, (regs.IX + d)
+                                case 0x5F: RM_Z80_OP(ddcb_5F)  //BIT 3, (regs.IX + d)
                                             // Log(string.Format("BIT 3, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(3, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x60:  //BIT 4, (regs.IX + d)
-                                case 0x61:  //BIT 4, (regs.IX + d)
-                                case 0x62:  //BIT 4, (regs.IX + d)
-                                case 0x63:  //BIT 4, (regs.IX + d)
-                                case 0x64:  //BIT 4, (regs.IX + d)
-                                case 0x65:  //BIT 4, (regs.IX + d)
-                                case 0x66:  //BIT 4, (regs.IX + d)
-                                case 0x67:  //BIT 4, (regs.IX + d)
+                                case 0x60: RM_Z80_OP(ddcb_60)  //BIT 4, (regs.IX + d)
+                                case 0x61: RM_Z80_OP(ddcb_61)  //BIT 4, (regs.IX + d)
+                                case 0x62: RM_Z80_OP(ddcb_62)  //BIT 4, (regs.IX + d)
+                                case 0x63: RM_Z80_OP(ddcb_63)  //BIT 4, (regs.IX + d)
+                                case 0x64: RM_Z80_OP(ddcb_64)  //BIT 4, (regs.IX + d)
+                                case 0x65: RM_Z80_OP(ddcb_65)  //BIT 4, (regs.IX + d)
+                                case 0x66: RM_Z80_OP(ddcb_66)  //BIT 4, (regs.IX + d)
+                                case 0x67: RM_Z80_OP(ddcb_67)  //BIT 4, (regs.IX + d)
                                             // Log(string.Format("BIT 4, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(4, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x68:  //BIT 5, (regs.IX + d)
-                                case 0x69:  //BIT 5, (regs.IX + d)
-                                case 0x6A:  //BIT 5, (regs.IX + d)
-                                case 0x6B:  //BIT 5, (regs.IX + d)
-                                case 0x6C:  //BIT 5, (regs.IX + d)
-                                case 0x6D:  //BIT 5, (regs.IX + d)
-                                case 0x6E:  //BIT 5, (regs.IX + d)
-                                case 0x6F:  //BIT 5, (regs.IX + d)
+                                case 0x68: RM_Z80_OP(ddcb_68)  //BIT 5, (regs.IX + d)
+                                case 0x69: RM_Z80_OP(ddcb_69)  //BIT 5, (regs.IX + d)
+                                case 0x6A: RM_Z80_OP(ddcb_6A)  //BIT 5, (regs.IX + d)
+                                case 0x6B: RM_Z80_OP(ddcb_6B)  //BIT 5, (regs.IX + d)
+                                case 0x6C: RM_Z80_OP(ddcb_6C)  //BIT 5, (regs.IX + d)
+                                case 0x6D: RM_Z80_OP(ddcb_6D)  //BIT 5, (regs.IX + d)
+                                case 0x6E: RM_Z80_OP(ddcb_6E)  //BIT 5, (regs.IX + d)
+                                case 0x6F: RM_Z80_OP(ddcb_6F)  //BIT 5, (regs.IX + d)
                                             // Log(string.Format("BIT 5, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(5, b); ;
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x70://BIT 6, (regs.IX + d)
-                                case 0x71://BIT 6, (regs.IX + d)
-                                case 0x72://BIT 6, (regs.IX + d)
-                                case 0x73://BIT 6, (regs.IX + d)
-                                case 0x74://BIT 6, (regs.IX + d)
-                                case 0x75://BIT 6, (regs.IX + d)
-                                case 0x76://BIT 6, (regs.IX + d)
-                                case 0x77:  //BIT 6, (regs.IX + d)
+                                case 0x70: RM_Z80_OP(ddcb_70)//BIT 6, (regs.IX + d)
+                                case 0x71: RM_Z80_OP(ddcb_71)//BIT 6, (regs.IX + d)
+                                case 0x72: RM_Z80_OP(ddcb_72)//BIT 6, (regs.IX + d)
+                                case 0x73: RM_Z80_OP(ddcb_73)//BIT 6, (regs.IX + d)
+                                case 0x74: RM_Z80_OP(ddcb_74)//BIT 6, (regs.IX + d)
+                                case 0x75: RM_Z80_OP(ddcb_75)//BIT 6, (regs.IX + d)
+                                case 0x76: RM_Z80_OP(ddcb_76)//BIT 6, (regs.IX + d)
+                                case 0x77: RM_Z80_OP(ddcb_77)  //BIT 6, (regs.IX + d)
                                             // Log(string.Format("BIT 6, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(6, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x78:  //BIT 7, (regs.IX + d)
-                                case 0x79:  //BIT 7, (regs.IX + d)
-                                case 0x7A:  //BIT 7, (regs.IX + d)
-                                case 0x7B:  //BIT 7, (regs.IX + d)
-                                case 0x7C:  //BIT 7, (regs.IX + d)
-                                case 0x7D:  //BIT 7, (regs.IX + d)
-                                case 0x7E:  //BIT 7, (regs.IX + d)
-                                case 0x7F:  //BIT 7, (regs.IX + d)
+                                case 0x78: RM_Z80_OP(ddcb_78)  //BIT 7, (regs.IX + d)
+                                case 0x79: RM_Z80_OP(ddcb_79)  //BIT 7, (regs.IX + d)
+                                case 0x7A: RM_Z80_OP(ddcb_7A)  //BIT 7, (regs.IX + d)
+                                case 0x7B: RM_Z80_OP(ddcb_7B)  //BIT 7, (regs.IX + d)
+                                case 0x7C: RM_Z80_OP(ddcb_7C)  //BIT 7, (regs.IX + d)
+                                case 0x7D: RM_Z80_OP(ddcb_7D)  //BIT 7, (regs.IX + d)
+                                case 0x7E: RM_Z80_OP(ddcb_7E)  //BIT 7, (regs.IX + d)
+                                case 0x7F: RM_Z80_OP(ddcb_7F)  //BIT 7, (regs.IX + d)
                                             // Log(string.Format("BIT 7, (regs.IX + {0:X})", b));
                                 Bit_MemPtr(7, b);
 
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x80: //LD B, RES 0, (regs.IX+d)
+                                case 0x80: RM_Z80_OP(ddcb_80) //LD B, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 0, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(0, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x81: //LD C, RES 0, (regs.IX+d)
+                                case 0x81: RM_Z80_OP(ddcb_81) //LD C, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 0, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(0, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x82: //LD D, RES 0, (regs.IX+d)
+                                case 0x82: RM_Z80_OP(ddcb_82) //LD D, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 0, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(0, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x83: //LD E, RES 0, (regs.IX+d)
+                                case 0x83: RM_Z80_OP(ddcb_83) //LD E, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 0, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(0, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x84: //LD H, RES 0, (regs.IX+d)
+                                case 0x84: RM_Z80_OP(ddcb_84) //LD H, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 0, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(0, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x85: //LD L, RES 0, (regs.IX+d)
+                                case 0x85: RM_Z80_OP(ddcb_85) //LD L, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 0, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(0, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x86:  //RES 0, (regs.IX + d)
+                                case 0x86: RM_Z80_OP(ddcb_86)  //RES 0, (regs.IX + d)
                                             // Log(string.Format("RES 0, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(0, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x87: //LD A, RES 0, (regs.IX+d)
+                                case 0x87: RM_Z80_OP(ddcb_87) //LD A, RES 0, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 0, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(0, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x88: //LD B, RES 1, (regs.IX+d)
+                                case 0x88: RM_Z80_OP(ddcb_88) //LD B, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 1, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(1, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x89: //LD C, RES 1, (regs.IX+d)
+                                case 0x89: RM_Z80_OP(ddcb_89) //LD C, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 1, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(1, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8A: //LD D, RES 1, (regs.IX+d)
+                                case 0x8A: RM_Z80_OP(ddcb_8A) //LD D, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 1, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(1, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8B: //LD E, RES 1, (regs.IX+d)
+                                case 0x8B: RM_Z80_OP(ddcb_8B) //LD E, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 1, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(1, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8C: //LD H, RES 1, (regs.IX+d)
+                                case 0x8C: RM_Z80_OP(ddcb_8C) //LD H, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 1, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(1, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8D: //LD L, RES 1, (regs.IX+d)
+                                case 0x8D: RM_Z80_OP(ddcb_8D) //LD L, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 1, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(1, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8E:  //RES 1, (regs.IX + d)
+                                case 0x8E: RM_Z80_OP(ddcb_8E)  //RES 1, (regs.IX + d)
                                             // Log(string.Format("RES 1, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(1, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x8F: //LD A, RES 1, (regs.IX+d)
+                                case 0x8F: RM_Z80_OP(ddcb_8F) //LD A, RES 1, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 1, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(1, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x90: //LD B, RES 2, (regs.IX+d)
+                                case 0x90: RM_Z80_OP(ddcb_90) //LD B, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 2, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(2, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x91: //LD C, RES 2, (regs.IX+d)
+                                case 0x91: RM_Z80_OP(ddcb_91) //LD C, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 2, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(2, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x92: //LD D, RES 2, (regs.IX+d)
+                                case 0x92: RM_Z80_OP(ddcb_92) //LD D, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 2, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(2, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x93: //LD E, RES 2, (regs.IX+d)
+                                case 0x93: RM_Z80_OP(ddcb_93) //LD E, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 2, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(2, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x94: //LD H, RES 2, (regs.IX+d)
+                                case 0x94: RM_Z80_OP(ddcb_94) //LD H, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 2, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(2, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x95: //LD L, RES 2, (regs.IX+d)
+                                case 0x95: RM_Z80_OP(ddcb_95) //LD L, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 2, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(2, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x96:  //RES 2, (regs.IX + d)
+                                case 0x96: RM_Z80_OP(ddcb_96)  //RES 2, (regs.IX + d)
                                             // Log(string.Format("RES 2, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(2, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x97: //LD A, RES 2, (regs.IX+d)
+                                case 0x97: RM_Z80_OP(ddcb_97) //LD A, RES 2, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 2, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(2, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x98: //LD B, RES 3, (regs.IX+d)
+                                case 0x98: RM_Z80_OP(ddcb_98) //LD B, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 3, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(3, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x99: //LD C, RES 3, (regs.IX+d)
+                                case 0x99: RM_Z80_OP(ddcb_99) //LD C, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 3, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(3, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9A: //LD D, RES 3, (regs.IX+d)
+                                case 0x9A: RM_Z80_OP(ddcb_9A) //LD D, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 3, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(3, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9B: //LD E, RES 3, (regs.IX+d)
+                                case 0x9B: RM_Z80_OP(ddcb_9B) //LD E, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 3, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(3, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9C: //LD H, RES 3, (regs.IX+d)
+                                case 0x9C: RM_Z80_OP(ddcb_9C) //LD H, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 3, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(3, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9D: //LD L, RES 3, (regs.IX+d)
+                                case 0x9D: RM_Z80_OP(ddcb_9D) //LD L, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 3, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(3, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9E:  //RES 3, (regs.IX + d)
+                                case 0x9E: RM_Z80_OP(ddcb_9E)  //RES 3, (regs.IX + d)
                                             // Log(string.Format("RES 3, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(3, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0x9F: //LD A, RES 3, (regs.IX+d)
+                                case 0x9F: RM_Z80_OP(ddcb_9F) //LD A, RES 3, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 3, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(3, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA0: //LD B, RES 4, (regs.IX+d)
+                                case 0xA0: RM_Z80_OP(ddcb_A0) //LD B, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 4, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(4, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA1: //LD C, RES 4, (regs.IX+d)
+                                case 0xA1: RM_Z80_OP(ddcb_A1) //LD C, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 4, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(4, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA2: //LD D, RES 4, (regs.IX+d)
+                                case 0xA2: RM_Z80_OP(ddcb_A2) //LD D, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 4, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(4, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA3: //LD E, RES 4, (regs.IX+d)
+                                case 0xA3: RM_Z80_OP(ddcb_A3) //LD E, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 4, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(4, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA4: //LD H, RES 4, (regs.IX+d)
+                                case 0xA4: RM_Z80_OP(ddcb_A4) //LD H, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 4, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(4, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA5: //LD L, RES 4, (regs.IX+d)
+                                case 0xA5: RM_Z80_OP(ddcb_A5) //LD L, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 4, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(4, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA6:  //RES 4, (regs.IX + d)
+                                case 0xA6: RM_Z80_OP(ddcb_A6)  //RES 4, (regs.IX + d)
                                             // Log(string.Format("RES 4, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(4, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA7: //LD A, RES 4, (regs.IX+d)
+                                case 0xA7: RM_Z80_OP(ddcb_A7) //LD A, RES 4, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 4, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(4, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA8: //LD B, RES 5, (regs.IX+d)
+                                case 0xA8: RM_Z80_OP(ddcb_A8) //LD B, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 5, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(5, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xA9: //LD C, RES 5, (regs.IX+d)
+                                case 0xA9: RM_Z80_OP(ddcb_A9) //LD C, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 5, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(5, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAA: //LD D, RES 5, (regs.IX+d)
+                                case 0xAA: RM_Z80_OP(ddcb_AA) //LD D, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 5, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(5, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAB: //LD E, RES 5, (regs.IX+d)
+                                case 0xAB: RM_Z80_OP(ddcb_AB) //LD E, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 5, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(5, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAC: //LD H, RES 5, (regs.IX+d)
+                                case 0xAC: RM_Z80_OP(ddcb_AC) //LD H, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 5, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(5, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAD: //LD L, RES 5, (regs.IX+d)
+                                case 0xAD: RM_Z80_OP(ddcb_AD) //LD L, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 5, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(5, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAE:  //RES 5, (regs.IX + d)
+                                case 0xAE: RM_Z80_OP(ddcb_AE)  //RES 5, (regs.IX + d)
                                             // Log(string.Format("RES 5, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(5, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xAF: //LD A, RES 5, (regs.IX+d)
+                                case 0xAF: RM_Z80_OP(ddcb_AF) //LD A, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 5, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(5, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB0: //LD B, RES 6, (regs.IX+d)
+                                case 0xB0: RM_Z80_OP(ddcb_B0) //LD B, RES 6, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 6, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(6, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB1: //LD C, RES 6, (regs.IX+d)
+                                case 0xB1: RM_Z80_OP(ddcb_B1) //LD C, RES 6, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 6, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(6, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB2: //LD D, RES 6, (regs.IX+d)
+                                case 0xB2: RM_Z80_OP(ddcb_B2) //LD D, RES 6, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 6, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(6, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB3: //LD E, RES 6, (regs.IX+d)
+                                case 0xB3: RM_Z80_OP(ddcb_B3) //LD E, RES 6, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 6, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(6, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB4: //LD H, RES 5, (regs.IX+d)
+                                case 0xB4: RM_Z80_OP(ddcb_B4) //LD H, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 6, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(6, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB5: //LD L, RES 5, (regs.IX+d)
+                                case 0xB5: RM_Z80_OP(ddcb_B5) //LD L, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 6, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(6, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB6:  //RES 6, (regs.IX + d)
+                                case 0xB6: RM_Z80_OP(ddcb_B6)  //RES 6, (regs.IX + d)
                                             // Log(string.Format("RES 6, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(6, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB7: //LD A, RES 5, (regs.IX+d)
+                                case 0xB7: RM_Z80_OP(ddcb_B7) //LD A, RES 5, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 6, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(6, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB8: //LD B, RES 7, (regs.IX+d)
+                                case 0xB8: RM_Z80_OP(ddcb_B8) //LD B, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD B, RES 7, (regs.IX + {0:X})", b));
                                 regs.B = Res_R(7, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xB9: //LD C, RES 7, (regs.IX+d)
+                                case 0xB9: RM_Z80_OP(ddcb_B9) //LD C, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD C, RES 7, (regs.IX + {0:X})", b));
                                 regs.C = Res_R(7, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBA: //LD D, RES 7, (regs.IX+d)
+                                case 0xBA: RM_Z80_OP(ddcb_BA) //LD D, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD D, RES 7, (regs.IX + {0:X})", b));
                                 regs.D = Res_R(7, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBB: //LD E, RES 7, (regs.IX+d)
+                                case 0xBB: RM_Z80_OP(ddcb_BB) //LD E, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD E, RES 7, (regs.IX + {0:X})", b));
                                 regs.E = Res_R(7, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBC: //LD H, RES 7, (regs.IX+d)
+                                case 0xBC: RM_Z80_OP(ddcb_BC) //LD H, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD H, RES 7, (regs.IX + {0:X})", b));
                                 regs.H = Res_R(7, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBD: //LD L, RES 7, (regs.IX+d)
+                                case 0xBD: RM_Z80_OP(ddcb_BD) //LD L, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD L, RES 7, (regs.IX + {0:X})", b));
                                 regs.L = Res_R(7, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBE:  //RES 7, (regs.IX + d)
+                                case 0xBE: RM_Z80_OP(ddcb_BE)  //RES 7, (regs.IX + d)
                                             // Log(string.Format("RES 7, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Res_R(7, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xBF: //LD A, RES 7, (regs.IX+d)
+                                case 0xBF: RM_Z80_OP(ddcb_BF) //LD A, RES 7, (regs.IX+d)
                                            // Log(string.Format("LD A, RES 7, (regs.IX + {0:X})", b));
                                 regs.A = Res_R(7, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC0: //LD B, SET 0, (regs.IX+d)
+                                case 0xC0: RM_Z80_OP(ddcb_C0) //LD B, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 0, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(0, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC1: //LD C, SET 0, (regs.IX+d)
+                                case 0xC1: RM_Z80_OP(ddcb_C1) //LD C, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 0, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(0, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC2: //LD D, SET 0, (regs.IX+d)
+                                case 0xC2: RM_Z80_OP(ddcb_C2) //LD D, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 0, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(0, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC3: //LD E, SET 0, (regs.IX+d)
+                                case 0xC3: RM_Z80_OP(ddcb_C3) //LD E, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 0, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(0, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC4: //LD H, SET 0, (regs.IX+d)
+                                case 0xC4: RM_Z80_OP(ddcb_C4) //LD H, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 0, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(0, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC5: //LD L, SET 0, (regs.IX+d)
+                                case 0xC5: RM_Z80_OP(ddcb_C5) //LD L, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 0, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(0, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC6:  //SET 0, (regs.IX + d)
+                                case 0xC6: RM_Z80_OP(ddcb_C6)  //SET 0, (regs.IX + d)
                                             // Log(string.Format("SET 0, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(0, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC7: //LD A, SET 0, (regs.IX+d)
+                                case 0xC7: RM_Z80_OP(ddcb_C7) //LD A, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 0, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(0, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC8: //LD B, SET 1, (regs.IX+d)
+                                case 0xC8: RM_Z80_OP(ddcb_C8) //LD B, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 1, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(1, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xC9: //LD C, SET 0, (regs.IX+d)
+                                case 0xC9: RM_Z80_OP(ddcb_C9) //LD C, SET 0, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 1, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(1, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCA: //LD D, SET 1, (regs.IX+d)
+                                case 0xCA: RM_Z80_OP(ddcb_CA) //LD D, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 1, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(1, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCB: //LD E, SET 1, (regs.IX+d)
+                                case 0xCB: RM_Z80_OP(ddcb_CB) //LD E, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 1, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(1, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCC: //LD H, SET 1, (regs.IX+d)
+                                case 0xCC: RM_Z80_OP(ddcb_CC) //LD H, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 1, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(1, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCD: //LD L, SET 1, (regs.IX+d)
+                                case 0xCD: RM_Z80_OP(ddcb_CD) //LD L, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 1, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(1, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCE:  //SET 1, (regs.IX + d)
+                                case 0xCE: RM_Z80_OP(ddcb_CE)  //SET 1, (regs.IX + d)
                                             // Log(string.Format("SET 1, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(1, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xCF: //LD A, SET 1, (regs.IX+d)
+                                case 0xCF: RM_Z80_OP(ddcb_CF) //LD A, SET 1, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 1, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(1, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD0: //LD B, SET 2, (regs.IX+d)
+                                case 0xD0: RM_Z80_OP(ddcb_D0) //LD B, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 2, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(2, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD1: //LD C, SET 2, (regs.IX+d)
+                                case 0xD1: RM_Z80_OP(ddcb_D1) //LD C, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 2, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(2, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD2: //LD D, SET 2, (regs.IX+d)
+                                case 0xD2: RM_Z80_OP(ddcb_D2) //LD D, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 2, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(2, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD3: //LD E, SET 2, (regs.IX+d)
+                                case 0xD3: RM_Z80_OP(ddcb_D3) //LD E, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 2, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(2, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD4: //LD H, SET 21, (regs.IX+d)
+                                case 0xD4: RM_Z80_OP(ddcb_D4) //LD H, SET 21, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 2, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(2, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD5: //LD L, SET 2, (regs.IX+d)
+                                case 0xD5: RM_Z80_OP(ddcb_D5) //LD L, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 2, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(2, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD6:  //SET 2, (regs.IX + d)
+                                case 0xD6: RM_Z80_OP(ddcb_D6)  //SET 2, (regs.IX + d)
                                             // Log(string.Format("SET 2, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(2, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD7: //LD A, SET 2, (regs.IX+d)
+                                case 0xD7: RM_Z80_OP(ddcb_D7) //LD A, SET 2, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 2, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(2, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD8: //LD B, SET 3, (regs.IX+d)
+                                case 0xD8: RM_Z80_OP(ddcb_D8) //LD B, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 3, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(3, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xD9: //LD C, SET 3, (regs.IX+d)
+                                case 0xD9: RM_Z80_OP(ddcb_D9) //LD C, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 3, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(3, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDA: //LD D, SET 3, (regs.IX+d)
+                                case 0xDA: RM_Z80_OP(ddcb_DA) //LD D, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 3, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(3, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDB: //LD E, SET 3, (regs.IX+d)
+                                case 0xDB: RM_Z80_OP(ddcb_DB) //LD E, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 3, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(3, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDC: //LD H, SET 21, (regs.IX+d)
+                                case 0xDC: RM_Z80_OP(ddcb_DC) //LD H, SET 21, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 3, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(3, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDD: //LD L, SET 3, (regs.IX+d)
+                                case 0xDD: RM_Z80_OP(ddcb_DD) //LD L, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 3, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(3, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDE:  //SET 3, (regs.IX + d)
+                                case 0xDE: RM_Z80_OP(ddcb_DE)  //SET 3, (regs.IX + d)
                                             // Log(string.Format("SET 3, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(3, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xDF: //LD A, SET 3, (regs.IX+d)
+                                case 0xDF: RM_Z80_OP(ddcb_DF) //LD A, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 3, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(3, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE0: //LD B, SET 4, (regs.IX+d)
+                                case 0xE0: RM_Z80_OP(ddcb_E0) //LD B, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 4, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(4, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE1: //LD C, SET 4, (regs.IX+d)
+                                case 0xE1: RM_Z80_OP(ddcb_E1) //LD C, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 4, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(4, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE2: //LD D, SET 4, (regs.IX+d)
+                                case 0xE2: RM_Z80_OP(ddcb_E2) //LD D, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 4, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(4, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE3: //LD E, SET 4, (regs.IX+d)
+                                case 0xE3: RM_Z80_OP(ddcb_E3) //LD E, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 4, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(4, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE4: //LD H, SET 4, (regs.IX+d)
+                                case 0xE4: RM_Z80_OP(ddcb_E4) //LD H, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 4, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(4, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE5: //LD L, SET 3, (regs.IX+d)
+                                case 0xE5: RM_Z80_OP(ddcb_E5) //LD L, SET 3, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 4, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(4, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE6:  //SET 4, (regs.IX + d)
+                                case 0xE6: RM_Z80_OP(ddcb_E6)  //SET 4, (regs.IX + d)
                                             // Log(string.Format("SET 4, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(4, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE7: //LD A, SET 4, (regs.IX+d)
+                                case 0xE7: RM_Z80_OP(ddcb_E7) //LD A, SET 4, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 4, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(4, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE8: //LD B, SET 5, (regs.IX+d)
+                                case 0xE8: RM_Z80_OP(ddcb_E8) //LD B, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 5, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(5, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xE9: //LD C, SET 5, (regs.IX+d)
+                                case 0xE9: RM_Z80_OP(ddcb_E9) //LD C, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 5, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(5, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xEA: //LD D, SET 5, (regs.IX+d)
+                                case 0xEA: RM_Z80_OP(ddcb_EA) //LD D, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 5, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(5, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xEB: //LD E, SET 5, (regs.IX+d)
+                                case 0xEB: RM_Z80_OP(ddcb_EB) //LD E, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 5, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(5, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xEC: //LD H, SET 5, (regs.IX+d)
+                                case 0xEC: RM_Z80_OP(ddcb_EC) //LD H, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 5, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(5, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xED: //LD L, SET 5, (regs.IX+d)
+                                case 0xED: RM_Z80_OP(ddcb_ED) //LD L, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 5, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(5, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xEE:  //SET 5, (regs.IX + d)
+                                case 0xEE: RM_Z80_OP(ddcb_EE)  //SET 5, (regs.IX + d)
                                             // Log(string.Format("SET 5, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(5, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xEF: //LD A, SET 5, (regs.IX+d)
+                                case 0xEF: RM_Z80_OP(ddcb_EF) //LD A, SET 5, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 5, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(5, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF0: //LD B, SET 6, (regs.IX+d)
+                                case 0xF0: RM_Z80_OP(ddcb_F0) //LD B, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 6, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(6, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF1: //LD C, SET 6, (regs.IX+d)
+                                case 0xF1: RM_Z80_OP(ddcb_F1) //LD C, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 6, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(6, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF2: //LD D, SET 6, (regs.IX+d)
+                                case 0xF2: RM_Z80_OP(ddcb_F2) //LD D, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 6, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(6, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF3: //LD E, SET 6, (regs.IX+d)
+                                case 0xF3: RM_Z80_OP(ddcb_F3) //LD E, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 6, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(6, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF4: //LD H, SET 6, (regs.IX+d)
+                                case 0xF4: RM_Z80_OP(ddcb_F4) //LD H, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 6, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(6, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF5: //LD L, SET 6, (regs.IX+d)
+                                case 0xF5: RM_Z80_OP(ddcb_F5) //LD L, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 6, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(6, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF6:  //SET 6, (regs.IX + d)
+                                case 0xF6: RM_Z80_OP(ddcb_F6)  //SET 6, (regs.IX + d)
                                             // Log(string.Format("SET 6, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(6, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF7: //LD A, SET 6, (regs.IX+d)
+                                case 0xF7: RM_Z80_OP(ddcb_F7) //LD A, SET 6, (regs.IX+d)
                                            // Log(string.Format("LD A, SET 6, (regs.IX + {0:X})", b));
                                 regs.A = Set_R(6, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF8: //LD B, SET 7, (regs.IX+d)
+                                case 0xF8: RM_Z80_OP(ddcb_F8) //LD B, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD B, SET 7, (regs.IX + {0:X})", b));
                                 regs.B = Set_R(7, b);
                                 PokeByte(offset, regs.B);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xF9: //LD C, SET 7, (regs.IX+d)
+                                case 0xF9: RM_Z80_OP(ddcb_F9) //LD C, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD C, SET 7, (regs.IX + {0:X})", b));
                                 regs.C = Set_R(7, b);
                                 PokeByte(offset, regs.C);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFA: //LD D, SET 7, (regs.IX+d)
+                                case 0xFA: RM_Z80_OP(ddcb_FA) //LD D, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD D, SET 7, (regs.IX + {0:X})", b));
                                 regs.D = Set_R(7, b);
                                 PokeByte(offset, regs.D);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFB: //LD E, SET 7, (regs.IX+d)
+                                case 0xFB: RM_Z80_OP(ddcb_FB) //LD E, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD E, SET 7, (regs.IX + {0:X})", b));
                                 regs.E = Set_R(7, b);
                                 PokeByte(offset, regs.E);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFC: //LD H, SET 7, (regs.IX+d)
+                                case 0xFC: RM_Z80_OP(ddcb_FC) //LD H, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD H, SET 7, (regs.IX + {0:X})", b));
                                 regs.H = Set_R(7, b);
                                 PokeByte(offset, regs.H);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFD: //LD L, SET 7, (regs.IX+d)
+                                case 0xFD: RM_Z80_OP(ddcb_FD) //LD L, SET 7, (regs.IX+d)
                                            // Log(string.Format("LD L, SET 7, (regs.IX + {0:X})", b));
                                 regs.L = Set_R(7, b);
                                 PokeByte(offset, regs.L);
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFE:  //SET 7, (regs.IX + d)
+                                case 0xFE: RM_Z80_OP(ddcb_FE)  //SET 7, (regs.IX + d)
                                             // Log(string.Format("SET 7, (regs.IX + {0:X})", b));
                                 PokeByte(offset, Set_R(7, b));
-                                break;
+                                RM_Z80_NEXT;
 
-                                case 0xFF: //LD A, SET 7, (regs.IX + D)
+                                case 0xFF: RM_Z80_OP(ddcb_FF) //LD A, SET 7, (regs.IX + D)
                                 regs.A = Set_R(7, b);
                                 PokeByte(offset, regs.A);
-                                break;
+                                RM_Z80_NEXT;
 
                                 default:
                                 assert(false);
                                 //System.String msg = "ERROR: Could not handle DDCB " + opcode.ToString();
                                 //System.Windows.Forms.MessageBox.Show(msg, "Opcode handler",
                                 //            System.Windows.Forms.MessageBoxButtons.OKCancel, System.Windows.Forms.MessageBoxIcon.Error);
-                                break;
+                                RM_Z80_NEXT;
                             }
-                            break;
+                            RM_Z80_NEXT;
                      }
 
-                    case 0xE1:  //POP regs.IX
+                    case 0xE1: RM_Z80_OP(dd_E1)  //POP regs.IX
                                 // Log("POP regs.IX");
                     regs.IX = PopStack();
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE5:  //PUSH regs.IX
+                    case 0xE5: RM_Z80_OP(dd_E5)  //PUSH regs.IX
                                 // Log("PUSH regs.IX");
                     Contend(regs.IR(), 1, 1);
                     PushStack(regs.IX);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE3:  //EX (regs.SP), regs.IX
+                    case 0xE3: RM_Z80_OP(dd_E3)  //EX (regs.SP), regs.IX
                                 // Log("EX (regs.SP), regs.IX");
                                 //disp = regs.IX;
                     addr = PeekWord(regs.SP);
@@ -5785,46 +6433,51 @@ namespace rm {
                     Contend(regs.SP, 1, 2);
                     regs.IX = addr;
                     regs.MemPtr = regs.IX;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE9:  //JP (regs.IX)
+                    case 0xE9: RM_Z80_OP(dd_E9)  //JP (regs.IX)
                                 // Log("JP (regs.IX)");
                     regs.PC = regs.IX;
-                    break;
+                    RM_Z80_NEXT;
 
                     //  case 0xED:
                     //     MessageBox.Show("DD ED encountered!", "Opcode handler",
                     //                 MessageBoxButtons.OKCancel, MessageBoxIcon.Error);
                     //      break;
 
-                    default:
+                    default: RM_Z80_OP(dd_default)
                     //According to Sean's doc: http://z80.info/z80sean.txt
                     //If a DDxx or FDxx instruction is not listed, it should operate as
                     //without the DD or FD prefix, and the DD or FD prefix itself should
                     //operate as a NOP.
+#if RM_Z80_COMPUTED_GOTO
+                    RM_Z80_DISPATCH(main, opcode);  //Re-dispatch as a normal instruction
+#else
                     Execute(opcode);  //Try to excute it as a normal instruction then
-                    break;
+#endif
+                    RM_Z80_NEXT;
                 }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xED:
+                case 0xED: RM_Z80_OP(main_ED)
                 opcode = FetchInstruction();
+                RM_Z80_DISPATCH(ed, opcode);
                 if(opcode < 0x40) {
-                    break;
+                    RM_Z80_NEXT;
                 }
                 else
                     switch(opcode) {
-                        case 0x40: //IN B, (C)
+                        case 0x40: RM_Z80_OP(ed_40) //IN B, (C)
                                    // Log("IN B, (C)");
                         regs.B = In_BC();
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x41: //Out (C), B
+                        case 0x41: RM_Z80_OP(ed_41) //Out (C), B
                                    // Log("OUT (C), B");
                         Out(regs.BC, regs.B);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x42:  //SBC regs.HL, regs.BC
+                        case 0x42: RM_Z80_OP(ed_42)  //SBC regs.HL, regs.BC
                                     // Log("SBC regs.HL, regs.BC");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -5832,59 +6485,59 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Sbc_RR(regs.BC);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x43:  //LD (nn), regs.BC
+                        case 0x43: RM_Z80_OP(ed_43)  //LD (nn), regs.BC
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD ({0:X}), regs.BC", disp));
                             PokeWord(disp, regs.BC);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x44:  //NEG
+                        case 0x44: RM_Z80_OP(ed_44)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
 
-                        case 0x45:  //RETN
+                        case 0x45: RM_Z80_OP(ed_45)  //RETN
                                     // Log("RET N");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x46:  //IM0
+                        case 0x46: RM_Z80_OP(ed_46)  //IM0
                                     // Log("IM 0");
                         interrupt_mode = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x47:  //LD I, A
+                        case 0x47: RM_Z80_OP(ed_47)  //LD I, A
                                     // Log("LD I, A");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 1;
                                     //else
                         Contend(regs.IR(), 1, 1);
                         regs.I = regs.A;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x48: //IN C, (C)
+                        case 0x48: RM_Z80_OP(ed_48) //IN C, (C)
                                    // Log("IN C, (C)");
                         regs.C = In_BC();
                         //tstates = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x49: //Out (C), C
+                        case 0x49: RM_Z80_OP(ed_49) //Out (C), C
                                    // Log("OUT (C), C");
                         Out(regs.BC, regs.C);
                         //tstates = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x4A:  //ADC regs.HL, regs.BC
+                        case 0x4A: RM_Z80_OP(ed_4A)  //ADC regs.HL, regs.BC
                                     // Log("ADC regs.HL, regs.BC");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -5892,53 +6545,53 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Adc_RR(regs.BC);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x4B:  //LD regs.BC, (nn)
+                        case 0x4B: RM_Z80_OP(ed_4B)  //LD regs.BC, (nn)
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD regs.BC, ({0:X})", disp));
                             regs.BC = PeekWord(disp);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
 
-                        case 0x4C:  //NEG
+                        case 0x4C: RM_Z80_OP(ed_4C)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x4D:  //RETI
+                        case 0x4D: RM_Z80_OP(ed_4D)  //RETI
                                     // Log("RETI");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x4F:  //LD R, A
+                        case 0x4F: RM_Z80_OP(ed_4F)  //LD R, A
                                     // Log("LD R, A");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 1;
                                     //else
                         Contend(regs.IR(), 1, 1);
                         regs.R = regs.R_ = regs.A;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x50: //IN D, (C)
+                        case 0x50: RM_Z80_OP(ed_50) //IN D, (C)
                                    // Log("IN D, (C)");
                         regs.D = In_BC();
                         //tstates = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x51: //Out (C), D
+                        case 0x51: RM_Z80_OP(ed_51) //Out (C), D
                                    // Log("OUT (C), D");
                         Out(regs.BC, regs.D);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x52:  //SBC regs.HL, regs.DE
+                        case 0x52: RM_Z80_OP(ed_52)  //SBC regs.HL, regs.DE
                                     // Log("SBC regs.HL, regs.DE");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -5946,37 +6599,37 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Sbc_RR(regs.DE);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x53:  //LD (nn), regs.DE
+                        case 0x53: RM_Z80_OP(ed_53)  //LD (nn), regs.DE
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD ({0:X}), regs.DE", disp));
                             PokeWord(disp, regs.DE);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x54:  //NEG
+                        case 0x54: RM_Z80_OP(ed_54)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x55:  //RETN
+                        case 0x55: RM_Z80_OP(ed_55)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x56:  //IM1
+                        case 0x56: RM_Z80_OP(ed_56)  //IM1
                                     // Log("IM 1");
                         interrupt_mode = 1;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x57:  //LD A, I
+                        case 0x57: RM_Z80_OP(ed_57)  //LD A, I
                                     // Log("LD A, I");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 1;
@@ -5996,21 +6649,21 @@ namespace rm {
                         regs.F |= (byte)(iff_2 ? BIT_F_PARITY : 0);
                         parityBitNeedsReset = true;
                         regs.modified_F = true;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x58: //IN E, (C)
+                        case 0x58: RM_Z80_OP(ed_58) //IN E, (C)
                                    // Log("IN E, (C)");
                         regs.E = In_BC();
                         //tstates = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x59: //Out (C), E
+                        case 0x59: RM_Z80_OP(ed_59) //Out (C), E
                                    // Log("OUT (C), E");
                         Out(regs.BC, regs.E);
                         //t_states = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x5A:  //ADC regs.HL, regs.DE
+                        case 0x5A: RM_Z80_OP(ed_5A)  //ADC regs.HL, regs.DE
                                     // Log("ADC regs.HL, regs.DE");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -6018,37 +6671,37 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Adc_RR(regs.DE);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x5B:  //LD regs.DE, (nn)
+                        case 0x5B: RM_Z80_OP(ed_5B)  //LD regs.DE, (nn)
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD regs.DE, ({0:X})", disp));
                             regs.DE = PeekWord(disp);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x5C:  //NEG
+                        case 0x5C: RM_Z80_OP(ed_5C)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x5D:  //RETN
+                        case 0x5D: RM_Z80_OP(ed_5D)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x5E:  //IM2
+                        case 0x5E: RM_Z80_OP(ed_5E)  //IM2
                                     // Log("IM 2");
                         interrupt_mode = 2;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x5F:  //LD A, R
+                        case 0x5F: RM_Z80_OP(ed_5F)  //LD A, R
                                     // Log("LD A, R");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 1;
@@ -6058,19 +6711,19 @@ namespace rm {
                         regs.F = (byte)(((regs.F & BIT_F_CARRY) | sz53[regs.A]) | (iff_2 ? BIT_F_PARITY : 0));
                         parityBitNeedsReset = true;
                         regs.modified_F = true;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x60: //IN H, (C)
+                        case 0x60: RM_Z80_OP(ed_60) //IN H, (C)
                                    // Log("IN H, (C)");
                         regs.H = In_BC();
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x61: //Out (C), H
+                        case 0x61: RM_Z80_OP(ed_61) //Out (C), H
                                    // Log("OUT (C), H");
                         Out(regs.BC, regs.H);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x62:  //SBC regs.HL, regs.HL
+                        case 0x62: RM_Z80_OP(ed_62)  //SBC regs.HL, regs.HL
                                     // Log("SBC regs.HL, regs.HL");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -6078,32 +6731,32 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Sbc_RR(regs.HL);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x63:  //LD (nn), regs.HL
+                        case 0x63: RM_Z80_OP(ed_63)  //LD (nn), regs.HL
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD ({0:X}), regs.HL", disp));
                             PokeWord(disp, regs.HL);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x64:  //NEG
+                        case 0x64: RM_Z80_OP(ed_64)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x65:  //RETN
+                        case 0x65: RM_Z80_OP(ed_65)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x67:  //RRD
+                        case 0x67: RM_Z80_OP(ed_67)  //RRD
                                     // Log("RRD");
                         temp = regs.A;
                         data = PeekByte(regs.HL);
@@ -6120,19 +6773,19 @@ namespace rm {
                         SetParity(parity[regs.A]);
                         SetHalf(false);
                         SetNeg(false);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x68: //IN L, (C)
+                        case 0x68: RM_Z80_OP(ed_68) //IN L, (C)
                                    // Log("IN L, (C)");
                         regs.L = In_BC();
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x69: //Out (C), L
+                        case 0x69: RM_Z80_OP(ed_69) //Out (C), L
                                    // Log("OUT (C), L");
                         Out(regs.BC, regs.L);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x6A:  //ADC regs.HL, regs.HL
+                        case 0x6A: RM_Z80_OP(ed_6A)  //ADC regs.HL, regs.HL
                                     // Log("ADC regs.HL, regs.HL");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -6140,32 +6793,32 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Adc_RR(regs.HL);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x6B:  //LD regs.HL, (nn)
+                        case 0x6B: RM_Z80_OP(ed_6B)  //LD regs.HL, (nn)
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD regs.HL, ({0:X})", disp));
                             regs.HL = PeekWord(disp);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x6C:  //NEG
+                        case 0x6C: RM_Z80_OP(ed_6C)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x6D:  //RETN
+                        case 0x6D: RM_Z80_OP(ed_6D)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x6F:  //RLD
+                        case 0x6F: RM_Z80_OP(ed_6F)  //RLD
                                     // Log("RLD");
                         temp = regs.A;
                         data = PeekByte(regs.HL);
@@ -6182,20 +6835,20 @@ namespace rm {
                         SetParity(parity[regs.A]);
                         SetHalf(false);
                         SetNeg(false);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x70:  //IN (C)
+                        case 0x70: RM_Z80_OP(ed_70)  //IN (C)
                                     // Log("IN (C)");
                         In_BC();
                         //tstates = 0;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x71:
+                        case 0x71: RM_Z80_OP(ed_71)
                         // Log("OUT (C), 0");
                         Out(regs.BC, 0);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x72:  //SBC regs.HL, regs.SP
+                        case 0x72: RM_Z80_OP(ed_72)  //SBC regs.HL, regs.SP
                                     // Log("SBC regs.HL, regs.SP");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -6203,49 +6856,49 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Sbc_RR(regs.SP);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x73:  //LD (nn), regs.SP
+                        case 0x73: RM_Z80_OP(ed_73)  //LD (nn), regs.SP
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD ({0:X}), regs.SP", disp));
                             PokeWord(disp, regs.SP);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x74:  //NEG
+                        case 0x74: RM_Z80_OP(ed_74)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x75:  //RETN
+                        case 0x75: RM_Z80_OP(ed_75)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x76:  //IM 1
+                        case 0x76: RM_Z80_OP(ed_76)  //IM 1
                                     // Log("IM 1");
                         interrupt_mode = 1;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x78:  //IN A, (C)
+                        case 0x78: RM_Z80_OP(ed_78)  //IN A, (C)
                                     // Log("IN A, (C)");
                         regs.MemPtr = (ushort)(regs.BC + 1);
                         regs.A = In_BC();
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x79: //Out (C), A
+                        case 0x79: RM_Z80_OP(ed_79) //Out (C), A
                                    // Log("OUT (C), A");
                         regs.MemPtr = (ushort)(regs.BC + 1);
                         Out(regs.BC, regs.A);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x7A:  //ADC regs.HL, regs.SP
+                        case 0x7A: RM_Z80_OP(ed_7A)  //ADC regs.HL, regs.SP
                                     // Log("ADC regs.HL, regs.SP");
                                     //if (model == MachineModel._plus3)
                                     //    totalTStates += 7;
@@ -6253,37 +6906,37 @@ namespace rm {
                         Contend(regs.IR(), 1, 7);
                         regs.MemPtr = (ushort)(regs.HL + 1);
                         Adc_RR(regs.SP);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x7B:  //LD regs.SP, (nn)
+                        case 0x7B: RM_Z80_OP(ed_7B)  //LD regs.SP, (nn)
                         {
                             ushort disp = PeekWord(regs.PC);
                             // Log(String.Format("LD regs.SP, ({0:X})", disp));
                             regs.SP = PeekWord(disp);
                             regs.MemPtr = (ushort)(disp + 1);
                             regs.PC += 2;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x7C:  //NEG
+                        case 0x7C: RM_Z80_OP(ed_7C)  //NEG
                         {
                             byte b = regs.A;
                             regs.A = 0;
                             Sub_R(b); //Sets flags correctly for NEG as well!
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0x7D:  //RETN
+                        case 0x7D: RM_Z80_OP(ed_7D)  //RETN
                                     // Log("RETN");
                         regs.PC = PopStack();
                         iff_1 = iff_2;
                         regs.MemPtr = regs.PC;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0x7E:  //IM 2
+                        case 0x7E: RM_Z80_OP(ed_7E)  //IM 2
                                     // Log("IM 2");
                         interrupt_mode = 2;
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0xA0:  //LDI
+                        case 0xA0: RM_Z80_OP(ed_A0)  //LDI
                         {
                             byte b = PeekByte(regs.HL);
                             PokeByte(regs.DE, b);
@@ -6296,9 +6949,9 @@ namespace rm {
                                 | (regs.BC != 0 ? BIT_F_PARITY : 0)
                                 | (b & BIT_F_3) | ((b & 0x02) != 0 ? BIT_F_5 : 0));
                             regs.modified_F = true;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xA1:  //CPI
+                        case 0xA1: RM_Z80_OP(ed_A1)  //CPI
                         {
                             byte b = PeekByte(regs.HL);
                             bool lastCarry = ((regs.F & BIT_F_CARRY) != 0);
@@ -6312,9 +6965,9 @@ namespace rm {
                             SetParity(regs.BC != 0);
                             SetF3((((regs.A - b - ((regs.F & BIT_F_HALF) >> 4)) & 0xff) & BIT_F_3) != 0);
                             SetF5((((regs.A - b - ((regs.F & BIT_F_HALF) >> 4)) & 0xff) & BIT_F_NEG) != 0);
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xA2:  //INI
+                        case 0xA2: RM_Z80_OP(ed_A2)  //INI
                                     // Log("INI");
                         Contend(regs.IR(), 1, 1);
                         result = In_BC();
@@ -6327,9 +6980,9 @@ namespace rm {
                         SetCarry(carry > 0xff);
                         SetHalf((regs.F & BIT_F_CARRY) != 0);
                         SetParity(parity[((carry & 0x7) ^ regs.B)]);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0xA3:  //OUTI
+                        case 0xA3: RM_Z80_OP(ed_A3)  //OUTI
                         {
                             Contend(regs.IR(), 1, 1);
                             // Log("OUTI");
@@ -6346,9 +6999,9 @@ namespace rm {
 
                             SetParity(parity[(((b + regs.L) & 0x7) ^ regs.B)]);
                             //SetZero(B == 0);
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xA8:  //LDD
+                        case 0xA8: RM_Z80_OP(ed_A8)  //LDD
                         {
                             byte b = PeekByte(regs.HL);
                             PokeByte(regs.DE, b);
@@ -6362,9 +7015,9 @@ namespace rm {
                                     | (regs.BC != 0 ? BIT_F_PARITY : 0) 
                                     | ((b & BIT_F_3) | ((b & 0x02) != 0 ? BIT_F_5 : 0)));
                             regs.modified_F = true;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xA9:  //CPD
+                        case 0xA9: RM_Z80_OP(ed_A9)  //CPD
                         {
                             bool lastCarry = ((regs.F & BIT_F_CARRY) != 0);
                             byte b = PeekByte(regs.HL);
@@ -6377,9 +7030,9 @@ namespace rm {
                             SetF5((((regs.A - b - ((regs.F & BIT_F_HALF) >> 4)) & 0xff) & BIT_F_NEG) != 0);
                             SetCarry(lastCarry);
                             regs.MemPtr--;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xAA:  //IND
+                        case 0xAA: RM_Z80_OP(ed_AA)  //IND
                                     // Log("IND");
                         Contend(regs.IR(), 1, 1);
                         result = In_BC();
@@ -6392,9 +7045,9 @@ namespace rm {
                         SetCarry(carry > 0xff);
                         SetHalf((regs.F & BIT_F_CARRY) != 0);
                         SetParity(parity[((carry & 0x7) ^ regs.B)]);
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0xAB:  //OUTD
+                        case 0xAB: RM_Z80_OP(ed_AB)  //OUTD
                         {
                             Contend(regs.IR(), 1, 1);
 
@@ -6411,9 +7064,9 @@ namespace rm {
                             SetHalf((regs.F & BIT_F_CARRY) != 0);
 
                             SetParity(parity[(((b + regs.L) & 0x7) ^ regs.B)]);
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xB0:  //LDIR
+                        case 0xB0: RM_Z80_OP(ed_B0)  //LDIR
                         {
                             byte b = PeekByte(regs.HL);
                             PokeByte(regs.DE, b);
@@ -6441,9 +7094,9 @@ namespace rm {
                             regs.HL++;
                             regs.DE++;
 
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xB1:  //CPIR
+                        case 0xB1: RM_Z80_OP(ed_B1)  //CPIR
                         {
                             bool lastCarry = ((regs.F & BIT_F_CARRY) != 0);
                             byte b = PeekByte(regs.HL);
@@ -6472,10 +7125,10 @@ namespace rm {
                             }
                             regs.HL++;
 
-                            break;
+                            RM_Z80_NEXT;
                         }
                         
-                        case 0xB2:  //INIR
+                        case 0xB2: RM_Z80_OP(ed_B2)  //INIR
                                     // Log("INIR");
                         Contend(regs.IR(), 1, 1);
                         result = In_BC();
@@ -6504,9 +7157,9 @@ namespace rm {
                             }
                             SetParity((parity[regs.F & BIT_F_PARITY] ^ parity[_b & 0x7]) != 0);
                         }
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0xB3:  //OTIR       
+                        case 0xB3: RM_Z80_OP(ed_B3)  //OTIR       
                         {
                             Contend(regs.IR(), 1, 1);
                             regs.B = Dec(regs.B);
@@ -6538,9 +7191,9 @@ namespace rm {
                                 SetParity((parity[regs.F & BIT_F_PARITY] ^ parity[_b & 0x7]) != 0);
                             }
 
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xB8:  //LDDR
+                        case 0xB8: RM_Z80_OP(ed_B8)  //LDDR
                         {
                             byte b = PeekByte(regs.HL);
                             PokeByte(regs.DE, b);
@@ -6570,9 +7223,9 @@ namespace rm {
                             regs.HL--;
                             regs.DE--;
 
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xB9:  //CPDR
+                        case 0xB9: RM_Z80_OP(ed_B9)  //CPDR
                         {
                             bool lastCarry = ((regs.F & BIT_F_CARRY) != 0);
                             byte b = PeekByte(regs.HL);
@@ -6602,9 +7255,9 @@ namespace rm {
                                 SetF5((((regs.A - b - ((regs.F & BIT_F_HALF) >> 4)) & 0xff) & BIT_F_NEG) != 0);
                             }
                             regs.HL--;
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        case 0xBA:  //INDR
+                        case 0xBA: RM_Z80_OP(ed_BA)  //INDR
                                     // Log("INDR");
                         Contend(regs.IR(), 1, 1);
                         result = In_BC();
@@ -6633,9 +7286,9 @@ namespace rm {
                             SetParity((parity[regs.F & BIT_F_PARITY] ^ parity[_b & 0x7]) != 0);
                         }
                         regs.HL--;    
-                        break;
+                        RM_Z80_NEXT;
 
-                        case 0xBB:  //OTDR
+                        case 0xBB: RM_Z80_OP(ed_BB)  //OTDR
                         {
                             Contend(regs.IR(), 1, 1);
                             regs.B = Dec(regs.B);
@@ -6667,56 +7320,58 @@ namespace rm {
                                 SetParity((parity[regs.F & BIT_F_PARITY] ^ parity[_b & 0x7]) != 0);
                             }
 
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        default:
+                        default: RM_Z80_OP(ed_default)
                         //According to Sean's doc: http://z80.info/z80sean.txt
                         //If an EDxx instruction is not listed, it should operate as two NOPs.
-                        break;  //Carry on to next instruction then
+                        RM_Z80_NEXT;  //Carry on to next instruction then
                     }
-                break;
+                RM_Z80_NEXT;
 
-                case 0xFD:
-                switch(opcode = FetchInstruction()) {
-                    case 0x09:  //ADD regs.IY, regs.BC
+                case 0xFD: RM_Z80_OP(main_FD)
+                opcode = FetchInstruction();
+                RM_Z80_DISPATCH(fd, opcode);
+                switch(opcode) {
+                    case 0x09: RM_Z80_OP(fd_09)  //ADD regs.IY, regs.BC
                                 // Log("ADD regs.IY, regs.BC");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IY + 1);
                     regs.IY = Add_RR(regs.IY, regs.BC);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x19:  //ADD regs.IY, regs.DE
+                    case 0x19: RM_Z80_OP(fd_19)  //ADD regs.IY, regs.DE
                                 // Log("ADD regs.IY, regs.DE");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IY + 1);
                     regs.IY = Add_RR(regs.IY, regs.DE);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x29:  //ADD regs.IY, regs.IY
+                    case 0x29: RM_Z80_OP(fd_29)  //ADD regs.IY, regs.IY
                                 // Log("ADD regs.IY, regs.IY");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IY + 1);
                     regs.IY = Add_RR(regs.IY, regs.IY);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x39:  //ADD regs.IY, regs.SP
+                    case 0x39: RM_Z80_OP(fd_39)  //ADD regs.IY, regs.SP
                                 // Log("ADD regs.IY, regs.SP");
                     Contend(regs.IR(), 1, 7);
                     regs.MemPtr = (ushort)(regs.IY + 1);
                     regs.IY = Add_RR(regs.IY, regs.SP);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x84:  //ADD A, IYH
+                    case 0x84: RM_Z80_OP(fd_84)  //ADD A, IYH
                                 // Log("ADD A, IYH");
                     Add_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x85:  //ADD A, IYL
+                    case 0x85: RM_Z80_OP(fd_85)  //ADD A, IYL
                                 // Log("ADD A, IYL");
                     Add_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x86:  //Add A, (regs.IY+d)
+                    case 0x86: RM_Z80_OP(fd_86)  //Add A, (regs.IY+d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6725,19 +7380,19 @@ namespace rm {
                         Add_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x8C:  //ADC A, IYH
+                    case 0x8C: RM_Z80_OP(fd_8C)  //ADC A, IYH
                                 // Log("ADC A, IYH");
                     Adc_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8D:  //ADC A, IYL
+                    case 0x8D: RM_Z80_OP(fd_8D)  //ADC A, IYL
                                 // Log("ADC A, IYL");
                     Adc_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x8E: //ADC A, (regs.IY+d)
+                    case 0x8E: RM_Z80_OP(fd_8E) //ADC A, (regs.IY+d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6746,20 +7401,20 @@ namespace rm {
                         Adc_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x94:  //SUB A, IYH
+                    case 0x94: RM_Z80_OP(fd_94)  //SUB A, IYH
                                 // Log("SUB A, IYH");
                     Sub_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x95:  //SUB A, IYL
+                    case 0x95: RM_Z80_OP(fd_95)  //SUB A, IYL
                                 // Log("SUB A, IYL");
                     Sub_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x96:  //SUB (regs.IY + d)
+                    case 0x96: RM_Z80_OP(fd_96)  //SUB (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6768,20 +7423,20 @@ namespace rm {
                         Sub_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x9C:  //SBC A, IYH
+                    case 0x9C: RM_Z80_OP(fd_9C)  //SBC A, IYH
                                 // Log("SBC A, IYH");
                     Sbc_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9D:  //SBC A, IYL
+                    case 0x9D: RM_Z80_OP(fd_9D)  //SBC A, IYL
                                 // Log("SBC A, IYL");
                     Sbc_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x9E:  //SBC A, (regs.IY + d)
+                    case 0x9E: RM_Z80_OP(fd_9E)  //SBC A, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6790,83 +7445,83 @@ namespace rm {
                         Sbc_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x23:  //INC regs.IY
+                    case 0x23: RM_Z80_OP(fd_23)  //INC regs.IY
                                 // Log("INC regs.IY");
                                 //if (model == MachineModel._plus3)
                                 //    totalTStates += 2;
                                 //else
                     Contend(regs.IR(), 1, 2);
                     regs.IY++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x24:  //INC IYH
+                    case 0x24: RM_Z80_OP(fd_24)  //INC IYH
                                 // Log("INC IYH");
                     regs.IYH = Inc(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x25:  //DEC IYH
+                    case 0x25: RM_Z80_OP(fd_25)  //DEC IYH
                                 // Log("DEC IYH");
                     regs.IYH = Dec(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2B:  //DEC regs.IY
+                    case 0x2B: RM_Z80_OP(fd_2B)  //DEC regs.IY
                                 // Log("DEC regs.IY");
                                 //if (model == MachineModel._plus3)
                                 //    totalTStates += 2;
                                 //else
                     Contend(regs.IR(), 1, 2);
                     regs.IY--;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2C:  //INC IYL
+                    case 0x2C: RM_Z80_OP(fd_2C)  //INC IYL
                                 // Log("INC IYL");
                     regs.IYL = Inc(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2D:  //DEC IYL
+                    case 0x2D: RM_Z80_OP(fd_2D)  //DEC IYL
                                 // Log("DEC IYL");
                     regs.IYL = Dec(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x34:  //INC (regs.IY + d)
+                    case 0x34: RM_Z80_OP(fd_34)  //INC (regs.IY + d)
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
-                        ushort offset = (ushort)(regs.IY + d); //The displacement required
+                        offset = (ushort)(regs.IY + d); //The displacement required
                         Contend(regs.PC, 1, 5);
                         byte b = Inc(PeekByte(offset));
                         Contend(offset, 1, 1);
                         PokeByte(offset, b);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x35:  //DEC (regs.IY + d)
+                    case 0x35: RM_Z80_OP(fd_35)  //DEC (regs.IY + d)
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
-                        ushort offset = (ushort)(regs.IY + d); //The displacement required
+                        offset = (ushort)(regs.IY + d); //The displacement required
                         Contend(regs.PC, 1, 5);
                         byte b = Dec(PeekByte(offset));
                         Contend(offset, 1, 1);
                         PokeByte(offset, b);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xA4:  //AND IYH
+                    case 0xA4: RM_Z80_OP(fd_A4)  //AND IYH
                                 // Log("AND IYH");
                     And_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA5:  //AND IYL
+                    case 0xA5: RM_Z80_OP(fd_A5)  //AND IYL
                                 // Log("AND IYL");
                     And_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xA6:  //AND (regs.IY + d)
+                    case 0xA6: RM_Z80_OP(fd_A6)  //AND (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6875,19 +7530,19 @@ namespace rm {
                         And_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0xAC:  //XOR IYH
+                    case 0xAC: RM_Z80_OP(fd_AC)  //XOR IYH
                                 // Log("XOR IYH");
                     Xor_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAD:  //XOR IYL
+                    case 0xAD: RM_Z80_OP(fd_AD)  //XOR IYL
                                 // Log("XOR IYL");
                     Xor_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xAE:  //XOR (regs.IY + d)
+                    case 0xAE: RM_Z80_OP(fd_AE)  //XOR (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6896,20 +7551,20 @@ namespace rm {
                         Xor_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xB4:  //OR IYH
+                    case 0xB4: RM_Z80_OP(fd_B4)  //OR IYH
                                 // Log("OR IYH");
                     Or_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB5:  //OR IYL
+                    case 0xB5: RM_Z80_OP(fd_B5)  //OR IYL
                                 // Log("OR IYL");
                     Or_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xB6:  //OR (regs.IY + d)
+                    case 0xB6: RM_Z80_OP(fd_B6)  //OR (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6918,20 +7573,20 @@ namespace rm {
                         Or_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xBC:  //CP IYH
+                    case 0xBC: RM_Z80_OP(fd_BC)  //CP IYH
                                 // Log("CP IYH");
                     Cp_R(regs.IYH);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBD:  //CP IYL
+                    case 0xBD: RM_Z80_OP(fd_BD)  //CP IYL
                                 // Log("CP IYL");
                     Cp_R(regs.IYL);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xBE:  //CP (regs.IY + d)
+                    case 0xBE: RM_Z80_OP(fd_BE)  //CP (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -6940,66 +7595,66 @@ namespace rm {
                         Cp_R(PeekByte(offset));
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x21:  //LD regs.IY, nn
+                    case 0x21: RM_Z80_OP(fd_21)  //LD regs.IY, nn
                                 // Log(string.Format("LD regs.IY, {0,-6:X}", PeekWord(regs.PC)));
                     regs.IY = PeekWord(regs.PC);
                     regs.PC += 2;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x22:  //LD (nn), regs.IY
+                    case 0x22: RM_Z80_OP(fd_22)  //LD (nn), regs.IY
                                 // Log(string.Format("LD ({0:X}), regs.IY", PeekWord(regs.PC)));
                     addr = PeekWord(regs.PC);
                     PokeWord(addr, regs.IY);
                     regs.PC += 2;
                     regs.MemPtr = (ushort)(addr + 1);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x26:  //LD IYH, n
+                    case 0x26: RM_Z80_OP(fd_26)  //LD IYH, n
                                 // Log(string.Format("LD IYH, {0:X}", PeekByte(regs.PC)));
                     regs.IYH = PeekByte(regs.PC);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2A:  //LD regs.IY, (nn)
+                    case 0x2A: RM_Z80_OP(fd_2A)  //LD regs.IY, (nn)
                                 // Log(string.Format("LD regs.IY, ({0:X})", PeekWord(regs.PC)));
                     addr = PeekWord(regs.PC);
                     regs.IY = PeekWord(addr);
                     regs.PC += 2;
                     regs.MemPtr = (ushort)(addr + 1);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x2E:  //LD IYL, n
+                    case 0x2E: RM_Z80_OP(fd_2E)  //LD IYL, n
                                 // Log(string.Format("LD IYL, {0:X}", PeekByte(regs.PC)));
                     regs.IYL = PeekByte(regs.PC);
                     regs.PC++;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x36:  //LD (regs.IY + d), n
+                    case 0x36: RM_Z80_OP(fd_36)  //LD (regs.IY + d), n
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
-                        ushort offset = (ushort)(regs.IY + d); //The displacement required
+                        offset = (ushort)(regs.IY + d); //The displacement required
 
                         byte b = PeekByte((ushort)(regs.PC + 1));
                         Contend(regs.PC + 1, 1, 2);
                         PokeByte(offset, b);
                         regs.PC += 2;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x44:  //LD B, IYH
+                    case 0x44: RM_Z80_OP(fd_44)  //LD B, IYH
                                 // Log("LD B, IYH");
                     regs.B = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x45:  //LD B, IYL
+                    case 0x45: RM_Z80_OP(fd_45)  //LD B, IYL
                                 // Log("LD B, IYL");
                     regs.B = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x46:  //LD B, (regs.IY + d)
+                    case 0x46: RM_Z80_OP(fd_46)  //LD B, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7008,19 +7663,19 @@ namespace rm {
                         regs.B = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0x4C:  //LD C, IYH
+                    case 0x4C: RM_Z80_OP(fd_4C)  //LD C, IYH
                                 // Log("LD C, IYH");
                     regs.C = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4D:  //LD C, IYL
+                    case 0x4D: RM_Z80_OP(fd_4D)  //LD C, IYL
                                 // Log("LD C, IYL");
                     regs.C = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x4E:  //LD C, (regs.IY + d)
+                    case 0x4E: RM_Z80_OP(fd_4E)  //LD C, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7029,22 +7684,22 @@ namespace rm {
                         regs.C = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x54:  //LD D, IYH
+                    case 0x54: RM_Z80_OP(fd_54)  //LD D, IYH
                                 // Log("LD D, IYH");
                                 //tstates += 4;
                     regs.D = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x55:  //LD D, IYL
+                    case 0x55: RM_Z80_OP(fd_55)  //LD D, IYL
                                 // Log("LD D, IYL");
                                 //tstates += 4;
                     regs.D = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x56:  //LD D, (regs.IY + d)
+                    case 0x56: RM_Z80_OP(fd_56)  //LD D, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7053,22 +7708,22 @@ namespace rm {
                         regs.D = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x5C:  //LD E, IYH
+                    case 0x5C: RM_Z80_OP(fd_5C)  //LD E, IYH
                                 // Log("LD E, IYH");
                                 //tstates += 4;
                     regs.E = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5D:  //LD E, IYL
+                    case 0x5D: RM_Z80_OP(fd_5D)  //LD E, IYL
                                 // Log("LD E, IYL");
                                 //tstates += 4;
                     regs.E = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x5E:  //LD E, (regs.IY + d)
+                    case 0x5E: RM_Z80_OP(fd_5E)  //LD E, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7077,46 +7732,46 @@ namespace rm {
                         regs.E = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x60:  //LD IYH, B
+                    case 0x60: RM_Z80_OP(fd_60)  //LD IYH, B
                                 // Log("LD IYH, B");
                                 //tstates += 4;
                     regs.IYH = regs.B;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x61:  //LD IYH, C
+                    case 0x61: RM_Z80_OP(fd_61)  //LD IYH, C
                                 // Log("LD IYH, C");
                                 //tstates += 4;
                     regs.IYH = regs.C;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x62:  //LD IYH, D
+                    case 0x62: RM_Z80_OP(fd_62)  //LD IYH, D
                                 // Log("LD IYH, D");
                                 //tstates += 4;
                     regs.IYH = regs.D;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x63:  //LD IYH, E
+                    case 0x63: RM_Z80_OP(fd_63)  //LD IYH, E
                                 // Log("LD IYH, E");
                                 //tstates += 4;
                     regs.IYH = regs.E;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x64:  //LD IYH, IYH
+                    case 0x64: RM_Z80_OP(fd_64)  //LD IYH, IYH
                                 // Log("LD IYH, IYH");
                                 //tstates += 4;
                     regs.IYH = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x65:  //LD IYH, IYL
+                    case 0x65: RM_Z80_OP(fd_65)  //LD IYH, IYL
                                 // Log("LD IYH, IYL");
                                 //tstates += 4;
                     regs.IYH = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x66:  //LD H, (regs.IY + d)
+                    case 0x66: RM_Z80_OP(fd_66)  //LD H, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7125,52 +7780,52 @@ namespace rm {
                         regs.H = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x67:  //LD IYH, A
+                    case 0x67: RM_Z80_OP(fd_67)  //LD IYH, A
                                 // Log("LD IYH, A");
                                 //tstates += 4;
                     regs.IYH = regs.A;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x68:  //LD IYL, B
+                    case 0x68: RM_Z80_OP(fd_68)  //LD IYL, B
                                 // Log("LD IYL, B");
                                 //tstates += 4;
                     regs.IYL = regs.B;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x69:  //LD IYL, C
+                    case 0x69: RM_Z80_OP(fd_69)  //LD IYL, C
                                 // Log("LD IYL, C");
                                 //tstates += 4;
                     regs.IYL = regs.C;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6A:  //LD IYL, D
+                    case 0x6A: RM_Z80_OP(fd_6A)  //LD IYL, D
                                 // Log("LD IYL, D");
                                 //tstates += 4;
                     regs.IYL = regs.D;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6B:  //LD IYL, E
+                    case 0x6B: RM_Z80_OP(fd_6B)  //LD IYL, E
                                 // Log("LD IYL, E");
                                 //tstates += 4;
                     regs.IYL = regs.E;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6C:  //LD IYL, IYH
+                    case 0x6C: RM_Z80_OP(fd_6C)  //LD IYL, IYH
                                 // Log("LD IYL, IYH");
                                 //tstates += 4;
                     regs.IYL = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6D:  //LD IYL, IYL
+                    case 0x6D: RM_Z80_OP(fd_6D)  //LD IYL, IYL
                                 // Log("LD IYL, IYL");
                                 //tstates += 4;
                     regs.IYL = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x6E:  //LD L, (regs.IY + d)
+                    case 0x6E: RM_Z80_OP(fd_6E)  //LD L, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7179,16 +7834,16 @@ namespace rm {
                         regs.L = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x6F:  //LD IYL, A
+                    case 0x6F: RM_Z80_OP(fd_6F)  //LD IYL, A
                                 // Log("LD IYL, A");
                                 //tstates += 4;
                     regs.IYL = regs.A;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x70:  //LD (regs.IY + d), B
+                    case 0x70: RM_Z80_OP(fd_70)  //LD (regs.IY + d), B
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7197,10 +7852,10 @@ namespace rm {
                         PokeByte(offset, regs.B);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x71:  //LD (regs.IY + d), C
+                    case 0x71: RM_Z80_OP(fd_71)  //LD (regs.IY + d), C
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7209,10 +7864,10 @@ namespace rm {
                         PokeByte(offset, regs.C);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x72:  //LD (regs.IY + d), D
+                    case 0x72: RM_Z80_OP(fd_72)  //LD (regs.IY + d), D
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7221,10 +7876,10 @@ namespace rm {
                         PokeByte(offset, regs.D);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x73:  //LD (regs.IY + d), E
+                    case 0x73: RM_Z80_OP(fd_73)  //LD (regs.IY + d), E
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7233,10 +7888,10 @@ namespace rm {
                         PokeByte(offset, regs.E);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x74:  //LD (regs.IY + d), H
+                    case 0x74: RM_Z80_OP(fd_74)  //LD (regs.IY + d), H
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7245,10 +7900,10 @@ namespace rm {
                         PokeByte(offset, regs.H);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x75:  //LD (regs.IY + d), L
+                    case 0x75: RM_Z80_OP(fd_75)  //LD (regs.IY + d), L
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7257,10 +7912,10 @@ namespace rm {
                         PokeByte(offset, regs.L);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x77:  //LD (regs.IY + d), A
+                    case 0x77: RM_Z80_OP(fd_77)  //LD (regs.IY + d), A
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7269,20 +7924,20 @@ namespace rm {
                         PokeByte(offset, regs.A);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0x7C:  //LD A, IYH
+                    case 0x7C: RM_Z80_OP(fd_7C)  //LD A, IYH
                                 // Log("LD A, IYH");
                     regs.A = regs.IYH;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7D:  //LD A, IYL
+                    case 0x7D: RM_Z80_OP(fd_7D)  //LD A, IYL
                                 // Log("LD A, IYL");
                     regs.A = regs.IYL;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0x7E:  //LD A, (regs.IY + d)
+                    case 0x7E: RM_Z80_OP(fd_7E)  //LD A, (regs.IY + d)
                     {
                         int b = GetDisplacement(PeekByte(regs.PC));
                         ushort offset = (ushort)(regs.IY + b); //The displacement required
@@ -7291,18 +7946,18 @@ namespace rm {
                         regs.A = PeekByte(offset);
                         regs.PC++;
                         regs.MemPtr = offset;
-                        break;
+                        RM_Z80_NEXT;
                     }
-                    case 0xF9:  //LD regs.SP, regs.IY
+                    case 0xF9: RM_Z80_OP(fd_F9)  //LD regs.SP, regs.IY
                                 // Log("LD regs.SP, regs.IY");
                     Contend(regs.IR(), 1, 2);
                     regs.SP = regs.IY;
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xCB: 
+                    case 0xCB: RM_Z80_OP(fd_CB) 
                     {
                         int d = GetDisplacement(PeekByte(regs.PC));
-                        ushort offset = (ushort)(regs.IY + d); //The displacement required
+                        offset = (ushort)(regs.IY + d); //The displacement required
                         regs.PC++;
 
                         //TEMP
@@ -7311,1258 +7966,1259 @@ namespace rm {
 
                         Contend(regs.PC, 1, 2);
                         regs.PC++;
-                        byte disp = PeekByte(offset);
+                        b = PeekByte(offset);
                         Contend(offset, 1, 1);
                         // if ((opcode >= 0x40) && (opcode <= 0x7f))
                         regs.MemPtr = offset;
 
+                        RM_Z80_DISPATCH(fdcb, opcode);
                         switch(opcode) {
-                            case 0x00: //LD B, RLC (regs.IY+d)
+                            case 0x00: RM_Z80_OP(fdcb_00) //LD B, RLC (regs.IY+d)
                                         // Log(string.Format("LD B, RLC (regs.IY + {0:X})", disp));
-                            regs.B = Rlc_R(disp);
+                            regs.B = Rlc_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x01: //LD C, RLC (regs.IY+d)
+                            case 0x01: RM_Z80_OP(fdcb_01) //LD C, RLC (regs.IY+d)
                                         // Log(string.Format("LD C, RLC (regs.IY + {0:X})", disp));
-                            regs.C = Rlc_R(disp);
+                            regs.C = Rlc_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x02: //LD D, RLC (regs.IY+d)
+                            case 0x02: RM_Z80_OP(fdcb_02) //LD D, RLC (regs.IY+d)
                                         // Log(string.Format("LD D, RLC (regs.IY + {0:X})", disp));
-                            regs.D = Rlc_R(disp);
+                            regs.D = Rlc_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x03: //LD E, RLC (regs.IY+d)
+                            case 0x03: RM_Z80_OP(fdcb_03) //LD E, RLC (regs.IY+d)
                                         // Log(string.Format("LD E, RLC (regs.IY + {0:X})", disp));
-                            regs.E = Rlc_R(disp);
+                            regs.E = Rlc_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x04: //LD H, RLC (regs.IY+d)
+                            case 0x04: RM_Z80_OP(fdcb_04) //LD H, RLC (regs.IY+d)
                                         // Log(string.Format("LD H, RLC (regs.IY + {0:X})", disp));
-                            regs.H = Rlc_R(disp);
+                            regs.H = Rlc_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x05: //LD L, RLC (regs.IY+d)
+                            case 0x05: RM_Z80_OP(fdcb_05) //LD L, RLC (regs.IY+d)
                                         // Log(string.Format("LD L, RLC (regs.IY + {0:X})", disp));
-                            regs.L = Rlc_R(disp);
+                            regs.L = Rlc_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x06:  //RLC (regs.IY + d)
+                            case 0x06: RM_Z80_OP(fdcb_06)  //RLC (regs.IY + d)
                                         // Log(string.Format("RLC (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Rlc_R(disp));
-                            break;
+                            PokeByte(offset, Rlc_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x07: //LD A, RLC (regs.IY+d)
+                            case 0x07: RM_Z80_OP(fdcb_07) //LD A, RLC (regs.IY+d)
                                         // Log(string.Format("LD A, RLC (regs.IY + {0:X})", disp));
-                            regs.A = Rlc_R(disp);
+                            regs.A = Rlc_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x08: //LD B, RRC (regs.IY+d)
+                            case 0x08: RM_Z80_OP(fdcb_08) //LD B, RRC (regs.IY+d)
                                         // Log(string.Format("LD B, RRC (regs.IY + {0:X})", disp));
-                            regs.B = Rrc_R(disp);
+                            regs.B = Rrc_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x09: //LD C, RRC (regs.IY+d)
+                            case 0x09: RM_Z80_OP(fdcb_09) //LD C, RRC (regs.IY+d)
                                         // Log(string.Format("LD C, RRC (regs.IY + {0:X})", disp));
-                            regs.C = Rrc_R(disp);
+                            regs.C = Rrc_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x0A: //LD D, RRC (regs.IY+d)
+                            case 0x0A: RM_Z80_OP(fdcb_0A) //LD D, RRC (regs.IY+d)
                                         // Log(string.Format("LD D, RRC (regs.IY + {0:X})", disp));
-                            regs.D = Rrc_R(disp);
+                            regs.D = Rrc_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x0B: //LD E, RRC (regs.IY+d)
+                            case 0x0B: RM_Z80_OP(fdcb_0B) //LD E, RRC (regs.IY+d)
                                         // Log(string.Format("LD E, RRC (regs.IY + {0:X})", disp));
-                            regs.E = Rrc_R(disp);
+                            regs.E = Rrc_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x0C: //LD H, RRC (regs.IY+d)
+                            case 0x0C: RM_Z80_OP(fdcb_0C) //LD H, RRC (regs.IY+d)
                                         // Log(string.Format("LD H, RRC (regs.IY + {0:X})", disp));
-                            regs.H = Rrc_R(disp);
+                            regs.H = Rrc_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x0D: //LD L, RRC (regs.IY+d)
+                            case 0x0D: RM_Z80_OP(fdcb_0D) //LD L, RRC (regs.IY+d)
                                         // Log(string.Format("LD L, RRC (regs.IY + {0:X})", disp));
-                            regs.L = Rrc_R(disp);
+                            regs.L = Rrc_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x0E:  //RRC (regs.IY + d)
+                            case 0x0E: RM_Z80_OP(fdcb_0E)  //RRC (regs.IY + d)
                                         // Log(string.Format("RRC (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Rrc_R(disp));
-                            break;
+                            PokeByte(offset, Rrc_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x0F: //LD A, RRC (regs.IY+d)
+                            case 0x0F: RM_Z80_OP(fdcb_0F) //LD A, RRC (regs.IY+d)
                                         // Log(string.Format("LD A, RRC (regs.IY + {0:X})", disp));
-                            regs.A = Rrc_R(disp);
+                            regs.A = Rrc_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x10: //LD B, RL (regs.IY+d)
+                            case 0x10: RM_Z80_OP(fdcb_10) //LD B, RL (regs.IY+d)
                                         // Log(string.Format("LD B, RL (regs.IY + {0:X})", disp));
-                            regs.B = Rl_R(disp);
+                            regs.B = Rl_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x11: //LD C, RL (regs.IY+d)
+                            case 0x11: RM_Z80_OP(fdcb_11) //LD C, RL (regs.IY+d)
                                         // Log(string.Format("LD C, RL (regs.IY + {0:X})", disp));
-                            regs.C = Rl_R(disp);
+                            regs.C = Rl_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x12: //LD D, RL (regs.IY+d)
+                            case 0x12: RM_Z80_OP(fdcb_12) //LD D, RL (regs.IY+d)
                                         // Log(string.Format("LD D, RL (regs.IY + {0:X})", disp));
-                            regs.D = Rl_R(disp);
+                            regs.D = Rl_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x13: //LD E, RL (regs.IY+d)
+                            case 0x13: RM_Z80_OP(fdcb_13) //LD E, RL (regs.IY+d)
                                         // Log(string.Format("LD E, RL (regs.IY + {0:X})", disp));
-                            regs.E = Rl_R(disp);
+                            regs.E = Rl_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x14: //LD H, RL (regs.IY+d)
+                            case 0x14: RM_Z80_OP(fdcb_14) //LD H, RL (regs.IY+d)
                                         // Log(string.Format("LD H, RL (regs.IY + {0:X})", disp));
-                            regs.H = Rl_R(disp);
+                            regs.H = Rl_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x15: //LD L, RL (regs.IY+d)
+                            case 0x15: RM_Z80_OP(fdcb_15) //LD L, RL (regs.IY+d)
                                         // Log(string.Format("LD L, RL (regs.IY + {0:X})", disp));
-                            regs.L = Rl_R(disp);
+                            regs.L = Rl_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x16:  //RL (regs.IY + d)
+                            case 0x16: RM_Z80_OP(fdcb_16)  //RL (regs.IY + d)
                                         // Log(string.Format("RL (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Rl_R(disp));
+                            PokeByte(offset, Rl_R(b));
 
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x17: //LD A, RL (regs.IY+d)
+                            case 0x17: RM_Z80_OP(fdcb_17) //LD A, RL (regs.IY+d)
                                         // Log(string.Format("LD A, RL (regs.IY + {0:X})", disp));
-                            regs.A = Rl_R(disp);
+                            regs.A = Rl_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x18: //LD B, RR (regs.IY+d)
+                            case 0x18: RM_Z80_OP(fdcb_18) //LD B, RR (regs.IY+d)
                                         // Log(string.Format("LD B, RR (regs.IY + {0:X})", disp));
-                            regs.B = Rr_R(disp);
+                            regs.B = Rr_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x19: //LD C, RR (regs.IY+d)
+                            case 0x19: RM_Z80_OP(fdcb_19) //LD C, RR (regs.IY+d)
                                         // Log(string.Format("LD C, RR (regs.IY + {0:X})", disp));
-                            regs.C = Rr_R(disp);
+                            regs.C = Rr_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x1A: //LD D, RR (regs.IY+d)
+                            case 0x1A: RM_Z80_OP(fdcb_1A) //LD D, RR (regs.IY+d)
                                         // Log(string.Format("LD D, RR (regs.IY + {0:X})", disp));
-                            regs.D = Rr_R(disp);
+                            regs.D = Rr_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x1B: //LD E, RR (regs.IY+d)
+                            case 0x1B: RM_Z80_OP(fdcb_1B) //LD E, RR (regs.IY+d)
                                         // Log(string.Format("LD E, RR (regs.IY + {0:X})", disp));
-                            regs.E = Rr_R(disp);
+                            regs.E = Rr_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x1C: //LD H, RR (regs.IY+d)
+                            case 0x1C: RM_Z80_OP(fdcb_1C) //LD H, RR (regs.IY+d)
                                         // Log(string.Format("LD H, RR (regs.IY + {0:X})", disp));
-                            regs.H = Rr_R(disp);
+                            regs.H = Rr_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x1D: //LD L, RRC (regs.IY+d)
+                            case 0x1D: RM_Z80_OP(fdcb_1D) //LD L, RRC (regs.IY+d)
                                         // Log(string.Format("LD L, RR (regs.IY + {0:X})", disp));
-                            regs.L = Rr_R(disp);
+                            regs.L = Rr_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x1E:  //RR (regs.IY + d)
+                            case 0x1E: RM_Z80_OP(fdcb_1E)  //RR (regs.IY + d)
                                         // Log(string.Format("RR (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Rr_R(disp));
-                            break;
+                            PokeByte(offset, Rr_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x1F: //LD A, RRC (regs.IY+d)
+                            case 0x1F: RM_Z80_OP(fdcb_1F) //LD A, RRC (regs.IY+d)
                                         // Log(string.Format("LD A, RR (regs.IY + {0:X})", disp));
-                            regs.A = Rr_R(disp);
+                            regs.A = Rr_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x20: //LD B, SLA (regs.IY+d)
+                            case 0x20: RM_Z80_OP(fdcb_20) //LD B, SLA (regs.IY+d)
                                         // Log(string.Format("LD B, SLA (regs.IY + {0:X})", disp));
-                            regs.B = Sla_R(disp);
+                            regs.B = Sla_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x21: //LD C, SLA (regs.IY+d)
+                            case 0x21: RM_Z80_OP(fdcb_21) //LD C, SLA (regs.IY+d)
                                         // Log(string.Format("LD C, SLA (regs.IY + {0:X})", disp));
-                            regs.C = Sla_R(disp);
+                            regs.C = Sla_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x22: //LD D, SLA (regs.IY+d)
+                            case 0x22: RM_Z80_OP(fdcb_22) //LD D, SLA (regs.IY+d)
                                         // Log(string.Format("LD D, SLA (regs.IY + {0:X})", disp));
-                            regs.D = Sla_R(disp);
+                            regs.D = Sla_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x23: //LD E, SLA (regs.IY+d)
+                            case 0x23: RM_Z80_OP(fdcb_23) //LD E, SLA (regs.IY+d)
                                         // Log(string.Format("LD E, SLA (regs.IY + {0:X})", disp));
-                            regs.E = Sla_R(disp);
+                            regs.E = Sla_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x24: //LD H, SLA (regs.IY+d)
+                            case 0x24: RM_Z80_OP(fdcb_24) //LD H, SLA (regs.IY+d)
                                         // Log(string.Format("LD H, SLA (regs.IY + {0:X})", disp));
-                            regs.H = Sla_R(disp);
+                            regs.H = Sla_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x25: //LD L, SLA (regs.IY+d)
+                            case 0x25: RM_Z80_OP(fdcb_25) //LD L, SLA (regs.IY+d)
                                         // Log(string.Format("LD L, SLA (regs.IY + {0:X})", disp));
-                            regs.L = Sla_R(disp);
+                            regs.L = Sla_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x26:  //SLA (regs.IY + d)
+                            case 0x26: RM_Z80_OP(fdcb_26)  //SLA (regs.IY + d)
                                         // Log(string.Format("SLA (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Sla_R(disp));
-                            break;
+                            PokeByte(offset, Sla_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x27: //LD A, SLA (regs.IY+d)
+                            case 0x27: RM_Z80_OP(fdcb_27) //LD A, SLA (regs.IY+d)
                                         // Log(string.Format("LD A, SLA (regs.IY + {0:X})", disp));
-                            regs.A = Sla_R(disp);
+                            regs.A = Sla_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x28: //LD B, SRA (regs.IY+d)
+                            case 0x28: RM_Z80_OP(fdcb_28) //LD B, SRA (regs.IY+d)
                                         // Log(string.Format("LD B, SRA (regs.IY + {0:X})", disp));
-                            regs.B = Sra_R(disp);
+                            regs.B = Sra_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x29: //LD C, SRA (regs.IY+d)
+                            case 0x29: RM_Z80_OP(fdcb_29) //LD C, SRA (regs.IY+d)
                                         // Log(string.Format("LD C, SRA (regs.IY + {0:X})", disp));
-                            regs.C = Sra_R(disp);
+                            regs.C = Sra_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x2A: //LD D, SRA (regs.IY+d)
+                            case 0x2A: RM_Z80_OP(fdcb_2A) //LD D, SRA (regs.IY+d)
                                         // Log(string.Format("LD D, SRA (regs.IY + {0:X})", disp));
-                            regs.D = Sra_R(disp);
+                            regs.D = Sra_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x2B: //LD E, SRA (regs.IY+d)
+                            case 0x2B: RM_Z80_OP(fdcb_2B) //LD E, SRA (regs.IY+d)
                                         // Log(string.Format("LD E, SRA (regs.IY + {0:X})", disp));
-                            regs.E = Sra_R(disp);
+                            regs.E = Sra_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x2C: //LD H, SRA (regs.IY+d)
+                            case 0x2C: RM_Z80_OP(fdcb_2C) //LD H, SRA (regs.IY+d)
                                         // Log(string.Format("LD H, SRA (regs.IY + {0:X})", disp));
-                            regs.H = Sra_R(disp);
+                            regs.H = Sra_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x2D: //LD L, SRA (regs.IY+d)
+                            case 0x2D: RM_Z80_OP(fdcb_2D) //LD L, SRA (regs.IY+d)
                                         // Log(string.Format("LD L, SRA (regs.IY + {0:X})", disp));
-                            regs.L = Sra_R(disp);
+                            regs.L = Sra_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x2E:  //SRA (regs.IY + d)
+                            case 0x2E: RM_Z80_OP(fdcb_2E)  //SRA (regs.IY + d)
                                         // Log(string.Format("SRA (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Sra_R(disp));
-                            break;
+                            PokeByte(offset, Sra_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x2F: //LD A, SRA (regs.IY+d)
+                            case 0x2F: RM_Z80_OP(fdcb_2F) //LD A, SRA (regs.IY+d)
                                         // Log(string.Format("LD A, SRA (regs.IY + {0:X})", disp));
-                            regs.A = Sra_R(disp);
+                            regs.A = Sra_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x30: //LD B, SLL (regs.IY+d)
+                            case 0x30: RM_Z80_OP(fdcb_30) //LD B, SLL (regs.IY+d)
                                         // Log(string.Format("LD B, SLL (regs.IY + {0:X})", disp));
-                            regs.B = Sll_R(disp);
+                            regs.B = Sll_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x31: //LD C, SLL (regs.IY+d)
+                            case 0x31: RM_Z80_OP(fdcb_31) //LD C, SLL (regs.IY+d)
                                         // Log(string.Format("LD C, SLL (regs.IY + {0:X})", disp));
-                            regs.C = Sll_R(disp);
+                            regs.C = Sll_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x32: //LD D, SLL (regs.IY+d)
+                            case 0x32: RM_Z80_OP(fdcb_32) //LD D, SLL (regs.IY+d)
                                         // Log(string.Format("LD D, SLL (regs.IY + {0:X})", disp));
-                            regs.D = Sll_R(disp);
+                            regs.D = Sll_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x33: //LD E, SLL (regs.IY+d)
+                            case 0x33: RM_Z80_OP(fdcb_33) //LD E, SLL (regs.IY+d)
                                         // Log(string.Format("LD E, SLL (regs.IY + {0:X})", disp));
-                            regs.E = Sll_R(disp);
+                            regs.E = Sll_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x34: //LD H, SLL (regs.IY+d)
+                            case 0x34: RM_Z80_OP(fdcb_34) //LD H, SLL (regs.IY+d)
                                         // Log(string.Format("LD H, SLL (regs.IY + {0:X})", disp));
-                            regs.H = Sll_R(disp);
+                            regs.H = Sll_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x35: //LD L, SLL (regs.IY+d)
+                            case 0x35: RM_Z80_OP(fdcb_35) //LD L, SLL (regs.IY+d)
                                         // Log(string.Format("LD L, SLL (regs.IY + {0:X})", disp));
-                            regs.L = Sll_R(disp);
+                            regs.L = Sll_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x36:  //SLL (regs.IY + d)
+                            case 0x36: RM_Z80_OP(fdcb_36)  //SLL (regs.IY + d)
                                         // Log(string.Format("SLL (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Sll_R(disp));
-                            break;
+                            PokeByte(offset, Sll_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x37: //LD A, SLL (regs.IY+d)
+                            case 0x37: RM_Z80_OP(fdcb_37) //LD A, SLL (regs.IY+d)
                                         // Log(string.Format("LD A, SLL (regs.IY + {0:X})", disp));
-                            regs.A = Sll_R(disp);
+                            regs.A = Sll_R(b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x38: //LD B, SRL (regs.IY+d)
+                            case 0x38: RM_Z80_OP(fdcb_38) //LD B, SRL (regs.IY+d)
                                         // Log(string.Format("LD B, SRL (regs.IY + {0:X})", disp));
-                            regs.B = Srl_R(disp);
+                            regs.B = Srl_R(b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x39: //LD C, SRL (regs.IY+d)
+                            case 0x39: RM_Z80_OP(fdcb_39) //LD C, SRL (regs.IY+d)
                                         // Log(string.Format("LD C, SRL (regs.IY + {0:X})", disp));
-                            regs.C = Srl_R(disp);
+                            regs.C = Srl_R(b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x3A: //LD D, SRL (regs.IY+d)
+                            case 0x3A: RM_Z80_OP(fdcb_3A) //LD D, SRL (regs.IY+d)
                                         // Log(string.Format("LD D, SRL (regs.IY + {0:X})", disp));
-                            regs.D = Srl_R(disp);
+                            regs.D = Srl_R(b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x3B: //LD E, SRL (regs.IY+d)
+                            case 0x3B: RM_Z80_OP(fdcb_3B) //LD E, SRL (regs.IY+d)
                                         // Log(string.Format("LD E, SRL (regs.IY + {0:X})", disp));
-                            regs.E = Srl_R(disp);
+                            regs.E = Srl_R(b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x3C: //LD H, SRL (regs.IY+d)
+                            case 0x3C: RM_Z80_OP(fdcb_3C) //LD H, SRL (regs.IY+d)
                                         // Log(string.Format("LD H, SRL (regs.IY + {0:X})", disp));
-                            regs.H = Srl_R(disp);
+                            regs.H = Srl_R(b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x3D: //LD L, SRL (regs.IY+d)
+                            case 0x3D: RM_Z80_OP(fdcb_3D) //LD L, SRL (regs.IY+d)
                                         // Log(string.Format("LD L, SRL (regs.IY + {0:X})", disp));
-                            regs.L = Srl_R(disp);
+                            regs.L = Srl_R(b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x3E:  //SRL (regs.IY + d)
+                            case 0x3E: RM_Z80_OP(fdcb_3E)  //SRL (regs.IY + d)
                                         // Log(string.Format("SRL (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Srl_R(disp));
-                            break;
+                            PokeByte(offset, Srl_R(b));
+                            RM_Z80_NEXT;
 
-                            case 0x3F: //LD A, SRL (regs.IY+d)
+                            case 0x3F: RM_Z80_OP(fdcb_3F) //LD A, SRL (regs.IY+d)
                                         // Log(string.Format("LD A, SRL (regs.IY + {0:X})", disp));
-                            regs.A = Srl_R(disp);
+                            regs.A = Srl_R(b);
                             PokeByte(offset, regs.A);
-                            break;
-
-                            case 0x40:  //BIT 0, (regs.IY + d)
-                            case 0x41:  //BIT 0, (regs.IY + d)
-                            case 0x42:  //BIT 0, (regs.IY + d)
-                            case 0x43:  //BIT 0, (regs.IY + d)
-                            case 0x44:  //BIT 0, (regs.IY + d)
-                            case 0x45:  //BIT 0, (regs.IY + d)
-                            case 0x46:  //BIT 0, (regs.IY + d)
-                            case 0x47:  //BIT 0, (regs.IY + d)
+                            RM_Z80_NEXT;
+
+                            case 0x40: RM_Z80_OP(fdcb_40)  //BIT 0, (regs.IY + d)
+                            case 0x41: RM_Z80_OP(fdcb_41)  //BIT 0, (regs.IY + d)
+                            case 0x42: RM_Z80_OP(fdcb_42)  //BIT 0, (regs.IY + d)
+                            case 0x43: RM_Z80_OP(fdcb_43)  //BIT 0, (regs.IY + d)
+                            case 0x44: RM_Z80_OP(fdcb_44)  //BIT 0, (regs.IY + d)
+                            case 0x45: RM_Z80_OP(fdcb_45)  //BIT 0, (regs.IY + d)
+                            case 0x46: RM_Z80_OP(fdcb_46)  //BIT 0, (regs.IY + d)
+                            case 0x47: RM_Z80_OP(fdcb_47)  //BIT 0, (regs.IY + d)
                                         // Log(string.Format("BIT 0, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(0, disp);
-                                break;
-
-                            case 0x48:  //BIT 1, (regs.IY + d)
-                            case 0x49:  //BIT 1, (regs.IY + d)
-                            case 0x4A:  //BIT 1, (regs.IY + d)
-                            case 0x4B:  //BIT 1, (regs.IY + d)
-                            case 0x4C:  //BIT 1, (regs.IY + d)
-                            case 0x4D:  //BIT 1, (regs.IY + d)
-                            case 0x4E:  //BIT 1, (regs.IY + d)
-                            case 0x4F:  //BIT 1, (regs.IY + d)
+                                Bit_MemPtr(0, b);
+                                RM_Z80_NEXT;
+
+                            case 0x48: RM_Z80_OP(fdcb_48)  //BIT 1, (regs.IY + d)
+                            case 0x49: RM_Z80_OP(fdcb_49)  //BIT 1, (regs.IY + d)
+                            case 0x4A: RM_Z80_OP(fdcb_4A)  //BIT 1, (regs.IY + d)
+                            case 0x4B: RM_Z80_OP(fdcb_4B)  //BIT 1, (regs.IY + d)
+                            case 0x4C: RM_Z80_OP(fdcb_4C)  //BIT 1, (regs.IY + d)
+                            case 0x4D: RM_Z80_OP(fdcb_4D)  //BIT 1, (regs.IY + d)
+                            case 0x4E: RM_Z80_OP(fdcb_4E)  //BIT 1, (regs.IY + d)
+                            case 0x4F: RM_Z80_OP(fdcb_4F)  //BIT 1, (regs.IY + d)
                                         // Log(string.Format("BIT 1, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(1, disp);
-                                break;
-
-                            case 0x50:  //BIT 2, (regs.IY + d)
-                            case 0x51:  //BIT 2, (regs.IY + d)
-                            case 0x52:  //BIT 2, (regs.IY + d)
-                            case 0x53:  //BIT 2, (regs.IY + d)
-                            case 0x54:  //BIT 2, (regs.IY + d)
-                            case 0x55:  //BIT 2, (regs.IY + d)
-                            case 0x56:  //BIT 2, (regs.IY + d)
-                            case 0x57:  //BIT 2, (regs.IY + d)
+                                Bit_MemPtr(1, b);
+                                RM_Z80_NEXT;
+
+                            case 0x50: RM_Z80_OP(fdcb_50)  //BIT 2, (regs.IY + d)
+                            case 0x51: RM_Z80_OP(fdcb_51)  //BIT 2, (regs.IY + d)
+                            case 0x52: RM_Z80_OP(fdcb_52)  //BIT 2, (regs.IY + d)
+                            case 0x53: RM_Z80_OP(fdcb_53)  //BIT 2, (regs.IY + d)
+                            case 0x54: RM_Z80_OP(fdcb_54)  //BIT 2, (regs.IY + d)
+                            case 0x55: RM_Z80_OP(fdcb_55)  //BIT 2, (regs.IY + d)
+                            case 0x56: RM_Z80_OP(fdcb_56)  //BIT 2, (regs.IY + d)
+                            case 0x57: RM_Z80_OP(fdcb_57)  //BIT 2, (regs.IY + d)
                                         // Log(string.Format("BIT 2, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(2, disp);
-                                break;
-
-                            case 0x58:  //BIT 3, (regs.IY + d)
-                            case 0x59:  //BIT 3, (regs.IY + d)
-                            case 0x5A:  //BIT 3, (regs.IY + d)
-                            case 0x5B:  //BIT 3, (regs.IY + d)
-                            case 0x5C:  //BIT 3, (regs.IY + d)
-                            case 0x5D:  //BIT 3, (regs.IY + d)
-                            case 0x5E:  //BIT 3, (regs.IY + d)
-                            case 0x5F:  //BIT 3, (regs.IY + d)
+                                Bit_MemPtr(2, b);
+                                RM_Z80_NEXT;
+
+                            case 0x58: RM_Z80_OP(fdcb_58)  //BIT 3, (regs.IY + d)
+                            case 0x59: RM_Z80_OP(fdcb_59)  //BIT 3, (regs.IY + d)
+                            case 0x5A: RM_Z80_OP(fdcb_5A)  //BIT 3, (regs.IY + d)
+                            case 0x5B: RM_Z80_OP(fdcb_5B)  //BIT 3, (regs.IY + d)
+                            case 0x5C: RM_Z80_OP(fdcb_5C)  //BIT 3, (regs.IY + d)
+                            case 0x5D: RM_Z80_OP(fdcb_5D)  //BIT 3, (regs.IY + d)
+                            case 0x5E: RM_Z80_OP(fdcb_5E)  //BIT 3, (regs.IY + d)
+                            case 0x5F: RM_Z80_OP(fdcb_5F)  //BIT 3, (regs.IY + d)
                                         // Log(string.Format("BIT 3, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(3, disp);
-                                break;
-
-                            case 0x60:  //BIT 4, (regs.IY + d)
-                            case 0x61:  //BIT 4, (regs.IY + d)
-                            case 0x62:  //BIT 4, (regs.IY + d)
-                            case 0x63:  //BIT 4, (regs.IY + d)
-                            case 0x64:  //BIT 4, (regs.IY + d)
-                            case 0x65:  //BIT 4, (regs.IY + d)
-                            case 0x66:  //BIT 4, (regs.IY + d)
-                            case 0x67:  //BIT 4, (regs.IY + d)
+                                Bit_MemPtr(3, b);
+                                RM_Z80_NEXT;
+
+                            case 0x60: RM_Z80_OP(fdcb_60)  //BIT 4, (regs.IY + d)
+                            case 0x61: RM_Z80_OP(fdcb_61)  //BIT 4, (regs.IY + d)
+                            case 0x62: RM_Z80_OP(fdcb_62)  //BIT 4, (regs.IY + d)
+                            case 0x63: RM_Z80_OP(fdcb_63)  //BIT 4, (regs.IY + d)
+                            case 0x64: RM_Z80_OP(fdcb_64)  //BIT 4, (regs.IY + d)
+                            case 0x65: RM_Z80_OP(fdcb_65)  //BIT 4, (regs.IY + d)
+                            case 0x66: RM_Z80_OP(fdcb_66)  //BIT 4, (regs.IY + d)
+                            case 0x67: RM_Z80_OP(fdcb_67)  //BIT 4, (regs.IY + d)
                                         // Log(string.Format("BIT 4, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(4, disp);
-                                break;
-
-                            case 0x68:  //BIT 5, (regs.IY + d)
-                            case 0x69:  //BIT 5, (regs.IY + d)
-                            case 0x6A:  //BIT 5, (regs.IY + d)
-                            case 0x6B:  //BIT 5, (regs.IY + d)
-                            case 0x6C:  //BIT 5, (regs.IY + d)
-                            case 0x6D:  //BIT 5, (regs.IY + d)
-                            case 0x6E:  //BIT 5, (regs.IY + d)
-                            case 0x6F:  //BIT 5, (regs.IY + d)
+                                Bit_MemPtr(4, b);
+                                RM_Z80_NEXT;
+
+                            case 0x68: RM_Z80_OP(fdcb_68)  //BIT 5, (regs.IY + d)
+                            case 0x69: RM_Z80_OP(fdcb_69)  //BIT 5, (regs.IY + d)
+                            case 0x6A: RM_Z80_OP(fdcb_6A)  //BIT 5, (regs.IY + d)
+                            case 0x6B: RM_Z80_OP(fdcb_6B)  //BIT 5, (regs.IY + d)
+                            case 0x6C: RM_Z80_OP(fdcb_6C)  //BIT 5, (regs.IY + d)
+                            case 0x6D: RM_Z80_OP(fdcb_6D)  //BIT 5, (regs.IY + d)
+                            case 0x6E: RM_Z80_OP(fdcb_6E)  //BIT 5, (regs.IY + d)
+                            case 0x6F: RM_Z80_OP(fdcb_6F)  //BIT 5, (regs.IY + d)
                                         // Log(string.Format("BIT 5, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(5, disp);
-                                break;
-
-                            case 0x70://BIT 6, (regs.IY + d)
-                            case 0x71://BIT 6, (regs.IY + d)
-                            case 0x72://BIT 6, (regs.IY + d)
-                            case 0x73://BIT 6, (regs.IY + d)
-                            case 0x74://BIT 6, (regs.IY + d)
-                            case 0x75://BIT 6, (regs.IY + d)
-                            case 0x76://BIT 6, (regs.IY + d)
-                            case 0x77:  //BIT 6, (regs.IY + d)
+                                Bit_MemPtr(5, b);
+                                RM_Z80_NEXT;
+
+                            case 0x70: RM_Z80_OP(fdcb_70)//BIT 6, (regs.IY + d)
+                            case 0x71: RM_Z80_OP(fdcb_71)//BIT 6, (regs.IY + d)
+                            case 0x72: RM_Z80_OP(fdcb_72)//BIT 6, (regs.IY + d)
+                            case 0x73: RM_Z80_OP(fdcb_73)//BIT 6, (regs.IY + d)
+                            case 0x74: RM_Z80_OP(fdcb_74)//BIT 6, (regs.IY + d)
+                            case 0x75: RM_Z80_OP(fdcb_75)//BIT 6, (regs.IY + d)
+                            case 0x76: RM_Z80_OP(fdcb_76)//BIT 6, (regs.IY + d)
+                            case 0x77: RM_Z80_OP(fdcb_77)  //BIT 6, (regs.IY + d)
                                         // Log(string.Format("BIT 6, (regs.IY + {0:X})", disp));
-                                Bit_MemPtr(6, disp);
-                                break;
-
-                            case 0x78:  //BIT 7, (regs.IY + d)
-                            case 0x79:  //BIT 7, (regs.IY + d)
-                            case 0x7A:  //BIT 7, (regs.IY + d)
-                            case 0x7B:  //BIT 7, (regs.IY + d)
-                            case 0x7C:  //BIT 7, (regs.IY + d)
-                            case 0x7D:  //BIT 7, (regs.IY + d)
-                            case 0x7E:  //BIT 7, (regs.IY + d)
-                            case 0x7F:  //BIT 7, (regs.IY + d)
+                                Bit_MemPtr(6, b);
+                                RM_Z80_NEXT;
+
+                            case 0x78: RM_Z80_OP(fdcb_78)  //BIT 7, (regs.IY + d)
+                            case 0x79: RM_Z80_OP(fdcb_79)  //BIT 7, (regs.IY + d)
+                            case 0x7A: RM_Z80_OP(fdcb_7A)  //BIT 7, (regs.IY + d)
+                            case 0x7B: RM_Z80_OP(fdcb_7B)  //BIT 7, (regs.IY + d)
+                            case 0x7C: RM_Z80_OP(fdcb_7C)  //BIT 7, (regs.IY + d)
+                            case 0x7D: RM_Z80_OP(fdcb_7D)  //BIT 7, (regs.IY + d)
+                            case 0x7E: RM_Z80_OP(fdcb_7E)  //BIT 7, (regs.IY + d)
+                            case 0x7F: RM_Z80_OP(fdcb_7F)  //BIT 7, (regs.IY + d)
                                         // Log(string.Format("BIT 7, (regs.IY + {0:X})", disp));
-                            Bit_MemPtr(7, disp);
-                            break;
+                            Bit_MemPtr(7, b);
+                            RM_Z80_NEXT;
 
-                            case 0x80: //LD B, RES 0, (regs.IY+d)
+                            case 0x80: RM_Z80_OP(fdcb_80) //LD B, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 0, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(0, disp);
+                            regs.B = Res_R(0, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x81: //LD C, RES 0, (regs.IY+d)
+                            case 0x81: RM_Z80_OP(fdcb_81) //LD C, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 0, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(0, disp);
+                            regs.C = Res_R(0, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x82: //LD D, RES 0, (regs.IY+d)
+                            case 0x82: RM_Z80_OP(fdcb_82) //LD D, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 0, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(0, disp);
+                            regs.D = Res_R(0, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x83: //LD E, RES 0, (regs.IY+d)
+                            case 0x83: RM_Z80_OP(fdcb_83) //LD E, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 0, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(0, disp);
+                            regs.E = Res_R(0, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x84: //LD H, RES 0, (regs.IY+d)
+                            case 0x84: RM_Z80_OP(fdcb_84) //LD H, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 0, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(0, disp);
+                            regs.H = Res_R(0, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x85: //LD L, RES 0, (regs.IY+d)
+                            case 0x85: RM_Z80_OP(fdcb_85) //LD L, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 0, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(0, disp);
+                            regs.L = Res_R(0, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x86:  //RES 0, (regs.IY + d)
+                            case 0x86: RM_Z80_OP(fdcb_86)  //RES 0, (regs.IY + d)
                                         // Log(string.Format("RES 0, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(0, disp));
-                            break;
+                            PokeByte(offset, Res_R(0, b));
+                            RM_Z80_NEXT;
 
-                            case 0x87: //LD A, RES 0, (regs.IY+d)
+                            case 0x87: RM_Z80_OP(fdcb_87) //LD A, RES 0, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 0, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(0, disp);
+                            regs.A = Res_R(0, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x88: //LD B, RES 1, (regs.IY+d)
+                            case 0x88: RM_Z80_OP(fdcb_88) //LD B, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 1, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(1, disp);
+                            regs.B = Res_R(1, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x89: //LD C, RES 1, (regs.IY+d)
+                            case 0x89: RM_Z80_OP(fdcb_89) //LD C, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 1, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(1, disp);
+                            regs.C = Res_R(1, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x8A: //LD D, RES 1, (regs.IY+d)
+                            case 0x8A: RM_Z80_OP(fdcb_8A) //LD D, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 1, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(1, disp);
+                            regs.D = Res_R(1, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x8B: //LD E, RES 1, (regs.IY+d)
+                            case 0x8B: RM_Z80_OP(fdcb_8B) //LD E, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 1, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(1, disp);
+                            regs.E = Res_R(1, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x8C: //LD H, RES 1, (regs.IY+d)
+                            case 0x8C: RM_Z80_OP(fdcb_8C) //LD H, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 1, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(1, disp);
+                            regs.H = Res_R(1, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x8D: //LD L, RES 1, (regs.IY+d)
+                            case 0x8D: RM_Z80_OP(fdcb_8D) //LD L, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 1, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(1, disp);
+                            regs.L = Res_R(1, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x8E:  //RES 1, (regs.IY + d)
+                            case 0x8E: RM_Z80_OP(fdcb_8E)  //RES 1, (regs.IY + d)
                                         // Log(string.Format("RES 1, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(1, disp));
-                            break;
+                            PokeByte(offset, Res_R(1, b));
+                            RM_Z80_NEXT;
 
-                            case 0x8F: //LD A, RES 1, (regs.IY+d)
+                            case 0x8F: RM_Z80_OP(fdcb_8F) //LD A, RES 1, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 1, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(1, disp);
+                            regs.A = Res_R(1, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x90: //LD B, RES 2, (regs.IY+d)
+                            case 0x90: RM_Z80_OP(fdcb_90) //LD B, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 2, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(2, disp);
+                            regs.B = Res_R(2, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x91: //LD C, RES 2, (regs.IY+d)
+                            case 0x91: RM_Z80_OP(fdcb_91) //LD C, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 2, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(2, disp);
+                            regs.C = Res_R(2, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x92: //LD D, RES 2, (regs.IY+d)
+                            case 0x92: RM_Z80_OP(fdcb_92) //LD D, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 2, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(2, disp);
+                            regs.D = Res_R(2, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x93: //LD E, RES 2, (regs.IY+d)
+                            case 0x93: RM_Z80_OP(fdcb_93) //LD E, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 2, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(2, disp);
+                            regs.E = Res_R(2, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x94: //LD H, RES 2, (regs.IY+d)
+                            case 0x94: RM_Z80_OP(fdcb_94) //LD H, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 2, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(2, disp);
+                            regs.H = Res_R(2, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x95: //LD L, RES 2, (regs.IY+d)
+                            case 0x95: RM_Z80_OP(fdcb_95) //LD L, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 2, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(2, disp);
+                            regs.L = Res_R(2, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x96:  //RES 2, (regs.IY + d)
+                            case 0x96: RM_Z80_OP(fdcb_96)  //RES 2, (regs.IY + d)
                                         // Log(string.Format("RES 2, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(2, disp));
-                            break;
+                            PokeByte(offset, Res_R(2, b));
+                            RM_Z80_NEXT;
 
-                            case 0x97: //LD A, RES 2, (regs.IY+d)
+                            case 0x97: RM_Z80_OP(fdcb_97) //LD A, RES 2, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 2, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(2, disp);
+                            regs.A = Res_R(2, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x98: //LD B, RES 3, (regs.IY+d)
+                            case 0x98: RM_Z80_OP(fdcb_98) //LD B, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 3, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(3, disp);
+                            regs.B = Res_R(3, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x99: //LD C, RES 3, (regs.IY+d)
+                            case 0x99: RM_Z80_OP(fdcb_99) //LD C, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 3, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(3, disp);
+                            regs.C = Res_R(3, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x9A: //LD D, RES 3, (regs.IY+d)
+                            case 0x9A: RM_Z80_OP(fdcb_9A) //LD D, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 3, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(3, disp);
+                            regs.D = Res_R(3, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x9B: //LD E, RES 3, (regs.IY+d)
+                            case 0x9B: RM_Z80_OP(fdcb_9B) //LD E, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 3, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(3, disp);
+                            regs.E = Res_R(3, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x9C: //LD H, RES 3, (regs.IY+d)
+                            case 0x9C: RM_Z80_OP(fdcb_9C) //LD H, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 3, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(3, disp);
+                            regs.H = Res_R(3, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x9D: //LD L, RES 3, (regs.IY+d)
+                            case 0x9D: RM_Z80_OP(fdcb_9D) //LD L, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 3, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(3, disp);
+                            regs.L = Res_R(3, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0x9E:  //RES 3, (regs.IY + d)
+                            case 0x9E: RM_Z80_OP(fdcb_9E)  //RES 3, (regs.IY + d)
                                         // Log(string.Format("RES 3, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(3, disp));
-                            break;
+                            PokeByte(offset, Res_R(3, b));
+                            RM_Z80_NEXT;
 
-                            case 0x9F: //LD A, RES 3, (regs.IY+d)
+                            case 0x9F: RM_Z80_OP(fdcb_9F) //LD A, RES 3, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 3, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(3, disp);
+                            regs.A = Res_R(3, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA0: //LD B, RES 4, (regs.IY+d)
+                            case 0xA0: RM_Z80_OP(fdcb_A0) //LD B, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 4, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(4, disp);
+                            regs.B = Res_R(4, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA1: //LD C, RES 4, (regs.IY+d)
+                            case 0xA1: RM_Z80_OP(fdcb_A1) //LD C, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 4, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(4, disp);
+                            regs.C = Res_R(4, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA2: //LD D, RES 4, (regs.IY+d)
+                            case 0xA2: RM_Z80_OP(fdcb_A2) //LD D, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 4, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(4, disp);
+                            regs.D = Res_R(4, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA3: //LD E, RES 4, (regs.IY+d)
+                            case 0xA3: RM_Z80_OP(fdcb_A3) //LD E, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 4, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(4, disp);
+                            regs.E = Res_R(4, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA4: //LD H, RES 4, (regs.IY+d)
+                            case 0xA4: RM_Z80_OP(fdcb_A4) //LD H, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 4, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(4, disp);
+                            regs.H = Res_R(4, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA5: //LD L, RES 4, (regs.IY+d)
+                            case 0xA5: RM_Z80_OP(fdcb_A5) //LD L, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 4, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(4, disp);
+                            regs.L = Res_R(4, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA6:  //RES 4, (regs.IY + d)
+                            case 0xA6: RM_Z80_OP(fdcb_A6)  //RES 4, (regs.IY + d)
                                         // Log(string.Format("RES 4, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(4, disp));
-                            break;
+                            PokeByte(offset, Res_R(4, b));
+                            RM_Z80_NEXT;
 
-                            case 0xA7: //LD A, RES 4, (regs.IY+d)
+                            case 0xA7: RM_Z80_OP(fdcb_A7) //LD A, RES 4, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 4, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(4, disp);
+                            regs.A = Res_R(4, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA8: //LD B, RES 5, (regs.IY+d)
+                            case 0xA8: RM_Z80_OP(fdcb_A8) //LD B, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 5, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(5, disp);
+                            regs.B = Res_R(5, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xA9: //LD C, RES 5, (regs.IY+d)
+                            case 0xA9: RM_Z80_OP(fdcb_A9) //LD C, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 5, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(5, disp);
+                            regs.C = Res_R(5, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xAA: //LD D, RES 5, (regs.IY+d)
+                            case 0xAA: RM_Z80_OP(fdcb_AA) //LD D, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 5, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(5, disp);
+                            regs.D = Res_R(5, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xAB: //LD E, RES 5, (regs.IY+d)
+                            case 0xAB: RM_Z80_OP(fdcb_AB) //LD E, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 5, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(5, disp);
+                            regs.E = Res_R(5, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xAC: //LD H, RES 5, (regs.IY+d)
+                            case 0xAC: RM_Z80_OP(fdcb_AC) //LD H, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 5, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(5, disp);
+                            regs.H = Res_R(5, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xAD: //LD L, RES 5, (regs.IY+d)
+                            case 0xAD: RM_Z80_OP(fdcb_AD) //LD L, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 5, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(5, disp);
+                            regs.L = Res_R(5, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xAE:  //RES 5, (regs.IY + d)
+                            case 0xAE: RM_Z80_OP(fdcb_AE)  //RES 5, (regs.IY + d)
                                         // Log(string.Format("RES 5, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(5, disp));
-                            break;
+                            PokeByte(offset, Res_R(5, b));
+                            RM_Z80_NEXT;
 
-                            case 0xAF: //LD A, RES 5, (regs.IY+d)
+                            case 0xAF: RM_Z80_OP(fdcb_AF) //LD A, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 5, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(5, disp);
+                            regs.A = Res_R(5, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB0: //LD B, RES 6, (regs.IY+d)
+                            case 0xB0: RM_Z80_OP(fdcb_B0) //LD B, RES 6, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 6, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(6, disp);
+                            regs.B = Res_R(6, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB1: //LD C, RES 6, (regs.IY+d)
+                            case 0xB1: RM_Z80_OP(fdcb_B1) //LD C, RES 6, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 6, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(6, disp);
+                            regs.C = Res_R(6, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB2: //LD D, RES 6, (regs.IY+d)
+                            case 0xB2: RM_Z80_OP(fdcb_B2) //LD D, RES 6, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 6, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(6, disp);
+                            regs.D = Res_R(6, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB3: //LD E, RES 6, (regs.IY+d)
+                            case 0xB3: RM_Z80_OP(fdcb_B3) //LD E, RES 6, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 6, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(6, disp);
+                            regs.E = Res_R(6, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB4: //LD H, RES 5, (regs.IY+d)
+                            case 0xB4: RM_Z80_OP(fdcb_B4) //LD H, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 6, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(6, disp);
+                            regs.H = Res_R(6, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB5: //LD L, RES 5, (regs.IY+d)
+                            case 0xB5: RM_Z80_OP(fdcb_B5) //LD L, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 6, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(6, disp);
+                            regs.L = Res_R(6, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB6:  //RES 6, (regs.IY + d)
+                            case 0xB6: RM_Z80_OP(fdcb_B6)  //RES 6, (regs.IY + d)
                                         // Log(string.Format("RES 6, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(6, disp));
-                            break;
+                            PokeByte(offset, Res_R(6, b));
+                            RM_Z80_NEXT;
 
-                            case 0xB7: //LD A, RES 5, (regs.IY+d)
+                            case 0xB7: RM_Z80_OP(fdcb_B7) //LD A, RES 5, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 6, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(6, disp);
+                            regs.A = Res_R(6, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB8: //LD B, RES 7, (regs.IY+d)
+                            case 0xB8: RM_Z80_OP(fdcb_B8) //LD B, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD B, RES 7, (regs.IY + {0:X})", disp));
-                            regs.B = Res_R(7, disp);
+                            regs.B = Res_R(7, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xB9: //LD C, RES 7, (regs.IY+d)
+                            case 0xB9: RM_Z80_OP(fdcb_B9) //LD C, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD C, RES 7, (regs.IY + {0:X})", disp));
-                            regs.C = Res_R(7, disp);
+                            regs.C = Res_R(7, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xBA: //LD D, RES 7, (regs.IY+d)
+                            case 0xBA: RM_Z80_OP(fdcb_BA) //LD D, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD D, RES 7, (regs.IY + {0:X})", disp));
-                            regs.D = Res_R(7, disp);
+                            regs.D = Res_R(7, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xBB: //LD E, RES 7, (regs.IY+d)
+                            case 0xBB: RM_Z80_OP(fdcb_BB) //LD E, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD E, RES 7, (regs.IY + {0:X})", disp));
-                            regs.E = Res_R(7, disp);
+                            regs.E = Res_R(7, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xBC: //LD H, RES 7, (regs.IY+d)
+                            case 0xBC: RM_Z80_OP(fdcb_BC) //LD H, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD H, RES 7, (regs.IY + {0:X})", disp));
-                            regs.H = Res_R(7, disp);
+                            regs.H = Res_R(7, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xBD: //LD L, RES 7, (regs.IY+d)
+                            case 0xBD: RM_Z80_OP(fdcb_BD) //LD L, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD L, RES 7, (regs.IY + {0:X})", disp));
-                            regs.L = Res_R(7, disp);
+                            regs.L = Res_R(7, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xBE:  //RES 7, (regs.IY + d)
+                            case 0xBE: RM_Z80_OP(fdcb_BE)  //RES 7, (regs.IY + d)
                                         // Log(string.Format("RES 7, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Res_R(7, disp));
-                            break;
+                            PokeByte(offset, Res_R(7, b));
+                            RM_Z80_NEXT;
 
-                            case 0xBF: //LD A, RES 7, (regs.IY+d)
+                            case 0xBF: RM_Z80_OP(fdcb_BF) //LD A, RES 7, (regs.IY+d)
                                         // Log(string.Format("LD A, RES 7, (regs.IY + {0:X})", disp));
-                            regs.A = Res_R(7, disp);
+                            regs.A = Res_R(7, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC0: //LD B, SET 0, (regs.IY+d)
+                            case 0xC0: RM_Z80_OP(fdcb_C0) //LD B, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 0, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(0, disp);
+                            regs.B = Set_R(0, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC1: //LD C, SET 0, (regs.IY+d)
+                            case 0xC1: RM_Z80_OP(fdcb_C1) //LD C, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 0, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(0, disp);
+                            regs.C = Set_R(0, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC2: //LD D, SET 0, (regs.IY+d)
+                            case 0xC2: RM_Z80_OP(fdcb_C2) //LD D, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 0, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(0, disp);
+                            regs.D = Set_R(0, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC3: //LD E, SET 0, (regs.IY+d)
+                            case 0xC3: RM_Z80_OP(fdcb_C3) //LD E, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 0, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(0, disp);
+                            regs.E = Set_R(0, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC4: //LD H, SET 0, (regs.IY+d)
+                            case 0xC4: RM_Z80_OP(fdcb_C4) //LD H, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 0, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(0, disp);
+                            regs.H = Set_R(0, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC5: //LD L, SET 0, (regs.IY+d)
+                            case 0xC5: RM_Z80_OP(fdcb_C5) //LD L, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 0, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(0, disp);
+                            regs.L = Set_R(0, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC6:  //SET 0, (regs.IY + d)
+                            case 0xC6: RM_Z80_OP(fdcb_C6)  //SET 0, (regs.IY + d)
                                         // Log(string.Format("SET 0, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(0, disp));
-                            break;
+                            PokeByte(offset, Set_R(0, b));
+                            RM_Z80_NEXT;
 
-                            case 0xC7: //LD A, SET 0, (regs.IY+d)
+                            case 0xC7: RM_Z80_OP(fdcb_C7) //LD A, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 0, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(0, disp);
+                            regs.A = Set_R(0, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC8: //LD B, SET 1, (regs.IY+d)
+                            case 0xC8: RM_Z80_OP(fdcb_C8) //LD B, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 1, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(1, disp);
+                            regs.B = Set_R(1, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xC9: //LD C, SET 0, (regs.IY+d)
+                            case 0xC9: RM_Z80_OP(fdcb_C9) //LD C, SET 0, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 1, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(1, disp);
+                            regs.C = Set_R(1, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xCA: //LD D, SET 1, (regs.IY+d)
+                            case 0xCA: RM_Z80_OP(fdcb_CA) //LD D, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 1, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(1, disp);
+                            regs.D = Set_R(1, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xCB: //LD E, SET 1, (regs.IY+d)
+                            case 0xCB: RM_Z80_OP(fdcb_CB) //LD E, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 1, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(1, disp);
+                            regs.E = Set_R(1, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xCC: //LD H, SET 1, (regs.IY+d)
+                            case 0xCC: RM_Z80_OP(fdcb_CC) //LD H, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 1, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(1, disp);
+                            regs.H = Set_R(1, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xCD: //LD L, SET 1, (regs.IY+d)
+                            case 0xCD: RM_Z80_OP(fdcb_CD) //LD L, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 1, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(1, disp);
+                            regs.L = Set_R(1, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xCE:  //SET 1, (regs.IY + d)
+                            case 0xCE: RM_Z80_OP(fdcb_CE)  //SET 1, (regs.IY + d)
                                         // Log(string.Format("SET 1, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(1, disp));
-                            break;
+                            PokeByte(offset, Set_R(1, b));
+                            RM_Z80_NEXT;
 
-                            case 0xCF: //LD A, SET 1, (regs.IY+d)
+                            case 0xCF: RM_Z80_OP(fdcb_CF) //LD A, SET 1, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 1, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(1, disp);
+                            regs.A = Set_R(1, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD0: //LD B, SET 2, (regs.IY+d)
+                            case 0xD0: RM_Z80_OP(fdcb_D0) //LD B, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 2, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(2, disp);
+                            regs.B = Set_R(2, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD1: //LD C, SET 2, (regs.IY+d)
+                            case 0xD1: RM_Z80_OP(fdcb_D1) //LD C, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 2, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(2, disp);
+                            regs.C = Set_R(2, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD2: //LD D, SET 2, (regs.IY+d)
+                            case 0xD2: RM_Z80_OP(fdcb_D2) //LD D, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 2, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(2, disp);
+                            regs.D = Set_R(2, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD3: //LD E, SET 2, (regs.IY+d)
+                            case 0xD3: RM_Z80_OP(fdcb_D3) //LD E, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 2, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(2, disp);
+                            regs.E = Set_R(2, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD4: //LD H, SET 21, (regs.IY+d)
+                            case 0xD4: RM_Z80_OP(fdcb_D4) //LD H, SET 21, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 2, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(2, disp);
+                            regs.H = Set_R(2, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD5: //LD L, SET 2, (regs.IY+d)
+                            case 0xD5: RM_Z80_OP(fdcb_D5) //LD L, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 2, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(2, disp);
+                            regs.L = Set_R(2, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD6:  //SET 2, (regs.IY + d)
+                            case 0xD6: RM_Z80_OP(fdcb_D6)  //SET 2, (regs.IY + d)
                                         // Log(string.Format("SET 2, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(2, disp));
-                            break;
+                            PokeByte(offset, Set_R(2, b));
+                            RM_Z80_NEXT;
 
-                            case 0xD7: //LD A, SET 2, (regs.IY+d)
+                            case 0xD7: RM_Z80_OP(fdcb_D7) //LD A, SET 2, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 2, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(2, disp);
+                            regs.A = Set_R(2, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD8: //LD B, SET 3, (regs.IY+d)
+                            case 0xD8: RM_Z80_OP(fdcb_D8) //LD B, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 3, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(3, disp);
+                            regs.B = Set_R(3, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xD9: //LD C, SET 3, (regs.IY+d)
+                            case 0xD9: RM_Z80_OP(fdcb_D9) //LD C, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 3, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(3, disp);
+                            regs.C = Set_R(3, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xDA: //LD D, SET 3, (regs.IY+d)
+                            case 0xDA: RM_Z80_OP(fdcb_DA) //LD D, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 3, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(3, disp);
+                            regs.D = Set_R(3, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xDB: //LD E, SET 3, (regs.IY+d)
+                            case 0xDB: RM_Z80_OP(fdcb_DB) //LD E, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 3, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(3, disp);
+                            regs.E = Set_R(3, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xDC: //LD H, SET 21, (regs.IY+d)
+                            case 0xDC: RM_Z80_OP(fdcb_DC) //LD H, SET 21, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 3, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(3, disp);
+                            regs.H = Set_R(3, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xDD: //LD L, SET 3, (regs.IY+d)
+                            case 0xDD: RM_Z80_OP(fdcb_DD) //LD L, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 3, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(3, disp);
+                            regs.L = Set_R(3, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xDE:  //SET 3, (regs.IY + d)
+                            case 0xDE: RM_Z80_OP(fdcb_DE)  //SET 3, (regs.IY + d)
                                         // Log(string.Format("SET 3, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(3, disp));
-                            break;
+                            PokeByte(offset, Set_R(3, b));
+                            RM_Z80_NEXT;
 
-                            case 0xDF: //LD A, SET 3, (regs.IY+d)
+                            case 0xDF: RM_Z80_OP(fdcb_DF) //LD A, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 3, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(3, disp);
+                            regs.A = Set_R(3, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE0: //LD B, SET 4, (regs.IY+d)
+                            case 0xE0: RM_Z80_OP(fdcb_E0) //LD B, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 4, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(4, disp);
+                            regs.B = Set_R(4, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE1: //LD C, SET 4, (regs.IY+d)
+                            case 0xE1: RM_Z80_OP(fdcb_E1) //LD C, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 4, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(4, disp);
+                            regs.C = Set_R(4, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE2: //LD D, SET 4, (regs.IY+d)
+                            case 0xE2: RM_Z80_OP(fdcb_E2) //LD D, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 4, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(4, disp);
+                            regs.D = Set_R(4, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE3: //LD E, SET 4, (regs.IY+d)
+                            case 0xE3: RM_Z80_OP(fdcb_E3) //LD E, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 4, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(4, disp);
+                            regs.E = Set_R(4, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE4: //LD H, SET 4, (regs.IY+d)
+                            case 0xE4: RM_Z80_OP(fdcb_E4) //LD H, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 4, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(4, disp);
+                            regs.H = Set_R(4, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE5: //LD L, SET 3, (regs.IY+d)
+                            case 0xE5: RM_Z80_OP(fdcb_E5) //LD L, SET 3, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 4, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(4, disp);
+                            regs.L = Set_R(4, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE6:  //SET 4, (regs.IY + d)
+                            case 0xE6: RM_Z80_OP(fdcb_E6)  //SET 4, (regs.IY + d)
                                         // Log(string.Format("SET 4, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(4, disp));
-                            break;
+                            PokeByte(offset, Set_R(4, b));
+                            RM_Z80_NEXT;
 
-                            case 0xE7: //LD A, SET 4, (regs.IY+d)
+                            case 0xE7: RM_Z80_OP(fdcb_E7) //LD A, SET 4, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 4, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(4, disp);
+                            regs.A = Set_R(4, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE8: //LD B, SET 5, (regs.IY+d)
+                            case 0xE8: RM_Z80_OP(fdcb_E8) //LD B, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 5, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(5, disp);
+                            regs.B = Set_R(5, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xE9: //LD C, SET 5, (regs.IY+d)
+                            case 0xE9: RM_Z80_OP(fdcb_E9) //LD C, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 5, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(5, disp);
+                            regs.C = Set_R(5, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xEA: //LD D, SET 5, (regs.IY+d)
+                            case 0xEA: RM_Z80_OP(fdcb_EA) //LD D, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 5, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(5, disp);
+                            regs.D = Set_R(5, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xEB: //LD E, SET 5, (regs.IY+d)
+                            case 0xEB: RM_Z80_OP(fdcb_EB) //LD E, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 5, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(5, disp);
+                            regs.E = Set_R(5, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xEC: //LD H, SET 5, (regs.IY+d)
+                            case 0xEC: RM_Z80_OP(fdcb_EC) //LD H, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 5, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(5, disp);
+                            regs.H = Set_R(5, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xED: //LD L, SET 5, (regs.IY+d)
+                            case 0xED: RM_Z80_OP(fdcb_ED) //LD L, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 5, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(5, disp);
+                            regs.L = Set_R(5, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xEE:  //SET 5, (regs.IY + d)
+                            case 0xEE: RM_Z80_OP(fdcb_EE)  //SET 5, (regs.IY + d)
                                         // Log(string.Format("SET 5, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(5, disp));
-                            break;
+                            PokeByte(offset, Set_R(5, b));
+                            RM_Z80_NEXT;
 
-                            case 0xEF: //LD A, SET 5, (regs.IY+d)
+                            case 0xEF: RM_Z80_OP(fdcb_EF) //LD A, SET 5, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 5, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(5, disp);
+                            regs.A = Set_R(5, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF0: //LD B, SET 6, (regs.IY+d)
+                            case 0xF0: RM_Z80_OP(fdcb_F0) //LD B, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 6, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(6, disp);
+                            regs.B = Set_R(6, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF1: //LD C, SET 6, (regs.IY+d)
+                            case 0xF1: RM_Z80_OP(fdcb_F1) //LD C, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 6, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(6, disp);
+                            regs.C = Set_R(6, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF2: //LD D, SET 6, (regs.IY+d)
+                            case 0xF2: RM_Z80_OP(fdcb_F2) //LD D, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 6, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(6, disp);
+                            regs.D = Set_R(6, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF3: //LD E, SET 6, (regs.IY+d)
+                            case 0xF3: RM_Z80_OP(fdcb_F3) //LD E, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 6, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(6, disp);
+                            regs.E = Set_R(6, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF4: //LD H, SET 6, (regs.IY+d)
+                            case 0xF4: RM_Z80_OP(fdcb_F4) //LD H, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 6, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(6, disp);
+                            regs.H = Set_R(6, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF5: //LD L, SET 6, (regs.IY+d)
+                            case 0xF5: RM_Z80_OP(fdcb_F5) //LD L, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 6, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(6, disp);
+                            regs.L = Set_R(6, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF6:  //SET 6, (regs.IY + d)
+                            case 0xF6: RM_Z80_OP(fdcb_F6)  //SET 6, (regs.IY + d)
                                         // Log(string.Format("SET 6, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(6, disp));
-                            break;
+                            PokeByte(offset, Set_R(6, b));
+                            RM_Z80_NEXT;
 
-                            case 0xF7: //LD A, SET 6, (regs.IY+d)
+                            case 0xF7: RM_Z80_OP(fdcb_F7) //LD A, SET 6, (regs.IY+d)
                                         // Log(string.Format("LD A, SET 6, (regs.IY + {0:X})", disp));
-                            regs.A = Set_R(6, disp);
+                            regs.A = Set_R(6, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF8: //LD B, SET 7, (regs.IY+d)
+                            case 0xF8: RM_Z80_OP(fdcb_F8) //LD B, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD B, SET 7, (regs.IY + {0:X})", disp));
-                            regs.B = Set_R(7, disp);
+                            regs.B = Set_R(7, b);
                             PokeByte(offset, regs.B);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xF9: //LD C, SET 7, (regs.IY+d)
+                            case 0xF9: RM_Z80_OP(fdcb_F9) //LD C, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD C, SET 7, (regs.IY + {0:X})", disp));
-                            regs.C = Set_R(7, disp);
+                            regs.C = Set_R(7, b);
                             PokeByte(offset, regs.C);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xFA: //LD D, SET 7, (regs.IY+d)
+                            case 0xFA: RM_Z80_OP(fdcb_FA) //LD D, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD D, SET 7, (regs.IY + {0:X})", disp));
-                            regs.D = Set_R(7, disp);
+                            regs.D = Set_R(7, b);
                             PokeByte(offset, regs.D);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xFB: //LD E, SET 7, (regs.IY+d)
+                            case 0xFB: RM_Z80_OP(fdcb_FB) //LD E, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD E, SET 7, (regs.IY + {0:X})", disp));
-                            regs.E = Set_R(7, disp);
+                            regs.E = Set_R(7, b);
                             PokeByte(offset, regs.E);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xFC: //LD H, SET 7, (regs.IY+d)
+                            case 0xFC: RM_Z80_OP(fdcb_FC) //LD H, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD H, SET 7, (regs.IY + {0:X})", disp));
-                            regs.H = Set_R(7, disp);
+                            regs.H = Set_R(7, b);
                             PokeByte(offset, regs.H);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xFD: //LD L, SET 7, (regs.IY+d)
+                            case 0xFD: RM_Z80_OP(fdcb_FD) //LD L, SET 7, (regs.IY+d)
                                         // Log(string.Format("LD L, SET 7, (regs.IY + {0:X})", disp));
-                            regs.L = Set_R(7, disp);
+                            regs.L = Set_R(7, b);
                             PokeByte(offset, regs.L);
-                            break;
+                            RM_Z80_NEXT;
 
-                            case 0xFE:  //SET 7, (regs.IY + d)
+                            case 0xFE: RM_Z80_OP(fdcb_FE)  //SET 7, (regs.IY + d)
                                         // Log(string.Format("SET 7, (regs.IY + {0:X})", disp));
-                            PokeByte(offset, Set_R(7, disp));
-                            break;
+                            PokeByte(offset, Set_R(7, b));
+                            RM_Z80_NEXT;
 
-                            case 0xFF: //LD A, SET 7, (regs.IY + D)
-                            regs.A = Set_R(7, disp);
+                            case 0xFF: RM_Z80_OP(fdcb_FF) //LD A, SET 7, (regs.IY + D)
+                            regs.A = Set_R(7, b);
                             PokeByte(offset, regs.A);
-                            break;
+                            RM_Z80_NEXT;
 
                             default:
                             assert(false);
                             //System.String msg = "ERROR: Could not handle FDCB " + opcode.ToString();
                             //System.Windows.Forms.MessageBox.Show(msg, "Opcode handler",
                             //            System.Windows.Forms.MessageBoxButtons.OKCancel, System.Windows.Forms.MessageBoxIcon.Error);
-                            break;
+                            RM_Z80_NEXT;
                         }
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xE1:  //POP regs.IY
+                    case 0xE1: RM_Z80_OP(fd_E1)  //POP regs.IY
                                 // Log("POP regs.IY");
                     regs.IY = PopStack();
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE5:  //PUSH regs.IY
+                    case 0xE5: RM_Z80_OP(fd_E5)  //PUSH regs.IY
                                 // Log("PUSH regs.IY");
                     Contend(regs.IR(), 1, 1);
                     PushStack(regs.IY);
-                    break;
+                    RM_Z80_NEXT;
 
-                    case 0xE3:  //EX (regs.SP), regs.IY
+                    case 0xE3: RM_Z80_OP(fd_E3)  //EX (regs.SP), regs.IY
                     {
                         // Log("EX (regs.SP), regs.IY");
                         addr = PeekWord(regs.SP);
@@ -8572,24 +9228,34 @@ namespace rm {
                         Contend(regs.SP, 1, 2);
                         regs.IY = addr;
                         regs.MemPtr = regs.IY;
-                        break;
+                        RM_Z80_NEXT;
                     }
 
-                    case 0xE9:  //JP (regs.IY)
+                    case 0xE9: RM_Z80_OP(fd_E9)  //JP (regs.IY)
                                 // Log("JP (regs.IY)");
                     regs.PC = regs.IY;
-                    break;
+                    RM_Z80_NEXT;
 
-                    default:
+                    default: RM_Z80_OP(fd_default)
                     //According to Sean's doc: http://z80.info/z80sean.txt
                     //If a DDxx or FDxx instruction is not listed, it should operate as
                     //without the DD or FD prefix, and the DD or FD prefix itself should
                     //operate as a NOP.
+#if RM_Z80_COMPUTED_GOTO
+                    RM_Z80_DISPATCH(main, opcode);  //Re-dispatch as a normal instruction
+#else
                     Execute(opcode);      //Try and execute it as a normal instruction then
-                    break;
+#endif
+                    RM_Z80_NEXT;
                 }
-                break;
+                RM_Z80_NEXT;
             }
+
+            return count;
         }
     };
+
+    //The std::function driven core, for debuggers and anything else that
+    //needs to rewire the bus at runtime.
+    typedef Z80Core<FunctionBus> Z80;
 }
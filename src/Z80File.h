@@ -2,6 +2,7 @@
 
 #include "Types.h"
 
+#include <string.h>
 #include <vector>
 
 namespace rm {
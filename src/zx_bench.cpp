@@ -0,0 +1,471 @@
+// zx-bench: headless benchmark for the zx_spectrum core.
+//
+// Boots a 48K machine, optionally loads a SNA or Z80 snapshot, runs N frames with no
+// window or sound card and reports MIPS, frames per second and ns per emulated tstate,
+// with the host time split between cpu, rendering, audio and tape. Without a snapshot it
+// runs the built-in synthetic workloads:
+//
+//   alu         tight 8-bit ALU loop in uncontended memory
+//   ldir        repeated 4K LDIR block copies
+//   border      OUT (0xfe) border stripes, one border log entry per write
+//   contention  code and data in contended memory, rewriting the whole screen
+//
+// The workloads disable interrupts and don't need a ROM. A snapshot does (--rom).
+// SZX snapshots aren't supported, zx_spectrum::UseSZX() is still compiled out.
+//
+// Build with the CMakeLists.txt in the repository root, or by hand from the root.
+// RM_SUBSYSTEM_TIMERS has to be the same in every translation unit, since zx_spectrum.h
+// is mostly inline. Without it the MIPS and subsystem columns read n/a:
+//
+//   cmake -S . -B build && cmake --build build
+//
+//   g++ -std=c++17 -O2 -DRM_SUBSYSTEM_TIMERS=1 -I src src/zx_bench.cpp src/Z80.cpp
+//       src/PixelKernel.cpp src/ULA_Plus.cpp src/zx_spectrum.cpp -o zx-bench
+//
+//   zx-bench [--frames N] [--workload NAME|all] [--rom 48.rom] [--snapshot FILE]
+//            [--batch] [--fast] [--profile]
+//   zx-bench --selftest
+//
+// --profile runs the guest profiler alongside and prints its reports after each workload.
+// --selftest checks every pixel kernel the host supports against the reference renderer,
+// checks that two machines running the same workload deterministically end with the same
+// StateHash(), and exits non-zero on a mismatch.
+
+#include "PixelKernel.h"
+#include "SNAFile.h"
+#include "Z80File.h"
+#include "zx_spectrum.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace rm;
+
+    //Minimal 48K model for headless runs: standard 48K geometry, contention and memory map.
+    class Bench48k : public zx_spectrum
+    {
+    public:
+        static const int TABLE_LENGTH = 70930;
+        static const int CONTENTION_START = 14335;
+
+        Bench48k() : zx_spectrum(0, false) {
+            model = MachineModel::_48k;
+            InterruptPeriod = 32;
+            FrameLength = 69888;
+            clockSpeed = 3.50000;
+
+            CharRows = 24;
+            CharCols = 32;
+            ScreenWidth = 256;
+            ScreenHeight = 192;
+            BorderTopHeight = 48;
+            BorderBottomHeight = 56;
+            BorderLeftWidth = 48;
+            BorderRightWidth = 48;
+            DisplayStart = 16384;
+            DisplayLength = 6144;
+            AttributeStart = 22528;
+            AttributeLength = 768;
+            borderColour = 7;
+            ScanLineWidth = BorderLeftWidth + ScreenWidth + BorderRightWidth;
+            TstatesPerScanline = 224;
+            ActualULAStart = CONTENTION_START + 1 - (BorderLeftWidth / 2) - TstatesPerScanline * BorderTopHeight;
+
+            ScreenBuffer.assign(ScanLineWidth * (BorderTopHeight + ScreenHeight + BorderBottomHeight), 0);
+            LastScanlineColor.assign(ScanLineWidth, 0);
+            floatingBusTable.assign(TABLE_LENGTH, -1);
+            screen.assign(DisplayLength + AttributeLength, 0);
+            attr.assign(DisplayLength, 0);
+
+            BuildContentionTable();
+            BuildDisplayTable();
+            BuildAttributeMap();
+            SetEmulationSpeed(1);
+
+            Reset(true);
+        }
+
+        bool LoadROM(string path, string filename) override {
+            std::vector<byte> rom;
+
+            if (!ReadFile(path + filename, rom) || rom.size() < 16384)
+                return false;
+
+            memcpy(ROMpage[0], rom.data(), 8192);
+            memcpy(ROMpage[1], rom.data() + 8192, 8192);
+            return true;
+        }
+
+        bool IsContended(int addr) override {
+            return (addr & 0xc000) == 0x4000;
+        }
+
+        void BuildContentionTable() override {
+            static const byte pattern[8] = { 6, 5, 4, 3, 2, 1, 0, 0 };
+
+            contentionTable.assign(TABLE_LENGTH, 0);
+
+            for (int line = 0; line < ScreenHeight; line++) {
+                int start = CONTENTION_START + LateTiming + line * TstatesPerScanline;
+
+                for (int t = 0; t < 128; t++)
+                    contentionTable[start + t] = pattern[t & 7];
+            }
+        }
+
+        void Reset(bool hardReset) override {
+            zx_spectrum::Reset(hardReset);
+
+            PageReadPointer[0] = ROMpage[0];
+            PageReadPointer[1] = ROMpage[1];
+            PageWritePointer[0] = JunkMemory[0];
+            PageWritePointer[1] = JunkMemory[1];
+
+            //Bank 5 at 0x4000, bank 2 at 0x8000, bank 0 at 0xc000
+            static const int banks[6] = { 10, 11, 4, 5, 0, 1 };
+            for (int page = 2; page < 8; page++)
+                PageReadPointer[page] = PageWritePointer[page] = RAMpage[banks[page - 2]];
+
+            ULAUpdateStart();
+        }
+
+        //The renderer reads the screen vector, which in this model isn't backed by bank 5.
+        //Copying it once per frame is enough for timing purposes.
+        void SyncScreen() {
+            memcpy(screen.data(), RAMpage[10], screen.size());
+        }
+
+        static bool ReadFile(std::string const& filename, std::vector<byte>& data) {
+            FILE* f = fopen(filename.c_str(), "rb");
+            if (!f)
+                return false;
+
+            byte chunk[16384];
+            size_t n;
+            data.clear();
+
+            while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+                data.insert(data.end(), chunk, chunk + n);
+
+            fclose(f);
+            return true;
+        }
+
+    private:
+        //tstate -> display address (>1), border (1) or nothing (0), one ULA byte per 4 tstates
+        void BuildDisplayTable() {
+            int lines = BorderTopHeight + ScreenHeight + BorderBottomHeight;
+            int bytesPerLine = ScanLineWidth / 8;
+
+            tstateToDisp.assign(TABLE_LENGTH, 0);
+
+            for (int t = ActualULAStart; t < FrameLength; t++) {
+                int line = (t - ActualULAStart) / TstatesPerScanline;
+                int column = ((t - ActualULAStart) % TstatesPerScanline) / 4;
+
+                if (line >= lines || column >= bytesPerLine)
+                    continue;
+
+                int y = line - BorderTopHeight;
+                int x = column - BorderLeftWidth / 8;
+
+                if (y < 0 || y >= ScreenHeight || x < 0 || x >= ScreenWidth / 8)
+                    tstateToDisp[t] = 1;
+                else
+                    tstateToDisp[t] = (short)(DisplayStart + (((y & 0xc0) << 5) | ((y & 0x07) << 8) | ((y & 0x38) << 2) | x));
+            }
+        }
+    };
+
+    struct Workload {
+        char const* name;
+        ushort origin;
+        std::vector<byte> code;
+    };
+
+    std::vector<Workload> const& Workloads() {
+        static std::vector<Workload> const workloads = {
+            { "alu", 0x8000, {
+                0xf3,                   //     DI
+                0xaf,                   //l:   XOR A
+                0x3c,                   //     INC A
+                0x87,                   //     ADD A,A
+                0xce, 0x05,             //     ADC A,5
+                0xd6, 0x03,             //     SUB 3
+                0xe6, 0x7f,             //     AND 0x7f
+                0xb0,                   //     OR B
+                0xa9,                   //     XOR C
+                0x05,                   //     DEC B
+                0xc3, 0x01, 0x80,       //     JP l
+            } },
+            { "ldir", 0x8000, {
+                0xf3,                   //     DI
+                0x21, 0x00, 0x90,       //l:   LD HL,0x9000
+                0x11, 0x00, 0xa0,       //     LD DE,0xa000
+                0x01, 0x00, 0x10,       //     LD BC,0x1000
+                0xed, 0xb0,             //     LDIR
+                0x18, 0xf3,             //     JR l
+            } },
+            { "border", 0x8000, {
+                0xf3,                   //     DI
+                0xaf,                   //     XOR A
+                0xd3, 0xfe,             //l:   OUT (0xfe),A
+                0x3c,                   //     INC A
+                0xe6, 0x07,             //     AND 7
+                0x06, 0x03,             //     LD B,3
+                0x10, 0xfe,             //w:   DJNZ w
+                0x18, 0xf5,             //     JR l
+            } },
+            { "contention", 0x6000, {
+                0xf3,                   //     DI
+                0x21, 0x00, 0x40,       //l:   LD HL,0x4000
+                0x7e,                   //m:   LD A,(HL)
+                0x2f,                   //     CPL
+                0x77,                   //     LD (HL),A
+                0x23,                   //     INC HL
+                0x7c,                   //     LD A,H
+                0xfe, 0x5b,             //     CP 0x5b
+                0x20, 0xf7,             //     JR NZ,m
+                0x18, 0xf2,             //     JR l
+            } },
+        };
+
+        return workloads;
+    }
+
+    void LoadWorkload(Bench48k& machine, Workload const& workload) {
+        machine.Reset(true);
+
+        for (size_t f = 0; f < workload.code.size(); f++) {
+            ushort addr = (ushort)(workload.origin + f);
+            machine.PageWritePointer[addr >> 13][addr & 0x1fff] = workload.code[f];
+        }
+
+        machine.cpu.regs.PC = workload.origin;
+        machine.cpu.regs.SP = 0xfff0;
+    }
+
+    bool LoadSnapshot(Bench48k& machine, std::string const& filename) {
+        std::vector<byte> buffer;
+        if (!Bench48k::ReadFile(filename, buffer))
+            return false;
+
+        std::string ext = filename.size() > 4 ? filename.substr(filename.size() - 4) : "";
+        for (auto& c : ext)
+            c = (char)tolower(c);
+
+        machine.Reset(true);
+
+        if (ext == ".sna") {
+            std::unique_ptr<SNA_SNAPSHOT> sna(new SNA_SNAPSHOT());
+            if (!SNAFile::LoadSNA(buffer, sna.get()) || sna->TYPE != 0)
+                return false;
+
+            machine.UseSNA(sna.get());
+
+            static const int banks[6] = { 10, 11, 4, 5, 0, 1 };
+            for (int f = 0; f < 6; f++)
+                memcpy(machine.RAMpage[banks[f]], sna->RAM + f * 8192, 8192);
+
+            //48K snapshots keep PC on the stack
+            machine.cpu.regs.PC = machine.PeekWordNoContend(machine.cpu.regs.SP);
+            machine.cpu.regs.SP += 2;
+            return true;
+        }
+
+        if (ext == ".z80") {
+            std::unique_ptr<Z80_SNAPSHOT> z80(new Z80_SNAPSHOT());
+            if (!Z80File::LoadZ80(buffer, z80.get()) || z80->TYPE != 0)
+                return false;
+
+            memcpy(machine.RAMpage, z80->RAM_BANK, sizeof(z80->RAM_BANK));
+            machine.UseZ80(*z80);
+            return true;
+        }
+
+        return false;
+    }
+
+    //Runs a workload in deterministic mode on a new machine and returns its StateHash().
+    //A dirty machine has its memory filled with junk first, which the hard reset has to clear.
+    uint64_t DeterministicHash(Workload const& workload, bool dirty) {
+        std::unique_ptr<Bench48k> machine(new Bench48k());
+        machine->SetDeterministic(true);
+
+        if (dirty) {
+            memset(machine->RAMpage, 0xa5, sizeof(machine->RAMpage));
+            memset(machine->JunkMemory, 0x5a, sizeof(machine->JunkMemory));
+        }
+
+        LoadWorkload(*machine, workload);
+
+        for (int f = 0; f < 10; f++) {
+            machine->SyncScreen();
+            machine->Run();
+        }
+
+        return machine->StateHash();
+    }
+
+    //Two machines in one process, one of them reused, have to agree on every workload
+    bool DeterminismSelfTest() {
+        for (auto const& w : Workloads()) {
+            if (DeterministicHash(w, false) != DeterministicHash(w, true))
+                return false;
+        }
+
+        return true;
+    }
+
+#if RM_SUBSYSTEM_TIMERS
+    double Ms(int64_t ns) { return ns / 1e6; }
+#endif
+
+    void RunWorkload(Bench48k& machine, char const* name, int frames, bool profile) {
+        machine.subsystemTimes.Clear();
+
+        if (profile)
+            machine.StartProfiler();
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int f = 0; f < frames; f++) {
+            machine.SyncScreen();
+            machine.needsPaint = false;
+            machine.Run();
+        }
+
+        int64_t totalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        double seconds = totalNs / 1e9;
+        double tstates = (double)frames * machine.FrameLength;
+
+#if RM_SUBSYSTEM_TIMERS
+        SubsystemTimes const& times = machine.subsystemTimes;
+        int64_t cpuNs = totalNs - times.renderNs - times.audioNs - times.tapeNs;
+
+        printf("%-12s %8d %10.1f %8.2f %8.3f %10.1f %10.1f %10.1f %10.1f\n",
+            name, frames,
+            seconds > 0 ? frames / seconds : 0.0,
+            seconds > 0 ? times.instructions / seconds / 1e6 : 0.0,
+            totalNs / tstates,
+            Ms(cpuNs), Ms(times.renderNs), Ms(times.audioNs), Ms(times.tapeNs));
+#else
+        //The instruction count and the subsystem split are only kept with the timers compiled in
+        printf("%-12s %8d %10.1f %8s %8.3f %10s %10s %10s %10s\n",
+            name, frames,
+            seconds > 0 ? frames / seconds : 0.0,
+            "n/a",
+            totalNs / tstates,
+            "n/a", "n/a", "n/a", "n/a");
+#endif
+
+        if (profile) {
+            machine.StopProfiler();
+            printf("\n%s\n%s\n", machine.ProfilerFlatReport(10).c_str(), machine.ProfilerCallGraphReport(10).c_str());
+        }
+    }
+
+    void Usage() {
+        fprintf(stderr, "usage: zx-bench [--frames N] [--workload NAME|all] [--rom FILE] [--snapshot FILE] [--batch] [--fast] [--profile]\n");
+        fprintf(stderr, "       zx-bench --selftest\n");
+        fprintf(stderr, "workloads:");
+        for (auto const& w : Workloads())
+            fprintf(stderr, " %s", w.name);
+        fprintf(stderr, "\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    int frames = 500;
+    std::string workload = "all";
+    std::string rom;
+    std::string snapshot;
+    bool batch = false;
+    bool fast = false;
+    bool profile = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--frames" && hasValue)
+            frames = atoi(argv[++i]);
+        else if (arg == "--workload" && hasValue)
+            workload = argv[++i];
+        else if (arg == "--rom" && hasValue)
+            rom = argv[++i];
+        else if (arg == "--snapshot" && hasValue)
+            snapshot = argv[++i];
+        else if (arg == "--batch")
+            batch = true;
+        else if (arg == "--fast")
+            fast = true;
+        else if (arg == "--profile")
+            profile = true;
+        else if (arg == "--selftest") {
+            bool kernels = PixelKernel::SelfTest();
+            printf("pixel kernel self test: %s\n", kernels ? "passed" : "FAILED");
+
+            bool determinism = DeterminismSelfTest();
+            printf("determinism self test: %s\n", determinism ? "passed" : "FAILED");
+            return kernels && determinism ? 0 : 1;
+        }
+        else {
+            Usage();
+            return 1;
+        }
+    }
+
+    if (frames <= 0) {
+        Usage();
+        return 1;
+    }
+
+    std::unique_ptr<Bench48k> machine(new Bench48k());
+    machine->batchExecution = batch;
+    machine->SetFastTiming(fast);
+
+    if (!rom.empty() && !machine->LoadROM(rom, "")) {
+        fprintf(stderr, "zx-bench: can't load ROM %s\n", rom.c_str());
+        return 1;
+    }
+
+    printf("pixel kernels: %s, execution: %s\n", PixelKernel::Name(), fast ? "fast timing" : (batch ? "batched" : "per instruction"));
+    printf("%-12s %8s %10s %8s %8s %10s %10s %10s %10s\n",
+        "workload", "frames", "fps", "MIPS", "ns/T", "cpu ms", "render ms", "audio ms", "tape ms");
+
+    if (!snapshot.empty()) {
+        if (rom.empty() || !LoadSnapshot(*machine, snapshot)) {
+            fprintf(stderr, "zx-bench: can't load 48K snapshot %s (a ROM is required)\n", snapshot.c_str());
+            return 1;
+        }
+
+        RunWorkload(*machine, "snapshot", frames, profile);
+        return 0;
+    }
+
+    bool found = false;
+
+    for (auto const& w : Workloads()) {
+        if (workload != "all" && workload != w.name)
+            continue;
+
+        found = true;
+        LoadWorkload(*machine, w);
+        RunWorkload(*machine, w.name, frames, profile);
+    }
+
+    if (!found) {
+        Usage();
+        return 1;
+    }
+
+    return 0;
+}
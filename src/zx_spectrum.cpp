@@ -1,7 +1,20 @@
 #include "zx_spectrum.h"
 
-string rm::zx_spectrum::ROM_128_BAS = "128K BAS";
-string rm::zx_spectrum::ROM_48_BAS = "48K BAS";
-string rm::zx_spectrum::ROM_128_SYN = "128K Syn";
-string rm::zx_spectrum::ROM_PLUS3_DOS = "+3 DOS";
-string rm::zx_spectrum::ROM_TR_DOS = "TR DOS";
+char const* rm::zx_spectrum::BankName(BankID id) {
+    switch (id) {
+        case BankID::ROM_128_BAS: return "128K BAS";
+        case BankID::ROM_48_BAS: return "48K BAS";
+        case BankID::ROM_128_SYN: return "128K Syn";
+        case BankID::ROM_PLUS3_DOS: return "+3 DOS";
+        case BankID::ROM_TR_DOS: return "TR DOS";
+        case BankID::RAM_0: return "RAM 0";
+        case BankID::RAM_1: return "RAM 1";
+        case BankID::RAM_2: return "RAM 2";
+        case BankID::RAM_3: return "RAM 3";
+        case BankID::RAM_4: return "RAM 4";
+        case BankID::RAM_5: return "RAM 5";
+        case BankID::RAM_6: return "RAM 6";
+        case BankID::RAM_7: return "RAM 7";
+        default: return "-----";
+    }
+}
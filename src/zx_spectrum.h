@@ -1,14 +1,27 @@
 #pragma once
 
 #include "AudioDevice.h"
+#include "GuestProfiler.h"
+#include "Hash.h"
 #include "SNAFile.h"
+#include "PixelKernel.h"
+#include "Random.h"
+#include "RewindBuffer.h"
+#include "Scheduler.h"
 #include "SoundManager.h"
+#include "StateStream.h"
+#include "SubsystemTimer.h"
 #include "Types.h"
 #include "ULA_Plus.h"
+#include "Watchpoints.h"
 #include "Z80.h"
+#include "Z80File.h"
 
+#include <assert.h>
 #include <limits.h>
 #include <stddef.h>
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <string>
 #include <vector>
@@ -27,10 +40,82 @@ namespace rm {
         NEXT_BLOCK
     };
 
+    //What the frontend wants from zx_spectrum::RenderFrame() in deferred render mode
+    enum class FrameRequest {
+        SKIP,       //don't raster this frame, keep the changes for a later request
+        FULL,       //raster the whole frame
+        DIRTY       //raster only the character cells (or border) that changed
+    };
+
+    //A rectangle of ScreenBuffer pixels
+    struct ScreenRect {
+        int x, y, width, height;
+    };
+
+    //Result of zx_spectrum::RunFrames
+    struct TurboReport {
+        int frames;                 //frames emulated
+        int renderedFrames;         //frames rastered to ScreenBuffer
+        double seconds;             //host time taken
+        double framesPerSecond;     //frames / seconds
+    };
+
+    class zx_spectrum;
+
+    //Z80 bus policy that talks to a zx_spectrum directly. The members are defined
+    //at the end of this file, once zx_spectrum is complete, so that the compiler
+    //can inline them into Z80Core::Execute() instead of going through std::function.
+    //None of the zx_spectrum members it calls are virtual: a model's memory map lives in the
+    //page tables and its extra ports in modelPorts, so the whole bus inlines into the core.
+    class SpectrumBus
+    {
+    public:
+        zx_spectrum* machine = nullptr;
+
+        byte PeekByte(ushort addr);
+        ushort PeekWord(ushort addr);
+        void PokeByte(ushort addr, byte val);
+        void PokeWord(ushort addr, ushort val);
+        void Contend(int reg, int times, int count);
+        byte In(ushort port);
+        void Out(ushort port, byte val);
+        void InstructionFetchSignal();
+        void TapeEdgeDetection();
+        void TapeEdgeDecA();
+        void TapeEdgeCpA();
+    };
+
+    //Bus policy for the fast timing mode (see zx_spectrum::SetFastTiming). Memory accesses
+    //cost a fixed 3 tstates and never contend or catch up the raster, so none of that work
+    //is compiled into the Z80Core<SpectrumFastBus> instantiation.
+    class SpectrumFastBus
+    {
+    public:
+        zx_spectrum* machine = nullptr;
+
+        byte PeekByte(ushort addr);
+        ushort PeekWord(ushort addr);
+        void PokeByte(ushort addr, byte val);
+        void PokeWord(ushort addr, ushort val);
+        void Contend(int reg, int times, int count);
+        byte In(ushort port);
+        void Out(ushort port, byte val);
+        void InstructionFetchSignal();
+        void TapeEdgeDetection();
+        void TapeEdgeDecA();
+        void TapeEdgeCpA();
+    };
+
     /// <summary>
     /// zx_spectrum is the heart of speccy emulation.
     /// It includes core execution, ula, sound, input and interrupt handling
     /// </summary>
+    //
+    //Thread safety: all machine state, including the random numbers used at reset and for
+    //input polling, is owned by the instance, so separate instances can run on separate
+    //threads with no locking. A single instance is not thread safe and must only be used
+    //from one thread at a time. The only process wide state is the read-only Z80 flag tables
+    //and the PixelKernel selection, which is made once however many threads construct machines.
     class zx_spectrum
     {
     public:
@@ -50,57 +135,210 @@ namespace rm {
         std::function<void()> FrameStartEvent;
         std::function<void()> RZXPlaybackStartEvent;
         std::function<void()> RZXFrameEndEvent;
+        std::function<void(int addr, int kind, int val)> WatchpointEvent;
 
         void OnFrameEndEvent()
         {
-               FrameEndEvent();
+            if (FrameEndEvent)
+                FrameEndEvent();
         }
 
         void OnFrameStartEvent()
         {
-            FrameStartEvent();
+            if (FrameStartEvent)
+                FrameStartEvent();
         }
 
         void OnRZXPlaybackStartEvent() {
-            RZXPlaybackStartEvent();
+            if (RZXPlaybackStartEvent)
+                RZXPlaybackStartEvent();
+        }
+
+        //The memory and port events below are raised on every access. They compile to nothing
+        //when RM_DEBUG_HOOKS is 0, and otherwise only fire once SetDebugWatchers(true) is called.
+        bool hasDebugWatchers = false;
+
+        void SetDebugWatchers(bool attached) {
+            hasDebugWatchers = attached;
         }
 
         void OnMemoryWriteEvent(int addr, int val) {
-            MemoryWriteEvent(addr, val);
+#if RM_DEBUG_HOOKS
+            if (watchedPage[addr >> 13] & Watchpoints::WATCH_WRITE)
+                CheckWatchpoint(addr, Watchpoints::WATCH_WRITE, val);
+
+            if (hasDebugWatchers)
+                MemoryWriteEvent(addr, val);
+#endif
         }
 
         void OnMemoryReadEvent(int addr, int val) {
-            MemoryReadEvent(addr, val);
+#if RM_DEBUG_HOOKS
+            if (watchedPage[addr >> 13] & Watchpoints::WATCH_READ)
+                CheckWatchpoint(addr, Watchpoints::WATCH_READ, val);
+
+            if (hasDebugWatchers)
+                MemoryReadEvent(addr, val);
+#endif
+        }
+
+        //Called by the bus before every opcode fetch, with the fetching cpu's SP and clock
+        void OnInstructionFetch(ushort pc, ushort sp, int tstate) {
+#if RM_DEBUG_HOOKS
+            if (watchedPage[pc >> 13] & Watchpoints::WATCH_EXECUTE)
+                CheckWatchpoint(pc, Watchpoints::WATCH_EXECUTE, PageReadPointer[pc >> 13][pc & 0x1FFF]);
+#endif
+#if RM_GUEST_PROFILER
+            if (profiling)
+                profiler.OnFetch(pc, sp, tstate, PageReadPointer, (int)SlotBank(pc >> 14));
+#endif
+        }
+
+        //Charges a contention delay to the guest profiler
+        void NoteStall(int addr, int stall) {
+#if RM_GUEST_PROFILER
+            if (profiling)
+                profiler.AddStall(addr, stall);
+#endif
+        }
+
+        //Profiler for the emulated program (see GuestProfiler). Costs nothing until started.
+        GuestProfiler profiler;
+        bool profiling = false;
+
+        void StartProfiler(GuestProfiler::Mode mode = GuestProfiler::Mode::COUNT, int sampleInterval = 1000) {
+            profiler.Start(mode, sampleInterval);
+            profiling = true;
+        }
+
+        void StopProfiler() {
+            profiler.Stop();
+            profiling = false;
+        }
+
+        std::string ProfilerFlatReport(int top = 20) {
+            return profiler.FlatReport(top, [](int bank) { return BankName((BankID)bank); });
+        }
+
+        std::string ProfilerCallGraphReport(int top = 20) {
+            return profiler.CallGraphReport(top);
+        }
+
+        //Memory watchpoints. Only pages flagged in watchedPage take the slow path through here.
+        Watchpoints watchpoints;
+        bool watchpointHit = false;             //raised on a hit, cleared by the debugger
+
+        void AddWatchpoint(ushort addr, byte kinds) {
+            watchpoints.Add(addr, kinds);
+            SyncWatchedPages();
+        }
+
+        void RemoveWatchpoint(ushort addr, byte kinds) {
+            watchpoints.Remove(addr, kinds);
+            SyncWatchedPages();
+        }
+
+        void ClearWatchpoints() {
+            watchpoints.Clear();
+            SyncWatchedPages();
+        }
+
+        void SyncWatchedPages() {
+            for (int page = 0; page < 8; page++)
+                watchedPage[page] = watchpoints.PageKinds(page);
+        }
+
+        //Raises WatchpointEvent and ends the running batch so the debugger gets control
+        //after the current instruction.
+        void CheckWatchpoint(int addr, byte kind, int val) {
+            if (!watchpoints.IsWatched((ushort)addr, kind))
+                return;
+
+            watchpointHit = true;
+            cpu.yieldRequested = true;
+            fastCpu.yieldRequested = true;
+
+            if (WatchpointEvent)
+                WatchpointEvent(addr, kind, val);
         }
 
         void OnMemoryExecuteEvent(int addr, int val) {
-            MemoryExecuteEvent(addr, val);
+#if RM_DEBUG_HOOKS
+            if (hasDebugWatchers)
+                MemoryExecuteEvent(addr, val);
+#endif
         }
 
         void OnTapeEvent(TapeEventType type) {
-            TapeEvent(type);
+            if (TapeEvent)
+                TapeEvent(type);
         }
 
         void OnDiskEvent(int type) {
-            DiskEvent(type);
+            if (DiskEvent)
+                DiskEvent(type);
         }
 
         void OnPortEvent(int port, int val, bool write) {
-            PortEvent(port, val, write);
+#if RM_DEBUG_HOOKS
+            if (hasDebugWatchers)
+                PortEvent(port, val, write);
+#endif
         }
 
         byte OnPortReadEvent(ushort port) {
-            return PortReadEvent(port);
+            return PortReadEvent ? PortReadEvent(port) : 0xff;
         }
 
         void OnPortWriteEvent(ushort port, byte val) {
-            PortWriteEvent(port, val);
+            if (PortWriteEvent)
+                PortWriteEvent(port, val);
         }
 
         IntPtr mainHandle;
 
+        //Hot state. Everything Process() and the memory accessors touch on every instruction
+        //lives here, contiguous and starting on a cache line, away from the cold state below.
+        alignas(64) Z80Core<SpectrumBus> cpu;
 
-        Z80 cpu;
+        //8 "pointers" to the pages
+        //NOTE: In the case of +3, Pages 0 and 1 *can* point to a RAMpage. In other cases they point to a
+        //ROMpage. To differentiate which is being pointed to, the +3 machine employs the specialMode boolean.
+        byte* PageReadPointer[8];
+        byte* PageWritePointer[8];
+        byte watchedPage[8] = { 0 };                        //Watchpoints::WATCH_* kinds set in each 8k cpu page
+        uint16_t dirtyRAMPages = 0xffff;                    //a bit per RAMpage written since the last rewind snapshot
+
+        byte contendedPage[8] = { 0 };                      //0xff for each 8k cpu page that is contended, 0 otherwise
+        byte contendedCyclePage[8] = { 0 };                 //same for Contend() cycles, always 0 on the +3
+        byte contendedPort = 0xff;                          //0xff if IO cycles contend, 0 on the +3
+        std::vector<byte> contentionTable;                  //tstate-memory contention delay mapping
+
+        int prevT;                              //previous cpu t-states
+        int deltaTStates;
+        int timeToOutSound = 0;
+        int soundTStatesToSample = 79;
+        int averagedSound = 0;
+        short soundCounter = 0;
+        short soundOut = 0;
+
+        //Timed work (audio samples, input polls, end of frame) dispatched from Process()
+        Scheduler scheduler;
+
+        //Renderer state used by the catch-ups in PokeByte/Out
+        std::vector<short> tstateToDisp;                    //tstate-display mapping
+        std::vector<int> ScreenBuffer;                      //buffer for the windows side rasterizer
+        std::vector<byte> screen;                           //display memory (16384 for 48k)
+        std::vector<short> attr;                            //attribute memory lookup (mapped 1:1 to screen for convenience)
+        int lastTState;                         //tstate at which last render update took place
+        int screenByteCtr;                      //offset into display memory based on current tstate
+        int ULAByteCtr;                         //offset into current pixel of rasterizer
+        int attrInk[256];                       //final ink colour for each attribute value, see RefreshColourTables()
+        int attrPaper[256];                     //final paper colour for each attribute value
+        //End of hot state
+
+        SubsystemTimes subsystemTimes;       //only filled in with RM_SUBSYSTEM_TIMERS
+        Z80Core<SpectrumFastBus> fastCpu;    //runs batches in fast timing mode, state is copied to and from cpu
         ULA_Plus ula_plus;
         //public Z80_Registers regs;
         SoundManager beeper;
@@ -139,27 +377,40 @@ namespace rm {
         bool isROMprotected = true;  //not really used ATM
         bool needsPaint = false;     //Raised when the ULA has finished painting the entire screen
         bool CapsLockOn = false;
-        int prevT;        //previous cpu t-states
         int inputFrameTime = 0;
 
+        int audioSampleEvent = -1;
+        int inputPollEvent = -1;
+        int frameEndEvent = -1;
+
         //Sound
         static const short MIN_SOUND_VOL = 0;
         static const short MAX_SOUND_VOL = SHRT_MAX / 2;
         short soundSamples[882 * 2]; //882 samples, 2 channels, 2 bytes per channel (short)
         
         static const bool ENABLE_SOUND = false;
-        int averagedSound = 0;
-        short soundCounter = 0;
         int lastSoundOut = 0;
-        short soundOut = 0;
-        int soundTStatesToSample = 79;
         float soundVolume = 0.0f;        //cached reference used when beeper instance is recreated.
         short soundSampleCounter = 0;
-        int timeToOutSound = 0;
 
         //Threading stuff (not used)
         bool doRun = true;           //z80 executes only when true. Mainly for debugging purpose.
 
+        //RZX playback and recording aren't ported yet (see ProcessRZX), so these stay false
+        bool isPlayingRZX = false;
+        bool isRecordingRZX = false;
+
+        //When true, Run() uses ProcessBatch() to execute runs of instructions between events
+        bool batchExecution = false;
+
+        //When true, contention is off and the screen is rastered once per frame (see SetFastTiming)
+        bool fastTiming = false;
+
+        //When true, frames run back to back without waiting on the sound card and audio is
+        //thrown away (see SetTurbo and RunFrames)
+        bool turbo = false;
+        static const int TURBO_AUDIO_PERIOD = 2048;    //tstates between audio drops in turbo mode
+
         //Important ports
         int lastFEOut = 0;        //The ULA Port
         int last7ffdOut = 0;      //Paging port on 128k/+2/+3/Pentagon
@@ -191,18 +442,34 @@ namespace rm {
         bool Issue2Keyboard = false; //Only of use for 48k & 16k machines.
         int LateTiming = 0;       //Some machines have late timings. This affects contention and has to be factored in.
 
-        //Utility strings
-        static const string ROM_128_BAS;
-        static const string ROM_48_BAS;
-        static const string ROM_128_SYN;
-        static const string ROM_PLUS3_DOS;
-        static const string ROM_TR_DOS;
+        //What is paged into each 16k slot. Only the monitor shows these, via BankName().
+        enum class BankID : byte {
+            NONE,
+            ROM_128_BAS,
+            ROM_48_BAS,
+            ROM_128_SYN,
+            ROM_PLUS3_DOS,
+            ROM_TR_DOS,
+            RAM_0, RAM_1, RAM_2, RAM_3, RAM_4, RAM_5, RAM_6, RAM_7
+        };
+
+        static char const* BankName(BankID id);
+
+        //What is paged into a 16k slot (0-3)
+        BankID SlotBank(int slot) const {
+            switch (slot) {
+                case 0: return BankInPage0;
+                case 1: return BankInPage1;
+                case 2: return BankInPage2;
+                default: return BankInPage3;
+            }
+        }
 
         //The monitor needs to know these states so are public
-        string BankInPage3 = "-----";
-        string BankInPage2 = "-----";
-        string BankInPage1 = "-----";
-        string BankInPage0 = ROM_48_BAS;
+        BankID BankInPage3 = BankID::NONE;
+        BankID BankInPage2 = BankID::NONE;
+        BankID BankInPage1 = BankID::NONE;
+        BankID BankInPage0 = BankID::ROM_48_BAS;
         bool monitorIsRunning = false;
         
         //Paging
@@ -222,25 +489,71 @@ namespace rm {
         //Contention related stuff
         int contentionStartPeriod;              //t-state at which to start applying contention
         int contentionEndPeriod;                //t-state at which to end applying contention
-        std::vector<byte> contentionTable;                  //tstate-memory contention delay mapping
 
         //Render related stuff
-        std::vector<int> ScreenBuffer;                        //buffer for the windows side rasterizer
         std::vector<int> LastScanlineColor;
         short lastScanlineColorCounter;
-        std::vector<byte> screen;                           //display memory (16384 for 48k)
-        std::vector<short> attr;                           //attribute memory lookup (mapped 1:1 to screen for convenience)
-        std::vector<short> tstateToDisp;                   //tstate-display mapping
         std::vector<short> floatingBusTable;               //table that stores tstate to screen/attr addresses values
-        int deltaTStates;
-        int lastTState;                         //tstate at which last render update took place
         int elapsedTStates;                     //tstates elapsed since last render update
         int ActualULAStart;                     //tstate of top left raster pixel
-        int screenByteCtr;                      //offset into display memory based on current tstate
-        int ULAByteCtr;                         //offset into current pixel of rasterizer
         int borderColour;                       //Used by the screen update routine to output border colour
         bool flashOn = false;
 
+        //Colour lookup tables used by UpdateScreenBuffer, see RefreshColourTables()
+        int borderColours[8];
+        int paletteVersion = 0;                 //bumped whenever AttrColors changes
+        int cachedPaletteVersion = 0;
+        int cachedULAPlusVersion = 0;
+        bool cachedFlashOn = false;
+        bool cachedULAPlusActive = false;
+        bool colourTablesValid = false;
+
+        //Deferred rendering (see RenderFrame)
+        struct BorderChange {
+            int tstate;
+            int colour;
+        };
+
+        //A run of border bytes in the raster, see BuildDisplayMap
+        struct BorderRun {
+            int tstate;                         //tstate of the first byte
+            int bytes;
+            int index;                          //ScreenBuffer index of the first pixel
+        };
+
+        //A stretch of border pixels of one colour, see FrameBorderSpans
+        struct BorderSpan {
+            int index;                          //ScreenBuffer index of the first pixel
+            int pixels;
+            int colour;                         //0-7
+        };
+
+        bool deferredRender = false;            //when true the ULA doesn't raster as the frame runs
+        bool renderingFrame = false;            //raised while a whole fast timing frame is rastered at its end
+        bool dirtyCells[32 * 24] = { false };               //character cells written since the last render
+        bool anyCellDirty = true;
+        bool allCellsDirty = true;
+        std::vector<int> displayToBuffer;       //display byte offset -> ScreenBuffer index of its 8 pixels
+        std::vector<BorderRun> borderRuns;      //the border bytes of a frame, in raster order
+        std::vector<BorderChange> borderChanges;        //border writes in the running frame
+        std::vector<BorderChange> frameBorderChanges;   //border writes in the last completed frame
+        size_t rasterBorderIndex = 0;           //first borderChanges entry the raster hasn't reached
+        int rasterBorderColour = 0;             //border colour at the raster position
+        int borderAtFrameStart = 0;             //border colour when the running frame started
+        int frameBorderStart = 0;               //border colour when the last completed frame started
+        int renderedBorder = -1;                //border colour of the last RenderFrame, -1 if none
+
+        //Duplicate frame detection (see SetFrameDedup)
+        bool frameDedup = false;
+        bool duplicateFrame = false;            //the last completed frame looks the same as the one before it
+        bool frameHashValid = false;
+        uint64_t frameHash = 0;                 //PictureHash() of the last completed frame
+        uint64_t displayHash = 0;               //hash of the display memory, only redone after writes to it
+        bool displayHasFlash = false;           //any attribute in the display memory has the flash bit
+        bool displayChangedSinceHash = true;
+        bool renderedFrameValid = false;        //ScreenBuffer holds the picture with renderedFrameHash
+        uint64_t renderedFrameHash = 0;
+
         //For floating bus implementation
         int lastPixelValue;                     //last 8-bit bitmap read from display memory
         int lastAttrValue;                      //last 8-bit attr val read from attribute memory
@@ -263,11 +576,6 @@ namespace rm {
         //For writing to ROM space
         byte JunkMemory[2][8192]; 
 
-        //8 "pointers" to the pages
-        //NOTE: In the case of +3, Pages 0 and 1 *can* point to a RAMpage. In other cases they point to a
-        //ROMpage. To differentiate which is being pointed to, the +3 machine employs the specialMode boolean.
-        byte* PageReadPointer[8];
-        byte* PageWritePointer[8];
 
         //Tape edge detection variables
         string tapeFilename = "";
@@ -348,7 +656,7 @@ namespace rm {
         int joystickState[(size_t)JoysticksEmulated::LAST];
 
         //This holds the key lines used by the speccy for input
-        std::vector<bool> keyBuffer;
+        bool keyBuffer[(size_t)keyCode::LAST] = { false };
 
         //SpecEmu interfacing
         bool externalSingleStep = false;
@@ -373,7 +681,7 @@ namespace rm {
         //Returns the memory data at a page
         byte* GetPageData(int page) { return RAMpage[page * 2]; }
         //Changes the spectrum palette to the one provided
-        void SetPalette(std::vector<int> const& newPalette) { AttrColors = newPalette; }
+        void SetPalette(std::vector<int> const& newPalette) { AttrColors = newPalette; InvalidatePalette(); }
         // Returns the byte at a given 16 bit address with no contention
         byte PeekByteNoContend(ushort addr) { return PageReadPointer[addr >> 13][addr & 0x1FFF]; }
         // Returns a word at a given 16 bit address with no contention
@@ -443,17 +751,24 @@ namespace rm {
         }
 
         void InitCpu() {
-            cpu.PeekByte = [this](ushort addr) -> byte { PeekByte(addr); };
-            cpu.PokeByte = [this](ushort addr, byte val) -> void { PokeByte(addr, val); };
-            cpu.PeekWord = [this](ushort addr) -> ushort { return PeekWord(addr); };
-            cpu.PokeWord = [this](ushort addr, ushort val) -> void { PokeWord(addr, val); };
-            cpu.In = [this](ushort port) -> byte { return In(port); };
-            cpu.Out = [this](ushort port, byte val) -> void { Out(port, val); };
-            cpu.Contend = [this](int reg, int times, int count) -> void { Contend(reg, times, count); };
-            cpu.InstructionFetchSignal = [this]() -> void {};
-            cpu.TapeEdgeDetection = [this]() -> void { OnTapeEdgeDetection(); };
-            cpu.TapeEdgeDecA = [this]() -> void { OnTapeEdgeDecA(); };
-            cpu.TapeEdgeCpA = [this]() -> void { OnTapeEdgeCpA(); };
+            cpu.machine = this;
+            fastCpu.machine = this;
+        }
+
+        void InitScheduler() {
+            //Registration order is also the firing order of events due at the same tstate
+            audioSampleEvent = scheduler.Register([this](int) { OnAudioSampleDue(); });
+            inputPollEvent = scheduler.Register([this](int) { UpdateInputPoll(); });
+            frameEndEvent = scheduler.Register([this](int) { UpdateFrameEnd(); });
+        }
+
+        //Re-arms every timed event from the current machine state. Needed whenever cpu.t_states,
+        //FrameLength or soundTStatesToSample are changed outside Process().
+        void ResetSchedule() {
+            scheduler.Clear();
+            scheduler.Schedule(audioSampleEvent, cpu.t_states);
+            scheduler.Schedule(inputPollEvent, inputFrameTime);
+            scheduler.Schedule(frameEndEvent, FrameLength);
         }
 
         zx_spectrum(IntPtr handle, bool lateTimingModel) {
@@ -463,7 +778,14 @@ namespace rm {
             LateTiming = (lateTimingModel ? 1 : 0);
             tapeBitWasFlipped = false;
 
+            //Memory starts zeroed so that StateHash() doesn't depend on what the heap held before
+            memset(RAMpage, 0, sizeof(RAMpage));
+            memset(ROMpage, 0, sizeof(ROMpage));
+            memset(JunkMemory, 0, sizeof(JunkMemory));
+
             InitCpu();
+            InitScheduler();
+            PixelKernel::Init();
 
             //THREAD
             //lock (lockThis)
@@ -504,16 +826,391 @@ namespace rm {
             }
         }
 
-        static int RandInt(int min, int max) {
-            int const range = max - min;
-            int const usable_max = RAND_MAX - (RAND_MAX % range);
-            int result;
+        //Per machine random numbers (reset timing, input poll jitter)
+        Random rnd_generator;
+
+        //Reseeds the machine's random numbers. Runs from the same seed and inputs are identical.
+        void SetRandomSeed(uint64_t seed) {
+            rnd_generator.Seed(seed);
+        }
+
+        //Deterministic mode: every Reset() and snapshot load restarts the random numbers from
+        //deterministicSeed, so the same snapshot and inputs always give the same frames.
+        bool deterministic = false;
+        uint64_t deterministicSeed = Random::DEFAULT_SEED;
+
+        //StateHash() at the end of the last frame, kept while deterministic is set
+        uint64_t frameStateHash = 0;
+
+        void SetDeterministic(bool on, uint64_t seed = Random::DEFAULT_SEED) {
+            deterministic = on;
+            deterministicSeed = seed;
+            frameStateHash = 0;
+
+            if (on)
+                RestartRandom();
+        }
+
+        //Reseeds from deterministicSeed and redraws the input poll time, which is the only
+        //random state that outlives a snapshot load
+        void RestartRandom() {
+            rnd_generator.Seed(deterministicSeed);
+            inputFrameTime = rnd_generator.Next(FrameLength);
+
+            if (inputPollEvent >= 0)
+                scheduler.Schedule(inputPollEvent, inputFrameTime);
+        }
+
+        //A hash of the cpu registers, the ports that select paging and the border, and all of
+        //RAM. Two machines with the same hash at a frame end will run identically from there.
+        uint64_t StateHash() {
+            cpu.SyncFlags();
+
+            int state[] = {
+                cpu.regs.AF, cpu.regs.BC, cpu.regs.DE, cpu.regs.HL,
+                cpu.regs.AF_, cpu.regs.BC_, cpu.regs.DE_, cpu.regs.HL_,
+                cpu.regs.IX, cpu.regs.IY, cpu.regs.SP, cpu.regs.PC,
+                cpu.regs.MemPtr, cpu.regs.I, cpu.regs.R, cpu.regs.R_, cpu.regs.Q,
+                cpu.interrupt_mode, cpu.interrupt_count, cpu.iff_1, cpu.iff_2, cpu.is_halted,
+                cpu.t_states, lastFEOut, last7ffdOut, last1ffdOut, borderColour
+            };
+
+            uint64_t hash = Hash::Fnv1a(state, sizeof(state));
+            return Hash::Words(RAMpage, sizeof(RAMpage), hash);
+        }
+
+        //Savestates for libretro (save states, run-ahead, netplay). The layout is fixed and
+        //little endian, described once by SyncState(). Bump STATE_VERSION whenever it changes.
+        static const uint STATE_MAGIC = 0x53534d52;     //"RMSS"
+        static const uint STATE_VERSION = 2;
+
+        //Which RAMpage (0-15), ROMpage (16-23) or JunkMemory page (24-25) a page pointer points at
+        int PageIndex(byte const* p) const {
+            for (int f = 0; f < 16; f++) {
+                if (p == RAMpage[f])
+                    return f;
+            }
+
+            for (int f = 0; f < 8; f++) {
+                if (p == ROMpage[f])
+                    return 16 + f;
+            }
+
+            return (p == JunkMemory[1]) ? 25 : 24;
+        }
+
+        byte* PageFromIndex(int index) {
+            if (index >= 0 && index < 16)
+                return RAMpage[index];
+
+            if (index >= 16 && index < 24)
+                return ROMpage[index - 16];
+
+            return JunkMemory[index == 25 ? 1 : 0];
+        }
+
+        //Bytes Serialize() needs. The layout has no variable length parts, so it's counted once.
+        size_t SerializeSize() {
+            if (serializeSize == 0) {
+                StateWriter counter(nullptr, 0);
+                SyncState(counter);
+                serializeSize = counter.Used();
+            }
+
+            return serializeSize;
+        }
+
+        size_t serializeSize = 0;
+
+        //Saves the machine state into data without allocating. Call between instructions.
+        bool Serialize(void* data, size_t size) {
+            StateWriter writer(data, size);
+            SyncState(writer);
+            return writer.Ok();
+        }
+
+        //Loads a state saved by Serialize() on the same model. Leaves the machine alone and
+        //returns false if the state is from another version or model, or is cut short. The
+        //tape image itself isn't part of the state, only the position in it.
+        bool Unserialize(void const* data, size_t size) {
+            StateReader check(data, size);
+            uint magic = 0, version = 0, frameLength = 0;
+            byte stateModel = 0;
+            check.Sync(magic);
+            check.Sync(version);
+            check.Sync(frameLength);
+            check.Sync(stateModel);
+
+            if (!check.Ok() || magic != STATE_MAGIC || version != STATE_VERSION
+                || (int)frameLength != FrameLength || stateModel != (byte)model || size < SerializeSize())
+                return false;
+
+            StateReader reader(data, size);
+            SyncState(reader);
+            StateLoaded();
+            MarkAllDirty();
+            dirtyRAMPages = 0xffff;
+            DropFork();
+            return true;
+        }
+
+        //Rebuilds what is derived from the loaded state
+        void StateLoaded() {
+            RefreshContendedPages();
+            ResetBorderLog();
+            ResetSchedule();
+        }
+
+        template<class Stream>
+        void SyncState(Stream& s) {
+            uint magic = STATE_MAGIC, version = STATE_VERSION, frameLength = (uint)FrameLength;
+            byte stateModel = (byte)model;
+            s.Sync(magic);
+            s.Sync(version);
+            s.Sync(frameLength);
+            s.Sync(stateModel);
+
+            SyncCoreState(s);
+            s.SyncBytes(RAMpage, sizeof(RAMpage));
+        }
+
+        //Everything but RAM
+        template<class Stream>
+        void SyncCoreState(Stream& s) {
+            //Z80
+            cpu.SyncFlags();
+            s.Sync(cpu.regs.AF); s.Sync(cpu.regs.BC); s.Sync(cpu.regs.DE); s.Sync(cpu.regs.HL);
+            s.Sync(cpu.regs.AF_); s.Sync(cpu.regs.BC_); s.Sync(cpu.regs.DE_); s.Sync(cpu.regs.HL_);
+            s.Sync(cpu.regs.IX); s.Sync(cpu.regs.IY); s.Sync(cpu.regs.SP); s.Sync(cpu.regs.PC);
+            s.Sync(cpu.regs.MemPtr);
+            s.Sync(cpu.regs.I); s.Sync(cpu.regs.R); s.Sync(cpu.regs.R_); s.Sync(cpu.regs.Q);
+            s.Sync(cpu.t_states);
+            s.Sync(cpu.interrupt_mode);
+            s.Sync(cpu.interrupt_count);
+            s.Sync(cpu.iff_1);
+            s.Sync(cpu.iff_2);
+            s.Sync(cpu.is_halted);
+            s.Sync(cpu.parityBitNeedsReset);
+            s.Sync(cpu.and_32_Or_64);
+
+            //Paging
+            s.Sync(last7ffdOut);
+            s.Sync(last1ffdOut);
+            s.Sync(lowROMis48K);
+            s.Sync(trDosPagedIn);
+            s.Sync(special64KRAM);
+            s.Sync(contendedBankPagedIn);
+            s.Sync(showShadowScreen);
+            s.Sync(pagingDisabled);
+
+            for (BankID* bank : { &BankInPage0, &BankInPage1, &BankInPage2, &BankInPage3 }) {
+                byte id = (byte)*bank;
+                s.Sync(id);
+                *bank = (BankID)id;
+            }
+
+            for (int page = 0; page < 8; page++) {
+                int readIndex = PageIndex(PageReadPointer[page]);
+                int writeIndex = PageIndex(PageWritePointer[page]);
+                s.Sync(readIndex);
+                s.Sync(writeIndex);
+
+                if (Stream::LOADING) {
+                    PageReadPointer[page] = PageFromIndex(readIndex);
+                    PageWritePointer[page] = PageFromIndex(writeIndex);
+                }
+            }
+
+            //ULA, keyboard and beeper
+            s.Sync(lastFEOut);
+            s.Sync(borderColour);
+            s.Sync(flashOn);
+            s.Sync(flashFrameCount);
+            s.Sync(FrameCount);
+            s.Sync(lastTState);
+            s.Sync(elapsedTStates);
+            s.Sync(screenByteCtr);
+            s.Sync(ULAByteCtr);
+            s.Sync(lastScanlineColorCounter);
+            s.Sync(lastPixelValue);
+            s.Sync(lastAttrValue);
+            s.Sync(lastPixelValuePlusOne);
+            s.Sync(lastAttrValuePlusOne);
+            s.Sync(Issue2Keyboard);
+            s.Sync(inputFrameTime);
+            s.Sync(resetFrameTarget);
+            s.Sync(resetFrameCounter);
+
+            for (int& line : keyLine)
+                s.Sync(line);
+
+            uint64_t random = rnd_generator.State();
+            s.Sync(random);
+            rnd_generator.Seed(random);
+
+            s.Sync(timeToOutSound);
+            s.Sync(soundTStatesToSample);
+            s.Sync(averagedSound);
+            s.Sync(soundCounter);
+            s.Sync(lastSoundOut);
+
+            //ULA+
+            s.Sync(ula_plus.Enabled);
+            s.Sync(ula_plus.PaletteEnabled);
+            s.Sync(ula_plus.GroupMode);
+            s.Sync(ula_plus.PaletteGroup);
+            s.Sync(ula_plus.lastULAPlusOut);
+
+            //Only a palette that actually changes invalidates the renderer's colour tables
+            for (int& colour : ula_plus.Palette) {
+                int previous = colour;
+                s.Sync(colour);
+
+                if (colour != previous)
+                    ula_plus.Version++;
+            }
+
+            //Tape position
+            s.Sync(tapeIsPlaying);
+            s.Sync(tapeTStates);
+            s.Sync(edgeDuration);
+            s.Sync(pulseLevel);
+            s.Sync(blockCounter);
+            s.Sync(pulseCounter);
+            s.Sync(repeatCount);
+            s.Sync(bitCounter);
+            s.Sync(bitShifter);
+            s.Sync(dataCounter);
+            s.Sync(dataByte);
+            s.Sync(currentBit);
+            s.Sync(isPauseBlockPreproccess);
+            s.Sync(isProcessingPauseBlock);
+            s.Sync(pauseCounter);
+            s.Sync(tapeBitWasFlipped);
+            s.Sync(tape_stopTimeOut);
+            s.Sync(tape_FrameCount);
+        }
+
+        //SyncCoreState() in a fixed size buffer, kept by rewind snapshots and forks
+        struct CoreState {
+            static const int SIZE = 1024;
+            byte data[SIZE];
+        };
+
+        void SaveCoreState(CoreState& state) {
+            StateWriter writer(state.data, CoreState::SIZE);
+            SyncCoreState(writer);
+            assert(writer.Ok());    //SIZE needs to grow with SyncCoreState()
+        }
+
+        void LoadCoreState(CoreState const& state) {
+            StateReader reader(state.data, CoreState::SIZE);
+            SyncCoreState(reader);
+            StateLoaded();
+        }
+
+        //Rewind (see RewindBuffer)
+        RewindBuffer<CoreState> rewind;
+
+        //Keeps up to snapshots rewind snapshots in poolPages 8k page copies. 0 snapshots
+        //turns rewind off and frees the buffer.
+        void SetRewind(int snapshots, int poolPages = 512) {
+            rewind.Resize(snapshots, poolPages);
+            dirtyRAMPages = 0xffff;
+        }
+
+        //Adds a rewind snapshot of the current state. Call it between frames, e.g. after RunFrame().
+        void PushRewindSnapshot() {
+            CoreState state;
+            SaveCoreState(state);
+            rewind.Push(state, RAMpage, dirtyRAMPages);
+            dirtyRAMPages = 0;
+        }
+
+        //Goes back to the snapshot back steps before the newest one (0 = the newest), dropping
+        //the ones after it. The audio devices carry on from where they are.
+        bool RewindTo(int back) {
+            CoreState state;
+
+            if (!rewind.Rewind(back, state, RAMpage, dirtyRAMPages))
+                return false;
+
+            dirtyRAMPages = 0;
+            DropFork();
+            LoadCoreState(state);
+            MarkAllDirty();
+            return true;
+        }
+
+        //Run-ahead. Fork() keeps the core state and from then on each RAM page is copied the
+        //first time it is written (see NotePageWrite), so RestoreFork() only puts back the pages
+        //the speculative frames touched. ScreenBuffer is left alone: with deferred rendering
+        //only the display cells that differ are flagged for the next RenderFrame(), and the
+        //normal mode rasters the whole of the next frame anyway.
+        CoreState forkState;
+        std::vector<byte> forkPages;                        //the 16 RAM pages as they were at Fork()
+        uint16_t forkSavedPages = 0xffff;                   //pages already in forkPages, all when there's no fork
+        bool forkActive = false;
+        int forkFrameBorderStart = 0;
+        std::vector<BorderChange> forkFrameBorderChanges;
+        uint64_t forkFrameHash = 0;
+        bool forkFrameHashValid = false;
+
+        //Starts a fork at the current state. Call it between frames.
+        void Fork() {
+            if (forkPages.empty())
+                forkPages.resize(sizeof(RAMpage));
+
+            SaveCoreState(forkState);
+            forkFrameBorderStart = frameBorderStart;
+            forkFrameBorderChanges = frameBorderChanges;
+            forkFrameHash = frameHash;
+            forkFrameHashValid = frameHashValid;
+            forkSavedPages = 0;
+            forkActive = true;
+        }
+
+        //Goes back to the state at Fork(). The fork stays, so this can be done again.
+        bool RestoreFork() {
+            if (!forkActive)
+                return false;
+
+            for (int f = 0; f < 16; f++) {
+                if (!(forkSavedPages & (1 << f)))
+                    continue;
+
+                byte const* saved = &forkPages[f * 8192];
+
+                if (deferredRender && (f == (int)RAM_BANK::FIVE_LOW || f == (int)RAM_BANK::SEVEN_LOW)) {
+                    for (int offset = 0; offset < 6912; offset++) {
+                        if (RAMpage[f][offset] != saved[offset])
+                            MarkDisplayDirty(offset);
+                    }
+                }
+
+                memcpy(RAMpage[f], saved, 8192);
+            }
+
+            dirtyRAMPages |= forkSavedPages;
+            forkSavedPages = 0;
+
+            LoadCoreState(forkState);
+            frameBorderStart = forkFrameBorderStart;
+            frameBorderChanges = forkFrameBorderChanges;
+            frameHash = forkFrameHash;
+            frameHashValid = forkFrameHashValid;
+            return true;
+        }
 
-            do {
-                result = rand();
-            } while (result >= usable_max);
+        void DropFork() {
+            forkActive = false;
+            forkSavedPages = 0xffff;
+        }
 
-            return min + (result % range);
+        //Copies a RAM page into forkPages before its first write since Fork()
+        void SaveForkPage(int ramPage) {
+            memcpy(&forkPages[ramPage * 8192], RAMpage[ramPage], 8192);
+            forkSavedPages |= (uint16_t)(1 << ramPage);
         }
 
         //Resets the speccy
@@ -527,6 +1224,10 @@ namespace rm {
             if (hardReset)
             {
                 cpu.HardReset();
+
+                //A cold boot starts from cleared RAM, a soft reset keeps it
+                memset(RAMpage, 0, sizeof(RAMpage));
+                memset(JunkMemory, 0, sizeof(JunkMemory));
             }
             else {
                 cpu.UserReset();
@@ -564,9 +1265,19 @@ namespace rm {
             flashOn = false;
             lastScanlineColorCounter = 0;
 
+            if (deterministic)
+                rnd_generator.Seed(deterministicSeed);
+
             //We jiggle the wait period after resetting so that FRAMES/RANDOMIZE works randomly enough on the speccy.
-            resetFrameTarget = RandInt(40, 90);        
-            inputFrameTime = RandInt(0, FrameLength);
+            resetFrameTarget = rnd_generator.Next(40, 90);
+            inputFrameTime = rnd_generator.Next(0, FrameLength);
+
+            RefreshContendedPages();
+            MarkAllDirty();
+            dirtyRAMPages = 0xffff;
+            DropFork();
+            ResetBorderLog();
+            ResetSchedule();
         }
 
         //Updates the tape state
@@ -615,6 +1326,10 @@ namespace rm {
 
         //Updates the tape state
         void UpdateTapePlayback() {
+#if RM_SUBSYSTEM_TIMERS
+            SubsystemTimer timer(subsystemTimes.tapeNs);
+#endif
+
             if (!isProcessingPauseBlock) {
                 while (tapeTStates >= edgeDuration) {
                     tapeTStates = (int)(tapeTStates - edgeDuration);
@@ -644,7 +1359,6 @@ namespace rm {
                 screen.clear();
                 attr.clear();
                 tstateToDisp.clear();
-                keyBuffer.clear();
             //}
         }
 
@@ -660,6 +1374,7 @@ namespace rm {
                             tapeTStates += _a;
                             cpu.regs.PC += 2;
                             cpu.regs.A = 0;
+                            cpu.MaterializeFlags();
                             cpu.regs.F |= 64;
                         }
                     }
@@ -901,44 +1616,13 @@ namespace rm {
                     
                     //lock (lockThis)
                     {
-                        //Tape Save trap is active only if lower ROM is 48k
-                        if (cpu.regs.PC == 0x04d1 && !tapeTrapsDisabled && lowROMis48K)
-                        {
-                            OnTapeEvent(TapeEventType::SAVE_TAP);
-                            cpu.regs.IX = (ushort)(cpu.regs.IX + cpu.regs.DE);
-                            cpu.regs.DE = 0;
-                            cpu.regs.PC = 1342;
-                            ResetKeyboard();
-                        }
-
-                        if (doRun)
-                            Process();
-
+                        ExecuteStep();
                     } //lock
 
                     if (needsPaint) {
+                        UpdateFrameCount();
 
-                        if (tapeIsPlaying) {
-                            if (tape_AutoPlay && tape_AutoStarted) {
-                                if (!(isPauseBlockPreproccess && (edgeDuration > 0) && cpu.and_32_Or_64)) {
-                                    if (tape_stopTimeOut <= 0) {
-                                        // if (TapeEvent != null)
-                                        //     OnTapeEvent(new TapeEventArgs(TapeEventType.STOP_TAPE)); //stop the tape!
-                                        DoTapeEvent(TapeEventType::STOP_TAPE);
-                                        tape_AutoStarted = false;
-                                    }
-                                    else
-                                        tape_stopTimeOut--;
-                                }
-                            }
-                        }
-
-                        FrameCount++;
-                        if (FrameCount >= 50) {
-                            FrameCount = 0;
-                        }
-
-                        if (!externalSingleStep && emulationSpeed == 1) {
+                        if (!externalSingleStep && emulationSpeed == 1 && !turbo) {
                             while (!beeper.FinishedPlaying() && !tapeIsPlaying)
                                 ;//System.Threading.Thread.Sleep(1);
                         }
@@ -958,6 +1642,118 @@ namespace rm {
             }
         }
 
+        //Runs the save trap, then the next instruction or batch of instructions
+        void ExecuteStep() {
+            //Tape Save trap is active only if lower ROM is 48k
+            if (cpu.regs.PC == 0x04d1 && !tapeTrapsDisabled && lowROMis48K)
+            {
+                OnTapeEvent(TapeEventType::SAVE_TAP);
+                cpu.regs.IX = (ushort)(cpu.regs.IX + cpu.regs.DE);
+                cpu.regs.DE = 0;
+                cpu.regs.PC = 1342;
+                ResetKeyboard();
+            }
+
+            if (doRun) {
+                if (fastTiming)
+                    ProcessFast();
+                else if (batchExecution)
+                    ProcessBatch();
+                else
+                    Process();
+            }
+        }
+
+        //Per frame bookkeeping once the ULA has painted the frame: tape auto stop and the
+        //frame counter the tape time out uses.
+        void UpdateFrameCount() {
+            if (tapeIsPlaying) {
+                if (tape_AutoPlay && tape_AutoStarted) {
+                    if (!(isPauseBlockPreproccess && (edgeDuration > 0) && cpu.and_32_Or_64)) {
+                        if (tape_stopTimeOut <= 0) {
+                            // if (TapeEvent != null)
+                            //     OnTapeEvent(new TapeEventArgs(TapeEventType.STOP_TAPE)); //stop the tape!
+                            DoTapeEvent(TapeEventType::STOP_TAPE);
+                            tape_AutoStarted = false;
+                        }
+                        else
+                            tape_stopTimeOut--;
+                    }
+                }
+            }
+
+            FrameCount++;
+            if (FrameCount >= 50) {
+                FrameCount = 0;
+            }
+        }
+
+        //Runs until the ULA has finished the current frame, without waiting on the sound card.
+        //Returns false if execution was stopped (doRun cleared) first.
+        bool RunFrame() {
+            needsPaint = false;
+
+            while (doRun && !needsPaint)
+                ExecuteStep();
+
+            if (!needsPaint)
+                return false;
+
+            UpdateFrameCount();
+            return true;
+        }
+
+        //Switches turbo mode. Unlike SetEmulationSpeed and SetCPUSpeed, which shrink the tstates
+        //each instruction is charged, turbo leaves the emulated timing alone and only stops Run()
+        //waiting on the sound card. Audio is discarded while it is on.
+        void SetTurbo(bool enabled) {
+            if (turbo == enabled)
+                return;
+
+            turbo = enabled;
+            DropAudio();
+            scheduler.Schedule(audioSampleEvent, cpu.t_states);
+        }
+
+        //Runs frames back to back as fast as the host allows, for skipping intros and scripted
+        //test runs. Emulated timing is exact, so tape loading behaves as at normal speed. Audio
+        //is discarded and only every renderEvery-th frame is rastered to ScreenBuffer; the last
+        //frame always is. Returns the achieved frame rate.
+        TurboReport RunFrames(int frames, int renderEvery = 0) {
+            bool wasTurbo = turbo;
+            bool wasDeferred = deferredRender;
+            TurboReport report = { 0, 0, 0.0, 0.0 };
+
+            SetTurbo(true);
+
+            //Deferred rendering keeps the ULA idle on frames that are never shown
+            if (!wasDeferred)
+                SetDeferredRender(true);
+
+            auto start = std::chrono::steady_clock::now();
+
+            while (report.frames < frames && RunFrame()) {
+                report.frames++;
+
+                bool last = report.frames == frames;
+                if (last || (renderEvery > 0 && report.frames % renderEvery == 0)) {
+                    RenderFrame(FrameRequest::FULL);
+                    report.renderedFrames++;
+                }
+            }
+
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (report.seconds > 0.0)
+                report.framesPerSecond = report.frames / report.seconds;
+
+            //ScreenBuffer holds the last frame, the normal raster carries on from the next one
+            if (!wasDeferred)
+                SetDeferredRender(false);
+
+            SetTurbo(wasTurbo);
+            return report;
+        }
+
         //Sets the sound volume of the beeper/ay
         void SetSoundVolume(float vol) {
             soundVolume = vol;
@@ -982,11 +1778,9 @@ namespace rm {
         byte GetOpcode(int addr) {
             addr &= 0xffff;
             //Contend(addr, 3, 1);
-            if (IsContended(addr)) {
-                cpu.t_states += contentionTable[cpu.t_states];
-            }
-
-            cpu.t_states += 3;
+            int stall = contentionTable[cpu.t_states] & contendedPage[addr >> 13];
+            NoteStall(addr, stall);
+            cpu.t_states += stall + 3;
 
             int page = (addr) >> 13;
             int offset = (addr) & 0x1FFF;
@@ -1002,11 +1796,9 @@ namespace rm {
         //Returns the byte at a given 16 bit address (can be contended)
         byte PeekByte(ushort addr) {
             //Contend(addr, 3, 1);
-            if (IsContended(addr)) {
-                cpu.t_states += contentionTable[cpu.t_states];
-            }
-
-            cpu.t_states += 3;
+            int stall = contentionTable[cpu.t_states] & contendedPage[addr >> 13];
+            NoteStall(addr, stall);
+            cpu.t_states += stall + 3;
 
             int page = (addr) >> 13;
             int offset = (addr) & 0x1FFF;
@@ -1020,25 +1812,53 @@ namespace rm {
         }
 
         //Returns the byte at a given 16 bit address (can be contended)
-        virtual void PokeByte(ushort addr, byte b) {
+        void PokeByte(ushort addr, byte b) {
             //This call flags a memory change event for the debugger
             //if (MemoryWriteEvent != null)
                 OnMemoryWriteEvent(addr, b);
 
-            if (IsContended(addr)) {
-                cpu.t_states += contentionTable[cpu.t_states];
-            }
-            cpu.t_states += 3;
+            int stall = contentionTable[cpu.t_states] & contendedPage[addr >> 13];
+            NoteStall(addr, stall);
+            cpu.t_states += stall + 3;
             int page = (addr) >> 13;
             int offset = (addr) & 0x1FFF;
 
-            if (((addr & 49152) == 16384) && (PageReadPointer[page][offset] != b)) {
+            if (!deferredRender && ((addr & 49152) == 16384) && (PageReadPointer[page][offset] != b))
                 UpdateScreenBuffer(cpu.t_states);
-            }
 
+            NotePageWrite(page, offset, b);
             PageWritePointer[page][offset] = b;
         }
 
+        //Called before b is written at offset in the RAM page mapped for writing at a cpu
+        //page. Writes to ROM or JunkMemory fall outside RAMpage and are ignored.
+        void NotePageWrite(int page, int offset, byte b) {
+            uintptr_t distance = (uintptr_t)PageWritePointer[page] - (uintptr_t)RAMpage;
+
+            if (distance < sizeof(RAMpage))
+                NoteRAMWrite((int)(distance >> 13), offset, b);
+        }
+
+        //Called before b is written at offset in a RAMpage: flags the page for the next rewind
+        //snapshot and, the first time after a Fork(), keeps a copy of it. In deferred render
+        //mode a change to the shown screen marks its cell, whichever cpu page it was written
+        //through (the 128K machines can also reach banks 5 and 7 at 0xc000).
+        void NoteRAMWrite(int ramPage, int offset, byte b) {
+            uint16_t bit = (uint16_t)(1 << ramPage);
+            dirtyRAMPages |= bit;
+
+            if (!(forkSavedPages & bit))
+                SaveForkPage(ramPage);
+
+            if (deferredRender && ramPage == ShownScreenPage() && offset < 6912 && RAMpage[ramPage][offset] != b)
+                MarkDisplayDirty(offset);
+        }
+
+        //The RAMpage holding the display memory the ULA is showing
+        int ShownScreenPage() const {
+            return showShadowScreen ? (int)RAM_BANK::SEVEN_LOW : (int)RAM_BANK::FIVE_LOW;
+        }
+
         //Pokes a 16 bit value at given address. Contention applies.
         void PokeWord(ushort addr, ushort w) {
             PokeByte(addr, (byte)(w & 0xff));
@@ -1049,189 +1869,636 @@ namespace rm {
         void PokeRAMPage(int bank, int dataLength, std::vector<byte> const& data) {
             for (int f = 0; f < dataLength; f++) {
                 int indx = f / 8192;
+                NoteRAMWrite(bank * 2 + indx, f % 8192, data[f]);
                 RAMpage[bank * 2 + indx][f % 8192] = data[f];
             }
         }
 
-        //Pokes bytes from an array into contiguous rom banks.
-        void PokeROMPages(int bank, int dataLength, std::vector<byte> const& data) {
-            for (int f = 0; f < dataLength; f++) {
-                int indx = f / 8192;
-                ROMpage[bank * 2 + indx][f % 8192] = data[f];
-            }
+        //Pokes bytes from an array into contiguous rom banks.
+        void PokeROMPages(int bank, int dataLength, std::vector<byte> const& data) {
+            for (int f = 0; f < dataLength; f++) {
+                int indx = f / 8192;
+                ROMpage[bank * 2 + indx][f % 8192] = data[f];
+            }
+        }
+
+        //Pokes the byte at a given 16 bit address with no contention
+        void PokeByteNoContend(int addr, int b) {
+            addr &= 0xffff;
+            b &= 0xff;
+
+            int page = (addr) >> 13;
+            int offset = (addr) & 0x1FFF;
+
+            NotePageWrite(page, offset, (byte)b);
+            PageWritePointer[page][offset] = (byte)b;
+        }
+
+        //Pokes  byte from an array at a given 16 bit address with no contention
+        void PokeBytesNoContend(int addr, int dataOffset, int dataLength, std::vector<byte> const& data) {
+            int page, offset;
+
+            for (int f = dataOffset; f < dataOffset + dataLength; f++, addr++) {
+                addr &= 0xffff;
+                page = (addr) >> 13;
+                offset = (addr) & 0x1FFF;
+                NotePageWrite(page, offset, data[f]);
+                PageWritePointer[page][offset] = data[f];
+            }
+        }
+
+        //Ports a model decodes besides the ULA, e.g. 0x7ffd on the 128K. A port goes to the
+        //model's InPort()/OutPort() when (port & mask) == value for one of these. In() and Out()
+        //are not virtual, so everything else stays inlined in the bus.
+        struct PortDecode {
+            ushort mask;
+            ushort value;
+        };
+        std::vector<PortDecode> modelPorts;
+
+        bool IsModelPort(ushort port) const {
+            for (auto const& decode : modelPorts) {
+                if ((port & decode.mask) == decode.value)
+                    return true;
+            }
+
+            return false;
+        }
+
+        //Reads a port listed in modelPorts
+        virtual byte InPort(ushort /*port*/) {
+            return 0xff;
+        }
+
+        //Writes a port listed in modelPorts
+        virtual void OutPort(ushort /*port*/, byte /*val*/) {
+        }
+
+        //Returns a value from a port (can be contended). Even ports are the ULA on every model.
+        byte In(ushort port) {
+            //Raise a port I/O event
+            //if (PortEvent != null)
+                OnPortEvent(port, 0, false);
+
+            ContendPortEarly(port);
+            ContendPortLate(port);
+            cpu.t_states++;
+
+            return ReadPort(port);
+        }
+
+        //Used purely to raise an event with the debugger for IN with a specific value
+        void In(ushort port, byte val) {
+            //Raise a port I/O event
+            //if (PortEvent != null)
+                OnPortEvent(port, val, false);
+        }
+
+        //Outputs a value to a port (can be contended). Even ports are the ULA on every model.
+        void Out(ushort port, byte val) {
+            //Raise a port I/O event
+            //if (PortEvent != null)
+                OnPortEvent(port, val, true);
+
+            ContendPortEarly(port);
+            WritePort(port, val);
+            ContendPortLate(port);
+            cpu.t_states++;
+        }
+
+        //The devices behind a port read, at cpu.t_states. In() and SpectrumFastBus::In() add the timing.
+        byte ReadPort(ushort port) {
+            byte result = 0xff;
+
+            if ((port & 0x01) == 0)
+                result = ReadULAPort(port);
+
+            if (IsModelPort(port))
+                result &= InPort(port);
+
+            for (auto& d : io_devices) {
+                byte val = d->In(port);
+
+                if (d->Responded())
+                    result = val;
+            }
+
+            return result;
+        }
+
+        //The devices behind a port write, at cpu.t_states. Out() and SpectrumFastBus::Out() add the timing.
+        void WritePort(ushort port, byte val) {
+            if ((port & 0x01) == 0)
+                WriteULAPort(val);
+
+            if (IsModelPort(port))
+                OutPort(port, val);
+
+            for (auto& d : io_devices)
+                d->Out(port, val);
+        }
+
+        //Keyboard half rows picked by the clear bits of the high address byte, and the EAR
+        //input: the tape while it plays, otherwise the last EAR (and on issue 2, MIC) output.
+        byte ReadULAPort(ushort port) {
+            int result = 0xff;
+
+            for (int row = 0; row < 8; row++) {
+                if ((port & (0x100 << row)) == 0)
+                    result &= keyLine[row];
+            }
+
+            bool ear;
+            if (tapeIsPlaying)
+                ear = pulseLevel != 0;
+            else if (Issue2Keyboard)
+                ear = (lastFEOut & (EAR_BIT | MIC_BIT)) != 0;
+            else
+                ear = (lastFEOut & EAR_BIT) != 0;
+
+            if (!ear)
+                result &= ~TAPE_BIT;
+
+            return (byte)result;
+        }
+
+        //Border and beeper. The tape drives soundOut while it plays (see FlipTapeBit).
+        void WriteULAPort(byte val) {
+            lastFEOut = val;
+            SetBorderColour(val & BORDER_BIT);
+
+            if (!tapeIsPlaying)
+                soundOut = (val & EAR_BIT) ? (short)(SHRT_MIN >> 1) : (short)0;
+        }
+
+        virtual bool IsKempstonActive(int port) {
+            if (UseKempstonPort1F) {
+                if ((port & 0xe0) == 0)
+                    return true;
+            }
+            else if ((port & 0x20) == 0)
+                return true;
+
+            return false;
+        }
+        //Rebuilds the attribute to colour tables if the palette, flash or ULA+ state changed
+        //since the last time they were built. Checked once per catch-up, not per byte.
+        //Returns true if the tables were rebuilt.
+        bool RefreshColourTables() {
+            bool ulaPlusActive = ula_plus.Enabled && ula_plus.PaletteEnabled;
+
+            if (colourTablesValid && cachedFlashOn == flashOn && cachedULAPlusActive == ulaPlusActive
+                && cachedPaletteVersion == paletteVersion && cachedULAPlusVersion == ula_plus.Version)
+                return false;
+
+            for (int a = 0; a < 256; a++) {
+                int bright = (a & 0x40) >> 3;
+                int flash = (a & 0x80) >> 7;
+                int ink = (a & 0x07);
+                int paper = ((a >> 3) & 0x7);
+                int paletteInk = AttrColors[ink + bright];
+                int palettePaper = AttrColors[paper + bright];
+
+                if (flashOn && (flash != 0)) //swap paper and ink when flash is on
+                {
+                    int temp = paletteInk;
+                    paletteInk = palettePaper;
+                    palettePaper = temp;
+                }
+
+                if (ulaPlusActive) {
+                    paletteInk = ula_plus.Palette[(((flash << 1) + (bright >> 3)) << 4) + ink]; //(flash*2 + bright) * 16 + ink
+                    palettePaper = ula_plus.Palette[(((flash << 1) + (bright >> 3)) << 4) + paper + 8]; //(flash*2 + bright) * 16 + paper + 8
+                }
+
+                attrInk[a] = paletteInk;
+                attrPaper[a] = palettePaper;
+            }
+
+            for (int b = 0; b < 8; b++)
+                borderColours[b] = ulaPlusActive ? ula_plus.Palette[b + 8] : AttrColors[b];
+
+            cachedFlashOn = flashOn;
+            cachedULAPlusActive = ulaPlusActive;
+            cachedPaletteVersion = paletteVersion;
+            cachedULAPlusVersion = ula_plus.Version;
+            colourTablesValid = true;
+            return true;
+        }
+
+        //Call after modifying AttrColors directly (SetPalette does this already)
+        void InvalidatePalette() { paletteVersion++; }
+
+        //Updates the state of the renderer
+        void UpdateScreenBuffer(int _tstates) {
+            if ((deferredRender || fastTiming) && !renderingFrame) {
+                return;
+            }
+
+            if (_tstates < ActualULAStart) {
+                return;
+            } else if (_tstates >= FrameLength) {
+                _tstates = FrameLength - 1;
+                //Since we're updating the entire screen here, we don't need to re-paint
+                //it again in the  process loop on framelength overflow.
+
+                needsPaint = true;
+            }
+
+            //the additional 1 tstate is required to get correct number of bytes to output in ircontention.sna
+            elapsedTStates = (_tstates + 1 - lastTState);
+
+            //It takes 4 tstates to write 1 byte. Or, 2 pixels per t-state.
+
+            int numBytes = (elapsedTStates >> 2) + ((elapsedTStates % 4) > 0 ? 1 : 0);
+
+            if (numBytes <= 0)
+                return;
+
+#if RM_SUBSYSTEM_TIMERS
+            SubsystemTimer timer(subsystemTimes.renderNs);
+#endif
+
+            RefreshColourTables();
+
+            int* out = ScreenBuffer.data() + ULAByteCtr;
+            short const* disp = tstateToDisp.data() + lastTState;
+            byte const* display = screen.data();
+            PixelKernel::ExpandFunc expand = PixelKernel::Expand;
+
+            int i = 0;
+            while (i < numBytes) {
+                int d = disp[i << 2];
+
+                if (d > 1) {
+                    //Run of display bytes
+                    int pixelData;
+                    int attrData;
+
+                    do {
+                        //tstateToDisp and attr hold cpu addresses, adjust for actual screen offset
+                        pixelData = display[d - 16384];
+                        attrData = display[attr[d - 16384] - 16384];
+
+                        expand(out, (byte)pixelData, attrInk[attrData], attrPaper[attrData]);
+                        out += 8;
+                        i++;
+                    } while (i < numBytes && (d = disp[i << 2]) > 1);
+
+                    screenByteCtr = disp[(i - 1) << 2] - 16384;
+                    lastPixelValue = pixelData;
+                    //The last pixel written decides which colour index is left behind
+                    lastAttrValue = (pixelData & 0x01) ? (attrData & 0x07) : ((attrData >> 3) & 0x7);
+                } else if (d == 1) {
+                    //Run of border bytes, coloured from the border log
+                    int first = i;
+
+                    do {
+                        i++;
+                    } while (i < numBytes && disp[i << 2] == 1);
+
+                    out = FillBorder(out, lastTState + (first << 2), i - first);
+                } else {
+                    i++;
+                }
+            }
+
+            ULAByteCtr = (int)(out - ScreenBuffer.data());
+            lastTState += numBytes << 2;
+
+            if(lastScanlineColorCounter >= ScanLineWidth)
+                lastScanlineColorCounter = 0;
+        }
+
+        // Wrapper for ULA events
+        void UpdateScreenBuffer() {
+            UpdateScreenBuffer(cpu.t_states);
+        }
+
+        //Switches between rastering as the frame runs (the default, needed for racing the beam
+        //effects) and deferred rendering, where the frame is only rastered on RenderFrame() from
+        //the memory contents at the end of the frame. Border changes keep their timing.
+        void SetDeferredRender(bool enabled) {
+            deferredRender = enabled;
+            ResetBorderLog();
+            frameBorderChanges.clear();
+            frameBorderStart = borderColour;
+            renderedFrameValid = false;
+            MarkAllDirty();
+        }
+
+        //Hashes what each completed frame's picture is made from, so IsDuplicateFrame() can tell
+        //the frontend to skip the copy and upload, and RenderFrame() can skip the raster. The
+        //display memory is only rehashed in deferred render mode once something is written to
+        //it. In the normal mode the hash sees the display memory at the end of the frame, so
+        //mid-frame tricks that leave it as it was aren't noticed.
+        void SetFrameDedup(bool enabled) {
+            frameDedup = enabled;
+            duplicateFrame = false;
+            frameHashValid = false;
+            renderedFrameValid = false;
+            displayChangedSinceHash = true;
+        }
+
+        bool IsDuplicateFrame() const { return duplicateFrame; }
+
+        //Hash of the display memory, the last frame's border log, the flash phase (if anything
+        //flashes) and the palette
+        uint64_t PictureHash() {
+            if (!deferredRender || displayChangedSinceHash) {
+                int length = std::min((int)screen.size(), 6912) & ~7;
+                displayHash = Hash::Words(screen.data(), length);
+                displayHasFlash = false;
+
+                for (int a = 6144; a < length && !displayHasFlash; a++)
+                    displayHasFlash = (screen[a] & 0x80) != 0;
+
+                displayChangedSinceHash = false;
+            }
+
+            bool ulaPlusActive = ula_plus.Enabled && ula_plus.PaletteEnabled;
+            int state[] = { frameBorderStart, displayHasFlash && flashOn, paletteVersion, ulaPlusActive };
+
+            uint64_t hash = Hash::Fnv1a(state, sizeof(state), displayHash);
+            hash = Hash::Words(frameBorderChanges.data(), frameBorderChanges.size() * sizeof(BorderChange), hash);
+
+            if (ulaPlusActive)
+                hash = Hash::Words(ula_plus.Palette, sizeof(ula_plus.Palette), hash);
+
+            return hash;
+        }
+
+        //Flags the character cell of a display memory offset (0x0000-0x1aff) as changed
+        void MarkDisplayDirty(int offset) {
+            int cell;
+
+            if (offset < 6144) {
+                int y = ((offset >> 8) & 0x07) | ((offset >> 2) & 0x38) | ((offset >> 5) & 0xc0);
+                cell = ((y >> 3) << 5) + (offset & 0x1f);
+            } else if (offset < 6144 + 768) {
+                cell = offset - 6144;
+            } else
+                return;
+
+            dirtyCells[cell] = true;
+            anyCellDirty = true;
+            displayChangedSinceHash = true;
+        }
+
+        void MarkAllDirty() {
+            allCellsDirty = true;
+            anyCellDirty = true;
+            displayChangedSinceHash = true;
+        }
+
+        //Sets the border from a port 0xfe write. Rather than catching up the raster first,
+        //the change goes in the frame's border log (borderChanges), which the raster reads
+        //when it gets there, so a border stripe loader costs a push_back per OUT.
+        void SetBorderColour(int colour) {
+            borderColour = colour & BORDER_BIT;
+            NoteBorderChange();
+        }
+
+        //Logs borderColour at the current tstate unless the log already ends on it. The bus
+        //calls this after every port write that changed the border, which covers machines
+        //whose Out() sets borderColour directly.
+        void NoteBorderChange() {
+            int logged = borderChanges.empty() ? borderAtFrameStart : borderChanges.back().colour;
+
+            if (logged != borderColour)
+                borderChanges.push_back({ cpu.t_states, borderColour });
+        }
+
+        //Starts a new border log from the current border, for a new frame or a state change
+        void ResetBorderLog() {
+            borderChanges.clear();
+            borderAtFrameStart = rasterBorderColour = borderColour;
+            rasterBorderIndex = 0;
         }
 
-        //Pokes the byte at a given 16 bit address with no contention
-        void PokeByteNoContend(int addr, int b) {
-            addr &= 0xffff;
-            b &= 0xff;
+        //Fills bytes border bytes from the one at tstate, splitting the run where the border
+        //log changes colour. A change at tstate t applies to the bytes after t, as if the raster
+        //had been caught up to t before the write.
+        int* FillBorder(int* out, int tstate, int bytes) {
+            while (bytes > 0) {
+                while (rasterBorderIndex < borderChanges.size() && borderChanges[rasterBorderIndex].tstate < tstate)
+                    rasterBorderColour = borderChanges[rasterBorderIndex++].colour;
 
-            int page = (addr) >> 13;
-            int offset = (addr) & 0x1FFF;
+                int count = bytes;
 
-            PageWritePointer[page][offset] = (byte)b;
+                if (rasterBorderIndex < borderChanges.size()) {
+                    int keep = ((borderChanges[rasterBorderIndex].tstate - tstate) >> 2) + 1;
+                    if (keep < count)
+                        count = keep;
+                }
+
+                PixelKernel::Fill(out, count * 8, borderColours[rasterBorderColour]);
+                out += count * 8;
+                tstate += count * 4;
+                bytes -= count;
+            }
+
+            return out;
         }
 
-        //Pokes  byte from an array at a given 16 bit address with no contention
-        void PokeBytesNoContend(int addr, int dataOffset, int dataLength, std::vector<byte> const& data) {
-            int page, offset;
+        //Calls span(index, pixels, colour) for each single colour stretch of the border, given a
+        //frame's border log and the colour it started with
+        template<class SpanFunc>
+        void ForEachBorderSpan(std::vector<BorderChange> const& log, int colour, SpanFunc span) {
+            if (displayToBuffer.empty())
+                BuildDisplayMap();
 
-            for (int f = dataOffset; f < dataOffset + dataLength; f++, addr++) {
-                addr &= 0xffff;
-                page = (addr) >> 13;
-                offset = (addr) & 0x1FFF;
-                PageWritePointer[page][offset] = data[f];
+            size_t next = 0;
+
+            for (BorderRun const& run : borderRuns) {
+                int tstate = run.tstate;
+                int index = run.index;
+                int bytes = run.bytes;
+
+                while (bytes > 0) {
+                    while (next < log.size() && log[next].tstate < tstate)
+                        colour = log[next++].colour;
+
+                    int count = bytes;
+
+                    if (next < log.size()) {
+                        int keep = ((log[next].tstate - tstate) >> 2) + 1;
+                        if (keep < count)
+                            count = keep;
+                    }
+
+                    span(index, count * 8, colour);
+                    index += count * 8;
+                    tstate += count * 4;
+                    bytes -= count;
+                }
             }
         }
 
-        //Returns a value from a port (can be contended)
-        virtual byte In(ushort port) {
-            //Raise a port I/O event
-            //if (PortEvent != null)
-                OnPortEvent(port, 0, false);
-
-            return 0;
+        //The border of the last completed frame as spans of one colour, for frontends that draw
+        //the border themselves
+        void FrameBorderSpans(std::vector<BorderSpan>& spans) {
+            spans.clear();
+            ForEachBorderSpan(frameBorderChanges, frameBorderStart, [&](int index, int pixels, int colour) {
+                if (!spans.empty() && spans.back().colour == colour && spans.back().index + spans.back().pixels == index)
+                    spans.back().pixels += pixels;
+                else
+                    spans.push_back({ index, pixels, colour });
+            });
         }
 
-        //Used purely to raise an event with the debugger for IN with a specific value
-        virtual void In(ushort port, byte val) {
-            //Raise a port I/O event
-            //if (PortEvent != null)
-                OnPortEvent(port, val, false);
+        //Fills the whole border of the last completed frame from its log
+        void RenderBorder() {
+            RefreshColourTables();
+            ForEachBorderSpan(frameBorderChanges, frameBorderStart, [&](int index, int pixels, int colour) {
+                PixelKernel::Fill(&ScreenBuffer[index], pixels, borderColours[colour]);
+            });
+
+            renderedBorder = frameBorderChanges.empty() ? frameBorderStart : -1;
         }
 
-        //Outputs a value to a port (can be contended)
-        //The base call is used only to raise memory events
-        virtual void Out(ushort port, byte val) {
-            //Raise a port I/O event
-            //if (PortEvent != null)
-                OnPortEvent(port, val, true);
+        //Maps each display byte to the ScreenBuffer index the renderer writes it to, and
+        //collects the runs of border bytes, by walking tstateToDisp the same way
+        //UpdateScreenBuffer does.
+        void BuildDisplayMap() {
+            displayToBuffer.assign(6144, -1);
+            borderRuns.clear();
+            int ctr = 0;
+
+            for (int t = ActualULAStart; t < FrameLength; t += 4) {
+                int d = tstateToDisp[t];
+
+                if (d > 1) {
+                    displayToBuffer[d - 16384] = ctr;
+                    ctr += 8;
+                } else if (d == 1) {
+                    if (!borderRuns.empty() && borderRuns.back().index + borderRuns.back().bytes * 8 == ctr
+                        && borderRuns.back().tstate + borderRuns.back().bytes * 4 == t)
+                        borderRuns.back().bytes++;
+                    else
+                        borderRuns.push_back({ t, 1, ctr });
+
+                    ctr += 8;
+                }
+            }
         }
 
-        virtual bool IsKempstonActive(int port) {
-            if (UseKempstonPort1F) {
-                if ((port & 0xe0) == 0)
-                    return true;
+        //Rasters the last completed frame as requested. Only meaningful in deferred render mode.
+        //When rects is given it receives the ScreenBuffer areas that were updated. Returns false
+        //if nothing was rastered.
+        bool RenderFrame(FrameRequest request, std::vector<ScreenRect>* rects = nullptr) {
+            if (rects)
+                rects->clear();
+
+            if (!deferredRender || request == FrameRequest::SKIP)
+                return false;
+
+            //ScreenBuffer already holds this picture, even a full raster would come out the same
+            if (frameDedup && frameHashValid) {
+                if (renderedFrameValid && renderedFrameHash == frameHash) {
+                    ClearDirty();
+                    return false;
+                }
+
+                renderedFrameHash = frameHash;
+                renderedFrameValid = true;
             }
-            else if ((port & 0x20) == 0)
+
+            if (RefreshColourTables())
+                MarkAllDirty();
+
+            ScreenRect const whole = { 0, 0, ScanLineWidth, (int)ScreenBuffer.size() / ScanLineWidth };
+
+            if (request == FrameRequest::FULL || allCellsDirty) {
+                RenderFullFrame();
+
+                if (rects)
+                    rects->push_back(whole);
+
                 return true;
+            }
 
-            return false;
-        }
-        //Updates the state of the renderer
-        virtual void UpdateScreenBuffer(int _tstates) {
-            if (_tstates < ActualULAStart) {
-                return;
-            } else if (_tstates >= FrameLength) {
-                _tstates = FrameLength - 1;
-                //Since we're updating the entire screen here, we don't need to re-paint
-                //it again in the  process loop on framelength overflow.
+            bool borderDirty = !frameBorderChanges.empty() || frameBorderStart != renderedBorder;
 
-                needsPaint = true;
+            if (!borderDirty && !anyCellDirty)
+                return false;
+
+            //The border goes in one go from the log. It is reported as the whole buffer, so
+            //the cells don't need rectangles of their own then.
+            if (borderDirty) {
+                RenderBorder();
+
+                if (rects)
+                    rects->push_back(whole);
+
+                rects = nullptr;
             }
 
-            //the additional 1 tstate is required to get correct number of bytes to output in ircontention.sna
-            elapsedTStates = (_tstates + 1 - lastTState);
+            if (displayToBuffer.empty())
+                BuildDisplayMap();
 
-            //It takes 4 tstates to write 1 byte. Or, 2 pixels per t-state.
+            for (int row = 0; row < 24 && anyCellDirty; row++) {
+                int runStart = -1;
 
-            int numBytes = (elapsedTStates >> 2) + ((elapsedTStates % 4) > 0 ? 1 : 0);
+                for (int col = 0; col <= 32; col++) {
+                    bool dirty = col < 32 && dirtyCells[(row << 5) + col];
 
-            int pixelData;
-            int pixel2Data = 0xff;
-            int attrData;
-            int attr2Data;
-            int bright;
-            int ink;
-            int paper;
-            int flash;
-
-            for (int i = 0; i < numBytes; i++) {
-                if (tstateToDisp[lastTState] > 1) {
-                   // for (int p = 0; p < 2; p++) {
-                        screenByteCtr = tstateToDisp[lastTState] - 16384; //adjust for actual screen offset
-                  
-                        pixelData = screen[screenByteCtr];
-                        attrData = screen[attr[screenByteCtr] - 16384];
-
-                        lastPixelValue = pixelData;
-                        lastAttrValue = attrData;
-                       /* if ((I & 0x40) == 0x40) {
-                            {
-                                if (p == 0) {
-                                    screenByteCtr = (screenByteCtr + 16384) | (R & 0xff);
-                                    pixel2Data = screenByteCtr & 0xff;
-                                }
-                                else
-                                    screenByteCtr = (screenByteCtr + 16384) | (pixel2Data);
-                                pixelData = screen[(screenByteCtr - 1) - 16384];
-                                lastAttrValue = screen[attr[(screenByteCtr - 1) - 16384] - 16384];
-                            }
-                        }
-                        */
-                        bright = (attrData & 0x40) >> 3;
-                        flash = (attrData & 0x80) >> 7;
-                        ink = (attrData & 0x07);
-                        paper = ((attrData >> 3) & 0x7);
-                        int paletteInk = AttrColors[ink + bright];
-                        int palettePaper = AttrColors[paper + bright];
-
-                        if (flashOn && (flash != 0)) //swap paper and ink when flash is on
-                        {
-                            int temp = paletteInk;
-                            paletteInk = palettePaper;
-                            palettePaper = temp;
-                        }
+                    if (dirty) {
+                        RenderCell(row, col);
 
-                        if (ula_plus.Enabled && ula_plus.PaletteEnabled) {
-                            paletteInk = ula_plus.Palette[(((flash << 1) + (bright >> 3)) << 4) + ink]; //(flash*2 + bright) * 16 + ink
-                            palettePaper = ula_plus.Palette[(((flash << 1) + (bright >> 3)) << 4) + paper + 8]; //(flash*2 + bright) * 16 + paper + 8
-                        }
+                        if (runStart < 0)
+                            runStart = col;
+                    } else if (runStart >= 0) {
+                        //Adjacent dirty cells on a row are reported as one rectangle
+                        int first = displayToBuffer[(((row << 3) & 0xc0) << 5) | (((row << 3) & 0x38) << 2) | runStart];
+                        if (rects && first >= 0)
+                            rects->push_back({ first % ScanLineWidth, first / ScanLineWidth, (col - runStart) << 3, 8 });
 
-                        for (int a = 0; a < 8; ++a) {
-                            if ((pixelData & 0x80) != 0) {
-                                //PAL interlacing
-                                //int pal = paletteInk/2 + (0xffffff - LastScanlineColor[lastScanlineColorCounter]/2);
-                                //ScreenBuffer[ULAByteCtr++] = pal;
-                                //LastScanlineColor[lastScanlineColorCounter++] = paletteInk;
-                                ScreenBuffer[ULAByteCtr++] = paletteInk;
-                                lastAttrValue = ink;
-                            } else {
-                                //PAL interlacing
-                                //int pal = palettePaper/2 + (0xffffff - LastScanlineColor[lastScanlineColorCounter]/2);
-                                //ScreenBuffer[ULAByteCtr++] = pal;
-                                //LastScanlineColor[lastScanlineColorCounter++] = palettePaper;
-                                ScreenBuffer[ULAByteCtr++] = palettePaper;
-                                lastAttrValue = paper;
-                            }
-                            pixelData <<= 1;
-                        }                 
-                    // pixelData = lastPixelValue;
-                } else if (tstateToDisp[lastTState] == 1) {
-                    int bor;
-                    if (ula_plus.Enabled && ula_plus.PaletteEnabled) {
-                        bor = ula_plus.Palette[borderColour + 8];
-                    } else
-                        bor = AttrColors[borderColour];
-
-                    for(int g = 0; g < 8; g++) {
-                        //PAL interlacing
-                        //int pal = bor/2 + (0xffffff -  LastScanlineColor[lastScanlineColorCounter]/2);
-                        //ScreenBuffer[ULAByteCtr++] = pal;
-                        //LastScanlineColor[lastScanlineColorCounter++] = bor;                        
-                        ScreenBuffer[ULAByteCtr++] = bor;
+                        runStart = -1;
                     }
                 }
-                lastTState += 4;
+            }
+
+            ClearDirty();
+            return true;
+        }
+
+        void ClearDirty() {
+            for (bool& c : dirtyCells)
+                c = false;
+
+            anyCellDirty = false;
+            allCellsDirty = false;
+        }
 
-                if(lastScanlineColorCounter >= ScanLineWidth)
-                    lastScanlineColorCounter = 0;
+        //Rasters 8 pixel rows of one character cell from the current display memory
+        void RenderCell(int row, int col) {
+            int attrData = screen[6144 + (row << 5) + col];
+            int ink = attrInk[attrData];
+            int paper = attrPaper[attrData];
+
+            for (int line = 0; line < 8; line++) {
+                int y = (row << 3) + line;
+                int offset = ((y & 0xc0) << 5) | ((y & 0x07) << 8) | ((y & 0x38) << 2) | col;
+                int index = displayToBuffer[offset];
+
+                if (index >= 0)
+                    PixelKernel::Expand(&ScreenBuffer[index], screen[offset], ink, paper);
             }
         }
 
-        // Wrapper for ULA events
-        void UpdateScreenBuffer() {
-            UpdateScreenBuffer(cpu.t_states);
+        //Rasters the whole frame: the border from the last frame's border log, then every
+        //character cell from the current display memory. Unlike a replay through
+        //UpdateScreenBuffer this leaves the raster (and so the floating bus) state alone.
+        void RenderFullFrame() {
+            RenderBorder();
+
+            for (int row = 0; row < 24; row++) {
+                for (int col = 0; col < 32; col++)
+                    RenderCell(row, col);
+            }
+
+            ClearDirty();
         }
 
         //Loads in the ROM for the machine
@@ -1523,7 +2790,7 @@ namespace rm {
 
         //Resets the state of all the keys
         void ResetKeyboard() {
-            for (int f = 0; f < keyBuffer.size(); f++)
+            for (int f = 0; f < (int)keyCode::LAST; f++)
                 keyBuffer[f] = false;
 
             for (int f = 0; f < 8; f++)
@@ -1532,6 +2799,10 @@ namespace rm {
 
         //Updates audio state, called from Process()
         void UpdateAudio(int dt) {
+#if RM_SUBSYSTEM_TIMERS
+            SubsystemTimer timer(subsystemTimes.audioNs);
+#endif
+
             for (auto& ad : audio_devices) {
                 ad->Update(dt);
             }
@@ -1554,6 +2825,8 @@ namespace rm {
         }
 
         virtual void SaveSNA(SNA_SNAPSHOT* snapshot) {
+            cpu.SyncFlags();
+
             if (model == MachineModel::_48k || model == MachineModel::_NTSC48k)
                 snapshot->TYPE = 0;
             else
@@ -1645,6 +2918,7 @@ namespace rm {
         
         //Sets the speccy state to that of the SNA file
         virtual void UseSNA(SNA_SNAPSHOT const* sna) {
+            cpu.SyncFlags();
             cpu.regs.I = sna->I;
             cpu.regs.HL_ = (ushort)sna->H_ << 8 | sna->L_;
             cpu.regs.DE_ = (ushort)sna->D_ << 8 | sna->E_;
@@ -1668,10 +2942,23 @@ namespace rm {
             cpu.regs.SP = (ushort)sna->SPH << 8 | sna->SPL;
             cpu.interrupt_mode = sna->IM;
             borderColour = sna->BORDER;
+            ResetBorderLog();
+
+            RefreshContendedPages();
+            MarkAllDirty();
+            dirtyRAMPages = 0xffff;
+            DropFork();
+
+            if (deterministic)
+                RestartRandom();
         }
 
+        //SZX loading is still the C# original (SZXFile is a class there, ULA_Plus a pointer)
+        //and is compiled out until it's ported
+#if 0
         //Sets the speccy state to that of the SNA file
         public virtual void UseSZX(SZXFile szx) {
+            cpu.SyncFlags();
             cpu.regs.I = szx.z80Regs.I;
             cpu.regs.HL_ = szx.z80Regs.HL1;
             cpu.regs.DE_ = szx.z80Regs.DE1;
@@ -1743,11 +3030,21 @@ namespace rm {
             for (int f = 0; f < 16; f++) {
                 Array.Copy(szx.RAM_BANK[f], 0, RAMpage[f], 0, 8192);
             }
+
+            RefreshContendedPages();
+            MarkAllDirty();
+            dirtyRAMPages = 0xffff;
+            DropFork();
+
+            if (deterministic)
+                RestartRandom();
         }
+#endif
 
         //Sets the speccy state to that of the Z80 file
-        public virtual void UseZ80(Z80_SNAPSHOT z80) 
+        virtual void UseZ80(Z80_SNAPSHOT const& z80)
         {
+            cpu.SyncFlags();
             cpu.regs.I = z80.I;
             cpu.regs.HL_ = (ushort)z80.HL_;
             cpu.regs.DE_ = (ushort)z80.DE_;
@@ -1769,9 +3066,21 @@ namespace rm {
             cpu.regs.PC = (ushort)z80.PC;
             cpu.t_states = z80.TSTATES % FrameLength;
             borderColour = z80.BORDER;
+            ResetBorderLog();
             Issue2Keyboard = z80.ISSUE2;
+
+            RefreshContendedPages();
+            MarkAllDirty();
+            dirtyRAMPages = 0xffff;
+            DropFork();
+            ResetSchedule();
+
+            if (deterministic)
+                RestartRandom();
         }
 
+        //SZX saving is still C# and compiled out, like UseSZX()
+#if 0
         private uint GetUIntFromString(string data) {
             byte[] carray = System.Text.ASCIIEncoding.UTF8.GetBytes(data);
             uint val = BitConverter.ToUInt32(carray, 0);
@@ -1784,6 +3093,7 @@ namespace rm {
         }
 
         private SZXFile CreateSZX() {
+            cpu.SyncFlags();
             SZXFile szx = new SZXFile();
             szx.header = new SZXFile.ZXST_Header();
             szx.creator = new SZXFile.ZXST_Creator();
@@ -1881,23 +3191,26 @@ namespace rm {
 
             return szx;
         }
+#endif
 
         //Enable/disable stereo sound for AY playback
-        public void SetStereoSound(int val) {
-            foreach(var ad in audio_devices) {
+        void SetStereoSound(int val) {
+            for (auto& ad : audio_devices) {
                 if (val == 0)
-                    ad.EnableStereoSound(false);
+                    ad->EnableStereoSound(false);
                 else {
-                    ad.EnableStereoSound(true);
+                    ad->EnableStereoSound(true);
                     if (val == 1)
-                        ad.SetChannelsACB(true);
+                        ad->SetChannelsACB(true);
                     else
-                        ad.SetChannelsACB(false);
+                        ad->SetChannelsACB(false);
                 }
             }
            
         }
 
+        //Needs the AY_8192 device, which isn't in this tree
+#if 0
         //Enables/Disables AY sound
         public virtual void EnableAY(bool val) {
             if (model == MachineModel._48k) {
@@ -1916,12 +3229,13 @@ namespace rm {
                 AddDevice(ay_device);
             }
         }
+#endif
 
         //Sets up the contention table for the machine
-        public abstract void BuildContentionTable();
+        virtual void BuildContentionTable() = 0;
 
         //Builds the tstate to attribute map used for floating bus
-        public void BuildAttributeMap() {
+        void BuildAttributeMap() {
             int start = DisplayStart;
 
             for (int f = 0; f < DisplayLength; f++, start++) {
@@ -1942,7 +3256,7 @@ namespace rm {
         }
 
         //Resets the render state everytime an interrupt is generated
-        public void ULAUpdateStart() {
+        void ULAUpdateStart() {
             ULAByteCtr = 0;
             lastScanlineColorCounter = 0;
             screenByteCtr = DisplayStart;
@@ -1953,17 +3267,31 @@ namespace rm {
         //Returns true if the given address should be contended, false otherwise
         virtual bool IsContended(int addr) = 0;
 
-        //Contends the machine for a given address (_addr)
-        public void Contend(int _addr) {
-            if (model != MachineModel._plus3 && IsContended(_addr)) {
-                cpu.t_states += contentionTable[cpu.t_states];
+        //Rebuilds the per page contention masks from IsContended(). Must be called whenever
+        //the memory map changes (reset, 0x7ffd/0x1ffd writes, snapshot loads). Paging done
+        //through Out() is picked up automatically by SpectrumBus.
+        void RefreshContendedPages() {
+            for (int page = 0; page < 8; page++) {
+                contendedPage[page] = (!fastTiming && IsContended(page << 13)) ? 0xff : 0;
+                contendedCyclePage[page] = (model == MachineModel::_plus3) ? 0 : contendedPage[page];
             }
+
+            contendedPort = (!fastTiming && model != MachineModel::_plus3) ? 0xff : 0;
+        }
+
+        //Contends the machine for a given address (_addr)
+        void Contend(int _addr) {
+            int stall = contentionTable[cpu.t_states] & contendedCyclePage[(_addr >> 13) & 7];
+            NoteStall(_addr, stall);
+            cpu.t_states += stall;
         }
 
         //Contends the machine for a given address (_addr) for n tstates (_time) for x times (_count)
-        public void Contend(int _addr, int _time, int _count) {
-            if (model != MachineModel._plus3 && IsContended(_addr)) {
+        void Contend(int _addr, int _time, int _count) {
+            byte mask = contendedCyclePage[(_addr >> 13) & 7];
+            if (mask) {
                 for (int f = 0; f < _count; f++) {
+                    NoteStall(_addr, contentionTable[cpu.t_states]);
                     cpu.t_states += contentionTable[cpu.t_states] + _time;
                 }
             } else
@@ -1978,23 +3306,21 @@ namespace rm {
         // Yes       | Yes        | C:1 C:3
         // Yes       | No         | C:1 C:1 C:1 C:1
 
-        //Should never be called on +3
-        public void ContendPortEarly(int _addr) {
-            if (IsContended(_addr)) {
-                cpu.t_states += contentionTable[cpu.t_states];
-            }
+        //Port contention is masked with contendedPort, which is 0 on the +3 (no IO contention)
+        //and in fast timing mode
+        void ContendPortEarly(int _addr) {
+            cpu.t_states += contentionTable[cpu.t_states] & contendedPage[(_addr >> 13) & 7] & contendedPort;
             cpu.t_states++;
         }
 
-        //Should never be called on +3
-        public void ContendPortLate(int _addr) {
+        void ContendPortLate(int _addr) {
             bool lowBitReset = (_addr & 0x01) == 0;
 
             if (lowBitReset) {
-                cpu.t_states += contentionTable[cpu.t_states];
+                cpu.t_states += contentionTable[cpu.t_states] & contendedPort;
                 cpu.t_states += 2;
             }
-            else if (IsContended(_addr)) {
+            else if (contendedPage[(_addr >> 13) & 7] & contendedPort) {
                 cpu.t_states += contentionTable[cpu.t_states]; cpu.t_states++;
                 cpu.t_states += contentionTable[cpu.t_states]; cpu.t_states++;
                 cpu.t_states += contentionTable[cpu.t_states];
@@ -2004,8 +3330,8 @@ namespace rm {
             }
         }
 
-        public void ForceContention(int _addr) {
-            if (IsContended(_addr)) {
+        void ForceContention(int _addr) {
+            if (contendedPage[(_addr >> 13) & 7] & contendedPort) {
                 cpu.t_states += contentionTable[cpu.t_states]; cpu.t_states++;
                 cpu.t_states += contentionTable[cpu.t_states]; cpu.t_states++;
                 cpu.t_states += contentionTable[cpu.t_states]; cpu.t_states++;
@@ -2021,6 +3347,8 @@ namespace rm {
         //    return beeper.FinishedPlaying();
         //}
 
+        //Palette files and RZX playback are still C# and compiled out until they're ported
+#if 0
         //Loads the ULAPlus palette
         public bool LoadULAPlusPalette(string filename) {
             using (System.IO.FileStream fs = new System.IO.FileStream(filename, System.IO.FileMode.Open)) {
@@ -2056,6 +3384,7 @@ namespace rm {
         public void NextRZXFrame() {
             cpu.t_states = 0;
             isPlayingRZX = rzx.NextPlaybackFrame();
+            ResetSchedule();
         }
 
         public void EndRZXFrame() {
@@ -2082,30 +3411,31 @@ namespace rm {
             ULAUpdateStart();
             NextRZXFrame();
         }
+#endif
+
+        void PlayAudio() {
+#if RM_SUBSYSTEM_TIMERS
+            SubsystemTimer timer(subsystemTimes.audioNs);
+#endif
 
-        private void PlayAudio() {
             averagedSound /= soundCounter;
 
             while (timeToOutSound >= soundTStatesToSample) {
                 int sumChannel1Output = 0;
                 int sumChannel2Output = 0;
 
-                foreach (var ad in audio_devices) {
-                    ad.EndSampleFrame();
+                for (auto& ad : audio_devices) {
+                    ad->EndSampleFrame();
 
-                    sumChannel1Output += ad.SoundChannel1;
-                    sumChannel2Output += ad.SoundChannel2;
-                    ad.ResetSamples();
+                    sumChannel1Output += ad->SoundChannel1;
+                    sumChannel2Output += ad->SoundChannel2;
+                    ad->ResetSamples();
                 }
                 soundSamples[soundSampleCounter++] = (short)(sumChannel1Output + averagedSound);
                 soundSamples[soundSampleCounter++] = (short)(sumChannel2Output + averagedSound);
 
-                if (soundSampleCounter >= soundSamples.Length) {
-                    byte[] sndbuf = beeper.LockBuffer();
-                    if (sndbuf != null) {
-                        System.Buffer.BlockCopy(soundSamples, 0, sndbuf, 0, sndbuf.Length);
-                        beeper.UnlockBuffer(sndbuf);
-                    }
+                if (soundSampleCounter >= (int)(sizeof(soundSamples) / sizeof(soundSamples[0]))) {
+                    beeper.SubmitBuffer(soundSamples, soundSampleCounter);
                     soundSampleCounter = 0;// (short)(soundSampleCounter - (soundSamples.Length));
                 }
                 timeToOutSound -= soundTStatesToSample;
@@ -2114,6 +3444,20 @@ namespace rm {
             soundCounter = 0;
         }
 
+        //Discards the audio generated since the last sample. The devices keep their state,
+        //only the pending output is lost.
+        void DropAudio() {
+            for (auto& ad : audio_devices) {
+                ad->ResetSamples();
+            }
+
+            timeToOutSound = 0;
+            averagedSound = 0;
+            soundCounter = 0;
+        }
+
+        //RZX playback, still C#. Needs an RZX file port, which isn't in this tree.
+#if 0
         public void ProcessRZX() {
             prevT = cpu.t_states;
             cpu.Step();
@@ -2160,9 +3504,10 @@ namespace rm {
                 }
             }
         }
+#endif
 
         //The heart of the speccy. Executes opcodes till 69888 tstates (1 frame) have passed
-        public void Process() {
+        void Process() {
             //Handle re-triggered interrupts!
             bool ran_interrupt = false;
             if (cpu.iff_1  && cpu.t_states < InterruptPeriod) {
@@ -2179,7 +3524,8 @@ namespace rm {
 #endif
                     }
 
-                    StateChangeEvent?.Invoke(this, new StateChangeEventArgs(SPECCY_EVENT.RE_INTERRUPT));
+                    if (StateChangeEvent)
+                        StateChangeEvent();     //re-interrupt
 
                     Interrupt();
                     ran_interrupt = true;
@@ -2192,7 +3538,7 @@ namespace rm {
 
             //Check if TR DOS needs to be swapped for Pentagon 128k.
             //TR DOS is swapped in when PC >= 15616 and swapped out when PC > 16383.
-            if (model == MachineModel._pentagon) {
+            if (model == MachineModel::_pentagon) {
                 if (trDosPagedIn) {
                     if (cpu.regs.PC > 0x3FFF) {
                         if ((last7ffdOut & 0x10) != 0) {
@@ -2201,7 +3547,7 @@ namespace rm {
                             PageReadPointer[1] = ROMpage[3];
                             PageWritePointer[0] = JunkMemory[0];
                             PageWritePointer[1] = JunkMemory[1];
-                            BankInPage0 = ROM_48_BAS;
+                            BankInPage0 = BankID::ROM_48_BAS;
                             lowROMis48K = true;
                         } else {
                             //128k basic
@@ -2209,7 +3555,7 @@ namespace rm {
                             PageReadPointer[1] = ROMpage[1];
                             PageWritePointer[0] = JunkMemory[0];
                             PageWritePointer[1] = JunkMemory[1];
-                            BankInPage0 = ROM_128_BAS;
+                            BankInPage0 = BankID::ROM_128_BAS;
                             lowROMis48K = false;
                         }
                         trDosPagedIn = false;
@@ -2222,7 +3568,7 @@ namespace rm {
                         PageWritePointer[0] = JunkMemory[0];
                         PageWritePointer[1] = JunkMemory[1];
                         trDosPagedIn = true;
-                        BankInPage0 = ROM_TR_DOS;
+                        BankInPage0 = BankID::ROM_TR_DOS;
                     }
                 } 
             }
@@ -2232,6 +3578,10 @@ namespace rm {
 
                 cpu.Step();
 
+#if RM_SUBSYSTEM_TIMERS
+                subsystemTimes.instructions++;
+#endif
+
                 deltaTStates = cpu.t_states - prevT;
 
                 //// Change CPU speed///////////////////////
@@ -2262,28 +3612,82 @@ namespace rm {
 
                 averagedSound += soundOut;
                 soundCounter++;
-                //Update sound every 79 tstates
-                if (timeToOutSound >= soundTStatesToSample) {
-                    PlayAudio();
-                }
             }
 
-            //Randomize when the keyboard state is updated as in a real speccy (kinda).
+            //Audio samples, input polls and the end of the frame
+            if (cpu.t_states >= scheduler.NextDeadline())
+                scheduler.RunDue(cpu.t_states);
+        }
+
+        //Update sound every 79 tstates. timeToOutSound never runs ahead of cpu.t_states,
+        //so the event can fire early (and simply re-arm) but never late.
+        void OnAudioSampleDue() {
+            if (turbo) {
+                //Nobody is listening, so drop the samples and only come back now and then
+                DropAudio();
+                scheduler.Schedule(audioSampleEvent, cpu.t_states + TURBO_AUDIO_PERIOD);
+                return;
+            }
+
+            if (!externalSingleStep && timeToOutSound >= soundTStatesToSample) {
+                PlayAudio();
+            }
+
+            int wait = soundTStatesToSample - timeToOutSound;
+            scheduler.Schedule(audioSampleEvent, cpu.t_states + (wait > 0 ? wait : 1));
+        }
+
+        //Randomize when the keyboard state is updated as in a real speccy (kinda).
+        void UpdateInputPoll() {
             if (cpu.t_states >= inputFrameTime) {
                 UpdateInput();
                 inputFrameTime = rnd_generator.Next(FrameLength);
             }
 
-            //End of frame?
+            //inputFrameTime is relative to the current frame. If it is already behind us
+            //we poll again after the next instruction, as before.
+            scheduler.Schedule(inputPollEvent, inputFrameTime);
+        }
+
+        //Wraps up the frame once FrameLength tstates have gone by
+        void UpdateFrameEnd() {
             if (cpu.t_states >= FrameLength) {
                 //If machine has already repainted the entire screen,
                 //somewhere midway through execution, we can skip this.
-                if (!needsPaint)
+                if (fastTiming && !deferredRender) {
+                    //No catch-ups happened during the frame, so raster all of it now
+                    renderingFrame = true;
+                    UpdateScreenBuffer(FrameLength);
+                    renderingFrame = false;
+                }
+                else if (!needsPaint)
                     UpdateScreenBuffer(FrameLength);
 
                 OnFrameEndEvent();
 
+                frameBorderStart = borderAtFrameStart;
+                frameBorderChanges.swap(borderChanges);
+                ResetBorderLog();
+
+                if (frameDedup) {
+                    uint64_t hash = PictureHash();
+                    duplicateFrame = frameHashValid && hash == frameHash;
+                    frameHash = hash;
+                    frameHashValid = true;
+                }
+
                 cpu.t_states -= FrameLength;
+                scheduler.Rebase(FrameLength);
+
+#if RM_GUEST_PROFILER
+                if (profiling)
+                    profiler.Rebase(FrameLength);
+#endif
+                scheduler.Schedule(frameEndEvent, FrameLength);
+                scheduler.Schedule(inputPollEvent, inputFrameTime);   //frame relative, so not rebased
+
+                if (deterministic)
+                    frameStateHash = StateHash();
 
                 flashFrameCount++;
 
@@ -2312,8 +3716,162 @@ namespace rm {
             }
         }
 
+        //True when nothing needs checking between instructions until the next event,
+        //so the cpu can run a batch of them in one go.
+        bool CanProcessBatch() {
+            return cpu.t_states >= InterruptPeriod    //not in the interrupt window
+                && cpuMultiplier <= 1                 //speed hacks rescale every instruction
+                && !tapeIsPlaying                     //tape edges and edge detection need per-instruction updates
+                && !isPlayingRZX
+                && !externalSingleStep
+                && model != MachineModel::_pentagon;  //TR DOS is paged by PC
+        }
+
+        //The earliest tstate at which a batch has to stop: an input poll or the end of the
+        //frame. Audio samples don't stop it, FinishBatch() plays the ones it ran past.
+        int GetEventHorizon() {
+            return scheduler.NextDeadlineIgnoring(audioSampleEvent);
+        }
+
+        //Batched version of Process(). Runs the cpu up to the event horizon, then does the
+        //audio, input and frame work once for the whole batch. Falls back to Process()
+        //when per-instruction work is needed.
+        void ProcessBatch() {
+            if (!CanProcessBatch()) {
+                Process();
+                return;
+            }
+
+            //Tape Save trap is active only if lower ROM is 48k
+            cpu.breakPC = (!tapeTrapsDisabled && lowROMis48K) ? 0x04d1 : -1;
+
+            prevT = cpu.t_states;
+            int startSoundOut = soundOut;
+            int count = cpu.RunUntil(GetEventHorizon());
+
+            if (count == 0) {
+                //Nothing ran: either the cpu is on the trap address or the horizon has
+                //already been reached. Process() steps one instruction and runs the events.
+                Process();
+                return;
+            }
+
+            FinishBatch(count, startSoundOut);
+        }
+
+        //Switches the fast timing mode, meant for bulk headless runs where exact timing
+        //doesn't matter. All memory and port contention is replaced by the uncontended cost
+        //and the screen is rastered once at the end of each frame instead of being caught up
+        //on every display or border write, so racing the beam effects are lost.
+        void SetFastTiming(bool enabled) {
+            fastTiming = enabled;
+            RefreshContendedPages();
+        }
+
+        //ProcessBatch() for fast timing mode: the batch runs on fastCpu, whose bus has the
+        //contention and raster work compiled out.
+        void ProcessFast() {
+            if (!CanProcessBatch()) {
+                Process();
+                return;
+            }
+
+            //Tape Save trap is active only if lower ROM is 48k
+            fastCpu.breakPC = (!tapeTrapsDisabled && lowROMis48K) ? 0x04d1 : -1;
+
+            prevT = cpu.t_states;
+            int startSoundOut = soundOut;
+            fastCpu.CopyStateFrom(cpu);
+            int count = fastCpu.RunUntil(GetEventHorizon());
+            cpu.CopyStateFrom(fastCpu);
+
+            if (count == 0) {
+                //Nothing ran: either the cpu is on the trap address or the horizon has
+                //already been reached. Process() steps one instruction and runs the events.
+                Process();
+                return;
+            }
+
+            FinishBatch(count, startSoundOut);
+        }
+
+        //Fast timing versions of PeekByte/PokeByte for SpectrumFastBus
+        byte PeekByteFast(ushort addr) {
+            fastCpu.t_states += 3;
+
+            byte _b = PageReadPointer[addr >> 13][addr & 0x1FFF];
+
+            //This call flags a memory change event for the debugger
+            OnMemoryReadEvent(addr, _b);
+
+            return _b;
+        }
+
+        void PokeByteFast(ushort addr, byte b) {
+            //This call flags a memory change event for the debugger
+            OnMemoryWriteEvent(addr, b);
+
+            fastCpu.t_states += 3;
+            int page = (addr) >> 13;
+            int offset = (addr) & 0x1FFF;
+
+            NotePageWrite(page, offset, b);
+            PageWritePointer[page][offset] = b;
+        }
+
+        //Peripheral bookkeeping at the end of a batch of count instructions, which started
+        //with the beeper at startSoundOut
+        void FinishBatch(int count, int startSoundOut) {
+            deltaTStates = cpu.t_states - prevT;
+
+#if RM_SUBSYSTEM_TIMERS
+            subsystemTimes.instructions += count;
+#endif
+
+            //Update Sound. Process() adds soundOut twice per instruction (once in UpdateAudio)
+            //so the same weighting is kept here, shared out over the samples by tstates. Port
+            //writes end a batch, so only its last instruction can have changed soundOut. In
+            //turbo mode the audio event drops the samples instead.
+            {
+#if RM_SUBSYSTEM_TIMERS
+                SubsystemTimer timer(subsystemTimes.audioNs);
+#endif
+
+                int remaining = deltaTStates;
+                int weight = count * 2;
+
+                while (!turbo && timeToOutSound + remaining >= soundTStatesToSample) {
+                    int step = std::max(soundTStatesToSample - timeToOutSound, 0);
+                    int share = std::min(std::max(remaining > 0 ? weight * step / remaining : weight, 1), std::max(weight, 1));
+
+                    AddBatchAudio(step, startSoundOut * share, share);
+                    PlayAudio();
+                    remaining -= step;
+                    weight = std::max(weight - share, 0);
+                }
+
+                int last = std::min(weight, 2);
+                AddBatchAudio(remaining, startSoundOut * (weight - last) + soundOut * last, weight);
+            }
+
+            if (cpu.t_states >= scheduler.NextDeadline())
+                scheduler.RunDue(cpu.t_states);
+        }
+
+        //Feeds tstates of a batch to the audio, with sound, the sum of weight beeper levels
+        void AddBatchAudio(int tstates, int sound, int weight) {
+            timeToOutSound += tstates;
+
+            for (auto& ad : audio_devices) {
+                ad->Update(tstates);
+            }
+
+            averagedSound += sound;
+            soundCounter += (short)weight;
+        }
+
         //Processes an interrupt
-        public void Interrupt() {
+        void Interrupt() {
             if (cpu.interrupt_mode < 2) //IM0 = IM1 for our purpose
             {
                 //When interrupts are enabled we can be sure that the reset sequence is over.
@@ -2336,16 +3894,16 @@ namespace rm {
             //UpdateAudio(deltaT);
         }
 
-        public void StopTape(bool cancelCallback = false) {
+        void StopTape(bool cancelCallback = false) {
             tapeIsPlaying = false;
             //tape_readToPlay = false;
             //if (pulseLevel != 0)
             //    FlipTapeBit();
-            if (TapeEvent != null && !cancelCallback)
-                OnTapeEvent(new TapeEventArgs(TapeEventType.STOP_TAPE)); //stop the tape!
+            if (!cancelCallback)
+                OnTapeEvent(TapeEventType::STOP_TAPE); //stop the tape!
         }
 
-        private void FlipTapeBit() {
+        void FlipTapeBit() {
             pulseLevel = 1 - pulseLevel;
 
             tapeBitWasFlipped = true;
@@ -2354,9 +3912,12 @@ namespace rm {
             if (pulseLevel == 0) {
                 soundOut = 0;
             } else
-                soundOut = short.MinValue >> 1; //half
+                soundOut = SHRT_MIN >> 1; //half
         }
 
+        //The PZX block player below is still the C# original and needs a PZXFile port, which
+        //isn't in this tree. It's compiled out; the stand-ins after it behave like an empty tape.
+#if 0
         public void NextPZXBlock() {
             while (true) {
                 blockCounter++;
@@ -2592,6 +4153,7 @@ namespace rm {
 
             PZXFile.DATA_Block dataBlock = (PZXFile.DATA_Block)PZXFile.blocks[blockCounter + 1];
             edgeDuration = (1000);
+            cpu.MaterializeFlags();
             //if (pulseLevel != dataBlock.initialPulseLevel)
             //    FlipTapeBit();
             cpu.regs.H = 0;
@@ -2621,6 +4183,7 @@ namespace rm {
                     loadStageFlagByte = false;
                     cpu.regs.A = (byte)(cpu.regs.AF_ >> 8);
                     cpu.Xor_R(cpu.regs.L);
+                    cpu.MaterializeFlags();
                     if ((cpu.regs.F & 0x040) == 0)
                         break;
                 }
@@ -2752,5 +4315,134 @@ namespace rm {
                 FlashLoad();
             }
         }
+#endif
+
+        void NextPZXBlock() {
+            StopTape();
+        }
+
+        void FlashLoad() {
+            StopTape();
+        }
+
+        void DoTapeEvent(TapeEventType type) {
+            if (tapeBitFlipAck)
+                tapeBitWasFlipped = false;
+
+            if (type == TapeEventType::EDGE_LOAD) {
+                FlipTapeBit();
+            } else if (type == TapeEventType::STOP_TAPE) {
+                StopTape();
+                blockCounter--;
+            } else if (type == TapeEventType::START_TAPE) {
+                OnTapeEvent(TapeEventType::START_TAPE);
+                NextPZXBlock();
+            } else if (type == TapeEventType::FLASH_LOAD) {
+                FlashLoad();
+            }
+        }
     };
+
+    inline byte SpectrumBus::PeekByte(ushort addr) { return machine->PeekByte(addr); }
+    inline ushort SpectrumBus::PeekWord(ushort addr) { return machine->PeekWord(addr); }
+    inline void SpectrumBus::PokeByte(ushort addr, byte val) { machine->PokeByte(addr, val); }
+    inline void SpectrumBus::PokeWord(ushort addr, ushort val) { machine->PokeWord(addr, val); }
+    inline void SpectrumBus::Contend(int reg, int times, int count) { machine->Contend(reg, times, count); }
+    inline byte SpectrumBus::In(ushort port) { return machine->In(port); }
+    inline void SpectrumBus::Out(ushort port, byte val) {
+        int paging7ffd = machine->last7ffdOut;
+        int paging1ffd = machine->last1ffdOut;
+        int border = machine->borderColour;
+
+        machine->Out(port, val);
+
+        if (machine->last7ffdOut != paging7ffd || machine->last1ffdOut != paging1ffd) {
+            machine->RefreshContendedPages();
+            machine->MarkAllDirty();    //the shadow screen may have been switched in
+        }
+
+        if (machine->borderColour != border)
+            machine->NoteBorderChange();
+
+        //Port writes can change paging, the border or sound devices, so end the batch here.
+        machine->cpu.yieldRequested = true;
+    }
+    inline void SpectrumBus::InstructionFetchSignal() { machine->OnInstructionFetch(machine->cpu.regs.PC, machine->cpu.regs.SP, machine->cpu.t_states); }
+    inline void SpectrumBus::TapeEdgeDetection() { machine->OnTapeEdgeDetection(); }
+    inline void SpectrumBus::TapeEdgeDecA() { machine->OnTapeEdgeDecA(); }
+    inline void SpectrumBus::TapeEdgeCpA() { machine->OnTapeEdgeCpA(); }
+
+    inline byte SpectrumFastBus::PeekByte(ushort addr) { return machine->PeekByteFast(addr); }
+    inline void SpectrumFastBus::InstructionFetchSignal() { machine->OnInstructionFetch(machine->fastCpu.regs.PC, machine->fastCpu.regs.SP, machine->fastCpu.t_states); }
+    inline void SpectrumFastBus::PokeByte(ushort addr, byte val) { machine->PokeByteFast(addr, val); }
+    inline void SpectrumFastBus::Contend(int /*reg*/, int times, int count) { machine->fastCpu.t_states += times * count; }
+
+    inline ushort SpectrumFastBus::PeekWord(ushort addr) {
+        return (ushort)(machine->PeekByteFast(addr) | (machine->PeekByteFast((ushort)(addr + 1)) << 8));
+    }
+
+    inline void SpectrumFastBus::PokeWord(ushort addr, ushort val) {
+        machine->PokeByteFast(addr, (byte)(val & 0xff));
+        machine->PokeByteFast((ushort)(addr + 1), (byte)(val >> 8));
+    }
+
+    //An IO cycle is a fixed 4 tstates with a write landing after the first one, as on an
+    //uncontended port. The port devices read the clock from machine->cpu, so it's handed over.
+    inline byte SpectrumFastBus::In(ushort port) {
+        machine->OnPortEvent(port, 0, false);
+
+        machine->cpu.t_states = machine->fastCpu.t_states + 4;
+        byte result = machine->ReadPort(port);
+        machine->fastCpu.t_states = machine->cpu.t_states;
+        return result;
+    }
+
+    inline void SpectrumFastBus::Out(ushort port, byte val) {
+        int paging7ffd = machine->last7ffdOut;
+        int paging1ffd = machine->last1ffdOut;
+        int border = machine->borderColour;
+
+        machine->OnPortEvent(port, val, true);
+
+        machine->cpu.t_states = machine->fastCpu.t_states + 1;
+        machine->WritePort(port, val);
+
+        if (machine->last7ffdOut != paging7ffd || machine->last1ffdOut != paging1ffd) {
+            machine->RefreshContendedPages();
+            machine->MarkAllDirty();
+        }
+
+        if (machine->borderColour != border)
+            machine->NoteBorderChange();
+
+        machine->fastCpu.t_states = machine->cpu.t_states + 3;
+
+        machine->fastCpu.yieldRequested = true;
+    }
+
+    //The tape handlers work on machine->cpu, so the whole state is handed over. They only
+    //do anything with a tape inserted.
+    inline void SpectrumFastBus::TapeEdgeDetection() {
+        if (machine->tape_readToPlay) {
+            machine->cpu.CopyStateFrom(machine->fastCpu);
+            machine->OnTapeEdgeDetection();
+            machine->fastCpu.CopyStateFrom(machine->cpu);
+        }
+    }
+
+    inline void SpectrumFastBus::TapeEdgeDecA() {
+        if (machine->tape_readToPlay) {
+            machine->cpu.CopyStateFrom(machine->fastCpu);
+            machine->OnTapeEdgeDecA();
+            machine->fastCpu.CopyStateFrom(machine->cpu);
+        }
+    }
+
+    inline void SpectrumFastBus::TapeEdgeCpA() {
+        if (machine->tape_readToPlay) {
+            machine->cpu.CopyStateFrom(machine->fastCpu);
+            machine->OnTapeEdgeCpA();
+            machine->fastCpu.CopyStateFrom(machine->cpu);
+        }
+    }
 }